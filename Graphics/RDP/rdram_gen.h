@@ -0,0 +1,76 @@
+#ifndef _RDRAM_GEN_H
+#define _RDRAM_GEN_H
+
+#include <stdint.h>
+#include <retro_inline.h>
+
+#include "m64p_plugin.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Helpers over the core's RDRAM write generations (see GFX_INFO).
+ *
+ * Whatever is derived from RDRAM gets stamped with rdram_gen_current() and
+ * stays valid while rdram_gen_unchanged() holds for its source range.
+ * A stamp of 0 means the core does not track writes. */
+
+static INLINE uint32_t rdram_gen_current(void)
+{
+   if (gfx_info.RDRAM_GEN_EPOCH == NULL)
+      return 0;
+   return *gfx_info.RDRAM_GEN_EPOCH;
+}
+
+static INLINE int rdram_gen_unchanged(uint32_t address, uint32_t length, uint32_t stamp)
+{
+   uint32_t first, last;
+
+   if (stamp == 0 || *gfx_info.RDRAM_GEN_FLOOR >= stamp)
+      return 0;
+   if (length == 0)
+      return 1;
+
+   first = (address & 0xffffff) >> gfx_info.RDRAM_GEN_SHIFT;
+   last  = ((address & 0xffffff) + length - 1) >> gfx_info.RDRAM_GEN_SHIFT;
+   if (last >= gfx_info.RDRAM_GEN_PAGES)
+      return 0;
+
+   for (; first <= last; ++first)
+   {
+      if (gfx_info.RDRAM_PAGE_GEN[first] >= stamp)
+         return 0;
+   }
+
+   return 1;
+}
+
+/* The plugin wrote to RDRAM itself. */
+static INLINE void rdram_gen_mark(uint32_t address, uint32_t length)
+{
+   uint32_t first, last;
+
+   if (gfx_info.RDRAM_GEN_EPOCH == NULL || length == 0)
+      return;
+
+   first = (address & 0xffffff) >> gfx_info.RDRAM_GEN_SHIFT;
+   last  = ((address & 0xffffff) + length - 1) >> gfx_info.RDRAM_GEN_SHIFT;
+   if (last >= gfx_info.RDRAM_GEN_PAGES)
+      last = gfx_info.RDRAM_GEN_PAGES - 1;
+
+   for (; first <= last; ++first)
+      gfx_info.RDRAM_PAGE_GEN[first] = *gfx_info.RDRAM_GEN_EPOCH;
+}
+
+static INLINE void rdram_gen_mark_all(void)
+{
+   if (gfx_info.RDRAM_GEN_EPOCH != NULL)
+      *gfx_info.RDRAM_GEN_FLOOR = *gfx_info.RDRAM_GEN_EPOCH;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
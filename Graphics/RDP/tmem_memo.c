@@ -0,0 +1,153 @@
+#include <string.h>
+
+#include "tmem_memo.h"
+#include "rdram_gen.h"
+
+#define TMEM_MEMO_LOADS   16
+#define TMEM_MEMO_ENTRIES 1024
+
+struct tmem_load
+{
+   uint32_t tmem;
+   uint32_t size;
+   uint32_t address;
+   uint32_t length;
+   uint32_t arg0;
+   uint32_t arg1;
+   uint32_t stamp;
+};
+
+struct tmem_hash
+{
+   struct tmem_load load;
+   uint32_t tmem;
+   uint32_t size;
+   uint32_t params[TMEM_MEMO_PARAMS];
+   unsigned count;
+   uint64_t hash;
+};
+
+/* loads currently in TMEM, never overlapping */
+static struct tmem_load loads[TMEM_MEMO_LOADS];
+static unsigned num_loads;
+
+static struct tmem_hash hashes[TMEM_MEMO_ENTRIES];
+
+void tmem_memo_forget(uint32_t tmem, uint32_t size)
+{
+   unsigned i = 0;
+
+   while (i < num_loads)
+   {
+      if (loads[i].tmem < tmem + size && tmem < loads[i].tmem + loads[i].size)
+         loads[i] = loads[--num_loads];
+      else
+         ++i;
+   }
+}
+
+void tmem_memo_load(uint32_t tmem, uint32_t size, uint32_t address, uint32_t length,
+      uint32_t arg0, uint32_t arg1)
+{
+   struct tmem_load *load;
+
+   /* a load wrapping around the end of TMEM is not tracked */
+   if (tmem + size > 4096)
+   {
+      num_loads = 0;
+      return;
+   }
+
+   tmem_memo_forget(tmem, size);
+
+   if (size == 0 || rdram_gen_current() == 0)
+      return;
+
+   if (num_loads == TMEM_MEMO_LOADS)
+      loads[0] = loads[--num_loads];
+
+   load          = &loads[num_loads++];
+   load->tmem    = tmem;
+   load->size    = size;
+   load->address = address;
+   load->length  = length;
+   load->arg0    = arg0;
+   load->arg1    = arg1;
+   load->stamp   = rdram_gen_current();
+}
+
+static const struct tmem_load *find_load(uint32_t tmem, uint32_t size)
+{
+   unsigned i;
+
+   for (i = 0; i < num_loads; ++i)
+   {
+      if (loads[i].tmem <= tmem && tmem + size <= loads[i].tmem + loads[i].size)
+         return &loads[i];
+   }
+
+   return NULL;
+}
+
+static struct tmem_hash *hash_slot(const struct tmem_load *load, uint32_t tmem,
+      uint32_t size, const uint32_t *params, unsigned count)
+{
+   uint32_t h = load->address * 0x9e3779b1u;
+   unsigned i;
+
+   h = (h ^ load->length ^ (load->tmem << 20)) * 0x85ebca6bu;
+   h = (h ^ load->arg0 ^ (tmem << 16) ^ size) * 0xc2b2ae35u;
+   for (i = 0; i < count; ++i)
+      h = (h ^ params[i]) * 0x9e3779b1u;
+
+   return &hashes[(h ^ (h >> 16)) & (TMEM_MEMO_ENTRIES - 1)];
+}
+
+int tmem_memo_lookup(uint32_t tmem, uint32_t size,
+      const uint32_t *params, unsigned count, uint64_t *hash)
+{
+   const struct tmem_load *load = find_load(tmem, size);
+   const struct tmem_hash *entry;
+
+   if (load == NULL || count > TMEM_MEMO_PARAMS)
+      return 0;
+
+   entry = hash_slot(load, tmem, size, params, count);
+   if (entry->load.stamp == 0
+         || entry->load.tmem    != load->tmem
+         || entry->load.size    != load->size
+         || entry->load.address != load->address
+         || entry->load.length  != load->length
+         || entry->load.arg0    != load->arg0
+         || entry->load.arg1    != load->arg1
+         || entry->tmem  != tmem
+         || entry->size  != size
+         || entry->count != count
+         || memcmp(entry->params, params, count * sizeof(*params)) != 0)
+      return 0;
+
+   /* the hashed load happened at or before the current one */
+   if (!rdram_gen_unchanged(load->address, load->length, entry->load.stamp))
+      return 0;
+
+   *hash = entry->hash;
+   return 1;
+}
+
+void tmem_memo_store(uint32_t tmem, uint32_t size,
+      const uint32_t *params, unsigned count, uint64_t hash)
+{
+   const struct tmem_load *load = find_load(tmem, size);
+   struct tmem_hash *entry;
+
+   if (load == NULL || count > TMEM_MEMO_PARAMS)
+      return;
+
+   entry        = hash_slot(load, tmem, size, params, count);
+   entry->load  = *load;
+   entry->tmem  = tmem;
+   entry->size  = size;
+   entry->count = count;
+   entry->hash  = hash;
+   memcpy(entry->params, params, count * sizeof(*params));
+}
@@ -0,0 +1,37 @@
+#ifndef _TMEM_MEMO_H
+#define _TMEM_MEMO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Texture hashes memoized by TMEM provenance.
+ *
+ * Each TMEM load records which RDRAM range it copied, how, and in which
+ * RDRAM generation. A hash taken over TMEM is stored against the load
+ * which filled it, and handed back for a later identical load as long as
+ * its RDRAM source was not written in between.
+ *
+ * TMEM addresses and sizes are in bytes. Every TMEM writer must either
+ * record its load or forget the range it overwrote. */
+
+#define TMEM_MEMO_PARAMS 8
+
+void tmem_memo_load(uint32_t tmem, uint32_t size, uint32_t address, uint32_t length,
+      uint32_t arg0, uint32_t arg1);
+void tmem_memo_forget(uint32_t tmem, uint32_t size);
+
+/* params (up to TMEM_MEMO_PARAMS words) describes how the hash was taken. */
+int tmem_memo_lookup(uint32_t tmem, uint32_t size,
+      const uint32_t *params, unsigned count, uint64_t *hash);
+void tmem_memo_store(uint32_t tmem, uint32_t size,
+      const uint32_t *params, unsigned count, uint64_t hash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
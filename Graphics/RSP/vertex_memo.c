@@ -0,0 +1,112 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "vertex_memo.h"
+#include "../RDP/rdram_gen.h"
+
+#define VERTEX_MEMO_ENTRIES 256
+
+struct vertex_memo
+{
+   uint32_t address;
+   uint32_t length;
+   uint32_t stamp;
+   uint32_t hash;
+   unsigned count;
+   size_t   size;
+   size_t   capacity;
+   uint8_t *buf;           /* key words, then the vertices */
+};
+
+static struct vertex_memo memos[VERTEX_MEMO_ENTRIES];
+static bool enabled;
+
+void vertex_memo_enable(bool enable)
+{
+   unsigned i;
+
+   if (enable == enabled)
+      return;
+
+   enabled = enable;
+   if (enable)
+      return;
+
+   for (i = 0; i < VERTEX_MEMO_ENTRIES; ++i)
+      free(memos[i].buf);
+   memset(memos, 0, sizeof(memos));
+}
+
+bool vertex_memo_active(void)
+{
+   return enabled && rdram_gen_current() != 0;
+}
+
+static uint32_t key_hash(uint32_t address, uint32_t length,
+      const uint32_t *key, unsigned count)
+{
+   uint32_t h = address * 0x9e3779b1u;
+   unsigned i;
+
+   h = (h ^ length) * 0x85ebca6bu;
+   for (i = 0; i < count; ++i)
+      h = (h ^ key[i]) * 0x9e3779b1u;
+
+   return h ^ (h >> 16);
+}
+
+const void *vertex_memo_lookup(uint32_t address, uint32_t length,
+      const uint32_t *key, unsigned count, size_t size)
+{
+   uint32_t h = key_hash(address, length, key, count);
+   const struct vertex_memo *memo = &memos[h & (VERTEX_MEMO_ENTRIES - 1)];
+
+   if (memo->stamp == 0
+         || memo->hash    != h
+         || memo->address != address
+         || memo->length  != length
+         || memo->count   != count
+         || memo->size    != size
+         || memcmp(memo->buf, key, count * sizeof(*key)) != 0)
+      return NULL;
+
+   if (!rdram_gen_unchanged(address, length, memo->stamp))
+      return NULL;
+
+   return memo->buf + count * sizeof(*key);
+}
+
+void vertex_memo_store(uint32_t address, uint32_t length,
+      const uint32_t *key, unsigned count, const void *data, size_t size)
+{
+   struct vertex_memo *memo;
+   uint32_t h;
+   size_t need = count * sizeof(*key) + size;
+
+   if (!vertex_memo_active())
+      return;
+
+   h    = key_hash(address, length, key, count);
+   memo = &memos[h & (VERTEX_MEMO_ENTRIES - 1)];
+
+   if (memo->capacity < need)
+   {
+      uint8_t *buf = (uint8_t*)realloc(memo->buf, need);
+      if (buf == NULL)
+      {
+         memo->stamp = 0;
+         return;
+      }
+      memo->buf      = buf;
+      memo->capacity = need;
+   }
+
+   memo->address = address;
+   memo->length  = length;
+   memo->stamp   = rdram_gen_current();
+   memo->hash    = h;
+   memo->count   = count;
+   memo->size    = size;
+   memcpy(memo->buf, key, count * sizeof(*key));
+   memcpy(memo->buf + count * sizeof(*key), data, size);
+}
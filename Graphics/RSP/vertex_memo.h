@@ -0,0 +1,38 @@
+#ifndef _VERTEX_MEMO_H
+#define _VERTEX_MEMO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <boolean.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Vertex loads memoized by RDRAM generation.
+ *
+ * A gSPVertex turns a range of RDRAM into transformed, lit and clipped
+ * vertices. Static geometry such as HUDs, skyboxes and level meshes loads
+ * the same range under the same matrices every frame. The plugin describes
+ * everything its output depends on besides the RDRAM range as a key of
+ * 32-bit words, stores the vertices it produced, and gets them back for a
+ * later load of the same range and key as long as the range was not
+ * written in between.
+ *
+ * Off until enabled, and only active while the core tracks RDRAM writes. */
+
+void vertex_memo_enable(bool enable);
+bool vertex_memo_active(void);
+
+/* Returns the size bytes stored for this load, or NULL. */
+const void *vertex_memo_lookup(uint32_t address, uint32_t length,
+      const uint32_t *key, unsigned count, size_t size);
+void vertex_memo_store(uint32_t address, uint32_t length,
+      const uint32_t *key, unsigned count, const void *data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
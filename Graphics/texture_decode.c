@@ -0,0 +1,532 @@
+#include "texture_decode.h"
+
+#if defined(ARCH_MIN_SSE2)
+#include <emmintrin.h>
+#define TEXTURE_DECODE_SSE2
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+#include <arm_neon.h>
+#define TEXTURE_DECODE_NEON
+#endif
+
+/* Texels decoded per pass through the stack buffers. */
+#define CHUNK_TEXELS 256
+
+/* The vector paths move 16 row bytes at a time. A block starting on a
+ * 16 byte boundary of the row holds the same bytes in the source whatever
+ * the swizzle, only their order differs. */
+
+#if defined(TEXTURE_DECODE_SSE2)
+static __m128i swizzle_sse2(__m128i x, unsigned swizzle)
+{
+   if (swizzle & 1)
+      x = _mm_or_si128(_mm_srli_epi16(x, 8), _mm_slli_epi16(x, 8));
+   if (swizzle & 2)
+      x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1)),
+            _MM_SHUFFLE(2, 3, 0, 1));
+   if (swizzle & 4)
+      x = _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+   return x;
+}
+
+#define LOAD_BLOCK(p, swizzle) \
+   swizzle_sse2(_mm_loadu_si128((const __m128i*)(p)), swizzle)
+#elif defined(TEXTURE_DECODE_NEON)
+static uint8x16_t swizzle_neon(uint8x16_t x, unsigned swizzle)
+{
+   if (swizzle & 1)
+      x = vrev16q_u8(x);
+   if (swizzle & 2)
+      x = vreinterpretq_u8_u16(vrev32q_u16(vreinterpretq_u16_u8(x)));
+   if (swizzle & 4)
+      x = vreinterpretq_u8_u32(vrev64q_u32(vreinterpretq_u32_u8(x)));
+   return x;
+}
+
+#define LOAD_BLOCK(p, swizzle) swizzle_neon(vld1q_u8(p), swizzle)
+#endif
+
+void texture_fetch_4b(uint8_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle)
+{
+   unsigned i   = first;
+   unsigned end = first + count;
+
+#if defined(TEXTURE_DECODE_SSE2) || defined(TEXTURE_DECODE_NEON)
+   for (; i < end && (i & 31); i++)
+   {
+      uint8_t b = src[(i >> 1) ^ swizzle];
+      *dst++    = (i & 1) ? (b & 0x0F) : (b >> 4);
+   }
+
+   for (; i + 32 <= end; i += 32, dst += 32)
+   {
+#if defined(TEXTURE_DECODE_SSE2)
+      const __m128i low = _mm_set1_epi8(0x0F);
+      __m128i x  = LOAD_BLOCK(src + (i >> 1), swizzle);
+      __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), low);
+      __m128i lo = _mm_and_si128(x, low);
+      _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi8(hi, lo));
+      _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi8(hi, lo));
+#else
+      uint8x16_t x = LOAD_BLOCK(src + (i >> 1), swizzle);
+      uint8x16x2_t nibbles;
+      nibbles.val[0] = vshrq_n_u8(x, 4);
+      nibbles.val[1] = vandq_u8(x, vdupq_n_u8(0x0F));
+      vst2q_u8(dst, nibbles);
+#endif
+   }
+#endif
+
+   for (; i < end; i++)
+   {
+      uint8_t b = src[(i >> 1) ^ swizzle];
+      *dst++    = (i & 1) ? (b & 0x0F) : (b >> 4);
+   }
+}
+
+void texture_fetch_8b(uint8_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle)
+{
+   unsigned i   = first;
+   unsigned end = first + count;
+
+#if defined(TEXTURE_DECODE_SSE2) || defined(TEXTURE_DECODE_NEON)
+   for (; i < end && (i & 15); i++)
+      *dst++ = src[i ^ swizzle];
+
+   for (; i + 16 <= end; i += 16, dst += 16)
+   {
+#if defined(TEXTURE_DECODE_SSE2)
+      _mm_storeu_si128((__m128i*)dst, LOAD_BLOCK(src + i, swizzle));
+#else
+      vst1q_u8(dst, LOAD_BLOCK(src + i, swizzle));
+#endif
+   }
+#endif
+
+   for (; i < end; i++)
+      *dst++ = src[i ^ swizzle];
+}
+
+/* Swapping the bytes of each pair once more leaves the big endian values
+ * in host order, on the little endian hosts the vector paths run on. */
+
+void texture_fetch_16b(uint16_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle)
+{
+   unsigned i   = first;
+   unsigned end = first + count;
+
+#if defined(TEXTURE_DECODE_SSE2) || defined(TEXTURE_DECODE_NEON)
+   for (; i < end && (i & 7); i++)
+      *dst++ = (src[(i << 1) ^ swizzle] << 8) | src[((i << 1) + 1) ^ swizzle];
+
+   for (; i + 8 <= end; i += 8, dst += 8)
+   {
+#if defined(TEXTURE_DECODE_SSE2)
+      _mm_storeu_si128((__m128i*)dst, LOAD_BLOCK(src + (i << 1), swizzle ^ 1));
+#else
+      vst1q_u8((uint8_t*)dst, LOAD_BLOCK(src + (i << 1), swizzle ^ 1));
+#endif
+   }
+#endif
+
+   for (; i < end; i++)
+      *dst++ = (src[(i << 1) ^ swizzle] << 8) | src[((i << 1) + 1) ^ swizzle];
+}
+
+void texture_fetch_32b(uint32_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle)
+{
+   unsigned i   = first;
+   unsigned end = first + count;
+
+#if defined(TEXTURE_DECODE_SSE2) || defined(TEXTURE_DECODE_NEON)
+   for (; i < end && (i & 3); i++)
+      *dst++ = ((uint32_t)src[(i << 2) ^ swizzle] << 24)
+         | (src[((i << 2) + 1) ^ swizzle] << 16)
+         | (src[((i << 2) + 2) ^ swizzle] << 8)
+         | src[((i << 2) + 3) ^ swizzle];
+
+   for (; i + 4 <= end; i += 4, dst += 4)
+   {
+#if defined(TEXTURE_DECODE_SSE2)
+      _mm_storeu_si128((__m128i*)dst, LOAD_BLOCK(src + (i << 2), swizzle ^ 3));
+#else
+      vst1q_u8((uint8_t*)dst, LOAD_BLOCK(src + (i << 2), swizzle ^ 3));
+#endif
+   }
+#endif
+
+   for (; i < end; i++)
+      *dst++ = ((uint32_t)src[(i << 2) ^ swizzle] << 24)
+         | (src[((i << 2) + 1) ^ swizzle] << 16)
+         | (src[((i << 2) + 2) ^ swizzle] << 8)
+         | src[((i << 2) + 3) ^ swizzle];
+}
+
+void texture_decode_lut32(uint32_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle,
+      unsigned bits, const uint32_t *lut)
+{
+   uint8_t texels[CHUNK_TEXELS];
+
+   while (count != 0)
+   {
+      unsigned n = count < CHUNK_TEXELS ? count : CHUNK_TEXELS;
+      unsigned i;
+
+      if (bits == 4)
+         texture_fetch_4b(texels, src, first, n, swizzle);
+      else
+         texture_fetch_8b(texels, src, first, n, swizzle);
+
+      for (i = 0; i < n; i++)
+         dst[i] = lut[texels[i]];
+
+      dst   += n;
+      first += n;
+      count -= n;
+   }
+}
+
+void texture_decode_lut16(uint16_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle,
+      unsigned bits, const uint16_t *lut)
+{
+   uint8_t texels[CHUNK_TEXELS];
+
+   while (count != 0)
+   {
+      unsigned n = count < CHUNK_TEXELS ? count : CHUNK_TEXELS;
+      unsigned i;
+
+      if (bits == 4)
+         texture_fetch_4b(texels, src, first, n, swizzle);
+      else
+         texture_fetch_8b(texels, src, first, n, swizzle);
+
+      for (i = 0; i < n; i++)
+         dst[i] = lut[texels[i]];
+
+      dst   += n;
+      first += n;
+      count -= n;
+   }
+}
+
+void texture_decode_lut8(uint8_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle,
+      unsigned bits, const uint8_t *lut)
+{
+   unsigned i;
+
+   if (bits == 4)
+      texture_fetch_4b(dst, src, first, count, swizzle);
+   else
+      texture_fetch_8b(dst, src, first, count, swizzle);
+
+   for (i = 0; i < count; i++)
+      dst[i] = lut[dst[i]];
+}
+
+/* round(c * 255 / 31) for c in 0..31 */
+#define EXPAND5_ROUND(c)     (((c) * 527 + 23) >> 6)
+#define EXPAND5_REPLICATE(c) (((c) << 3) | ((c) >> 2))
+
+static void convert_rgba16_32(uint32_t *dst, const uint16_t *src,
+      unsigned count, unsigned flags)
+{
+   unsigned i = 0;
+
+#if defined(TEXTURE_DECODE_SSE2)
+   const __m128i mask5 = _mm_set1_epi16(0x1F);
+   const __m128i one   = _mm_set1_epi16(1);
+   const __m128i m527  = _mm_set1_epi16(527);
+   const __m128i r23   = _mm_set1_epi16(23);
+   const __m128i m255  = _mm_set1_epi16(0xFF);
+
+   for (; i + 8 <= count; i += 8)
+   {
+      __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+      __m128i c[3], a, lo, hi;
+      unsigned k;
+
+      c[0] = _mm_srli_epi16(v, 11);
+      c[1] = _mm_and_si128(_mm_srli_epi16(v, 6), mask5);
+      c[2] = _mm_and_si128(_mm_srli_epi16(v, 1), mask5);
+      a    = _mm_mullo_epi16(_mm_and_si128(v, one), m255);
+
+      for (k = 0; k < 3; k++)
+      {
+         if (flags & TEXTURE_DECODE_ROUND)
+            c[k] = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(c[k], m527), r23), 6);
+         else
+            c[k] = _mm_or_si128(_mm_slli_epi16(c[k], 3), _mm_srli_epi16(c[k], 2));
+      }
+
+      if (flags & TEXTURE_DECODE_BGRA)
+      {
+         lo = _mm_or_si128(c[2], _mm_slli_epi16(c[1], 8));
+         hi = _mm_or_si128(c[0], _mm_slli_epi16(a, 8));
+      }
+      else
+      {
+         lo = _mm_or_si128(c[0], _mm_slli_epi16(c[1], 8));
+         hi = _mm_or_si128(c[2], _mm_slli_epi16(a, 8));
+      }
+
+      _mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi16(lo, hi));
+      _mm_storeu_si128((__m128i*)(dst + i + 4), _mm_unpackhi_epi16(lo, hi));
+   }
+#elif defined(TEXTURE_DECODE_NEON)
+   const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+   const uint16x8_t one   = vdupq_n_u16(1);
+   const uint16x8_t r23   = vdupq_n_u16(23);
+
+   for (; i + 8 <= count; i += 8)
+   {
+      uint16x8_t v = vld1q_u16(src + i);
+      uint16x8_t c[3], a;
+      uint16x8x2_t out;
+      unsigned k;
+
+      c[0] = vshrq_n_u16(v, 11);
+      c[1] = vandq_u16(vshrq_n_u16(v, 6), mask5);
+      c[2] = vandq_u16(vshrq_n_u16(v, 1), mask5);
+      a    = vmulq_n_u16(vandq_u16(v, one), 0xFF);
+
+      for (k = 0; k < 3; k++)
+      {
+         if (flags & TEXTURE_DECODE_ROUND)
+            c[k] = vshrq_n_u16(vaddq_u16(vmulq_n_u16(c[k], 527), r23), 6);
+         else
+            c[k] = vorrq_u16(vshlq_n_u16(c[k], 3), vshrq_n_u16(c[k], 2));
+      }
+
+      if (flags & TEXTURE_DECODE_BGRA)
+      {
+         out.val[0] = vorrq_u16(c[2], vshlq_n_u16(c[1], 8));
+         out.val[1] = vorrq_u16(c[0], vshlq_n_u16(a, 8));
+      }
+      else
+      {
+         out.val[0] = vorrq_u16(c[0], vshlq_n_u16(c[1], 8));
+         out.val[1] = vorrq_u16(c[2], vshlq_n_u16(a, 8));
+      }
+
+      vst2q_u16((uint16_t*)(dst + i), out);
+   }
+#endif
+
+   for (; i < count; i++)
+   {
+      uint32_t v = src[i];
+      uint32_t r = v >> 11;
+      uint32_t g = (v >> 6) & 0x1F;
+      uint32_t b = (v >> 1) & 0x1F;
+      uint32_t a = (v & 1) ? 0xFF : 0x00;
+
+      if (flags & TEXTURE_DECODE_ROUND)
+      {
+         r = EXPAND5_ROUND(r);
+         g = EXPAND5_ROUND(g);
+         b = EXPAND5_ROUND(b);
+      }
+      else
+      {
+         r = EXPAND5_REPLICATE(r);
+         g = EXPAND5_REPLICATE(g);
+         b = EXPAND5_REPLICATE(b);
+      }
+
+      if (flags & TEXTURE_DECODE_BGRA)
+         dst[i] = (a << 24) | (r << 16) | (g << 8) | b;
+      else
+         dst[i] = (a << 24) | (b << 16) | (g << 8) | r;
+   }
+}
+
+static void convert_rgba16_1555(uint16_t *dst, const uint16_t *src, unsigned count)
+{
+   unsigned i = 0;
+
+#if defined(TEXTURE_DECODE_SSE2)
+   for (; i + 8 <= count; i += 8)
+   {
+      __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+      _mm_storeu_si128((__m128i*)(dst + i),
+            _mm_or_si128(_mm_srli_epi16(v, 1), _mm_slli_epi16(v, 15)));
+   }
+#elif defined(TEXTURE_DECODE_NEON)
+   for (; i + 8 <= count; i += 8)
+   {
+      uint16x8_t v = vld1q_u16(src + i);
+      vst1q_u16(dst + i, vorrq_u16(vshrq_n_u16(v, 1), vshlq_n_u16(v, 15)));
+   }
+#endif
+
+   for (; i < count; i++)
+      dst[i] = (uint16_t)((src[i] >> 1) | (src[i] << 15));
+}
+
+static void convert_ia16_32(uint32_t *dst, const uint16_t *src, unsigned count)
+{
+   unsigned i = 0;
+
+#if defined(TEXTURE_DECODE_SSE2)
+   const __m128i m255 = _mm_set1_epi16(0xFF);
+
+   for (; i + 8 <= count; i += 8)
+   {
+      __m128i v  = _mm_loadu_si128((const __m128i*)(src + i));
+      __m128i in = _mm_srli_epi16(v, 8);
+      __m128i lo = _mm_or_si128(in, _mm_slli_epi16(in, 8));
+      __m128i hi = _mm_or_si128(in, _mm_slli_epi16(_mm_and_si128(v, m255), 8));
+      _mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi16(lo, hi));
+      _mm_storeu_si128((__m128i*)(dst + i + 4), _mm_unpackhi_epi16(lo, hi));
+   }
+#elif defined(TEXTURE_DECODE_NEON)
+   for (; i + 8 <= count; i += 8)
+   {
+      uint16x8_t v  = vld1q_u16(src + i);
+      uint16x8_t in = vshrq_n_u16(v, 8);
+      uint16x8x2_t out;
+      out.val[0] = vorrq_u16(in, vshlq_n_u16(in, 8));
+      out.val[1] = vorrq_u16(in, vshlq_n_u16(v, 8));
+      vst2q_u16((uint16_t*)(dst + i), out);
+   }
+#endif
+
+   for (; i < count; i++)
+   {
+      uint32_t in = src[i] >> 8;
+      uint32_t a  = src[i] & 0xFF;
+      dst[i] = (a << 24) | (in << 16) | (in << 8) | in;
+   }
+}
+
+static void convert_ia16_4444(uint16_t *dst, const uint16_t *src,
+      unsigned count, unsigned flags)
+{
+   unsigned i = 0;
+
+#if defined(TEXTURE_DECODE_SSE2)
+   const __m128i m15  = _mm_set1_epi16(0x0F);
+   const __m128i m111 = _mm_set1_epi16(0x111);
+
+   for (; i + 8 <= count; i += 8)
+   {
+      __m128i v   = _mm_loadu_si128((const __m128i*)(src + i));
+      __m128i in  = _mm_mullo_epi16(_mm_srli_epi16(v, 12), m111);
+      __m128i a   = _mm_and_si128(_mm_srli_epi16(v, 4), m15);
+      __m128i out = (flags & TEXTURE_DECODE_ARGB)
+         ? _mm_or_si128(in, _mm_slli_epi16(a, 12))
+         : _mm_or_si128(_mm_slli_epi16(in, 4), a);
+      _mm_storeu_si128((__m128i*)(dst + i), out);
+   }
+#elif defined(TEXTURE_DECODE_NEON)
+   const uint16x8_t m15 = vdupq_n_u16(0x0F);
+
+   for (; i + 8 <= count; i += 8)
+   {
+      uint16x8_t v  = vld1q_u16(src + i);
+      uint16x8_t in = vmulq_n_u16(vshrq_n_u16(v, 12), 0x111);
+      uint16x8_t a  = vandq_u16(vshrq_n_u16(v, 4), m15);
+      vst1q_u16(dst + i, (flags & TEXTURE_DECODE_ARGB)
+            ? vorrq_u16(in, vshlq_n_u16(a, 12))
+            : vorrq_u16(vshlq_n_u16(in, 4), a));
+   }
+#endif
+
+   for (; i < count; i++)
+   {
+      uint16_t in = (src[i] >> 12) * 0x111;
+      uint16_t a  = (src[i] >> 4) & 0x0F;
+      dst[i] = (flags & TEXTURE_DECODE_ARGB)
+         ? (uint16_t)(in | (a << 12)) : (uint16_t)((in << 4) | a);
+   }
+}
+
+void texture_decode_rgba16_32(uint32_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle, unsigned flags)
+{
+   uint16_t texels[CHUNK_TEXELS];
+
+   while (count != 0)
+   {
+      unsigned n = count < CHUNK_TEXELS ? count : CHUNK_TEXELS;
+
+      texture_fetch_16b(texels, src, first, n, swizzle);
+      convert_rgba16_32(dst, texels, n, flags);
+
+      dst   += n;
+      first += n;
+      count -= n;
+   }
+}
+
+void texture_decode_rgba16_1555(uint16_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle)
+{
+   uint16_t texels[CHUNK_TEXELS];
+
+   while (count != 0)
+   {
+      unsigned n = count < CHUNK_TEXELS ? count : CHUNK_TEXELS;
+
+      texture_fetch_16b(texels, src, first, n, swizzle);
+      convert_rgba16_1555(dst, texels, n);
+
+      dst   += n;
+      first += n;
+      count -= n;
+   }
+}
+
+void texture_decode_ia16_32(uint32_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle)
+{
+   uint16_t texels[CHUNK_TEXELS];
+
+   while (count != 0)
+   {
+      unsigned n = count < CHUNK_TEXELS ? count : CHUNK_TEXELS;
+
+      texture_fetch_16b(texels, src, first, n, swizzle);
+      convert_ia16_32(dst, texels, n);
+
+      dst   += n;
+      first += n;
+      count -= n;
+   }
+}
+
+void texture_decode_ia16_4444(uint16_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle, unsigned flags)
+{
+   uint16_t texels[CHUNK_TEXELS];
+
+   while (count != 0)
+   {
+      unsigned n = count < CHUNK_TEXELS ? count : CHUNK_TEXELS;
+
+      texture_fetch_16b(texels, src, first, n, swizzle);
+      convert_ia16_4444(dst, texels, n, flags);
+
+      dst   += n;
+      first += n;
+      count -= n;
+   }
+}
+
+const char *texture_decode_impl(void)
+{
+#if defined(TEXTURE_DECODE_SSE2)
+   return "sse2";
+#elif defined(TEXTURE_DECODE_NEON)
+   return "neon";
+#else
+   return "scalar";
+#endif
+}
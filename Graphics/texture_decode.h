@@ -0,0 +1,76 @@
+#ifndef _TEXTURE_DECODE_H
+#define _TEXTURE_DECODE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Row decoders for N64 texel formats, shared by the HLE plugins.
+ *
+ * A row is read as N64 bytes: byte i of the row lives at src[i ^ swizzle].
+ * TMEM copies kept in N64 byte order use TEXTURE_SWIZZLE_TMEM, RDRAM and
+ * other native 32-bit word copies use TEXTURE_SWIZZLE_RDRAM, and odd lines
+ * of a tile add TEXTURE_SWIZZLE_ODD for the word swap the RDP applies to
+ * them. first is the texel index inside the row to start at.
+ *
+ * Texels of 8 bits or less (I, IA, CI and RGBA read as I) are decoded
+ * through a 256 entry table indexed by the texel value, 4-bit texels using
+ * the low 16 entries. Plugins fill the table from their own per-texel
+ * conversion or palette, so the result matches it bit for bit. 16-bit
+ * RGBA and IA texels are converted directly. Loads, unpacking and the 16-bit
+ * conversions use SSE2 or NEON where available. */
+
+#define TEXTURE_SWIZZLE_TMEM  0
+#define TEXTURE_SWIZZLE_RDRAM 3
+#define TEXTURE_SWIZZLE_ODD   4
+
+/* 32-bit output has red in bits 16-23 instead of bits 0-7. */
+#define TEXTURE_DECODE_BGRA   0x1
+/* 16-bit 4444 output has alpha in the top nibble instead of the bottom. */
+#define TEXTURE_DECODE_ARGB   0x2
+/* 5-bit channels expand to round(c * 255 / 31) instead of (c << 3 | c >> 2). */
+#define TEXTURE_DECODE_ROUND  0x4
+
+/* Raw texel values, 16 and 32-bit texels as big endian N64 values. */
+void texture_fetch_4b(uint8_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle);
+void texture_fetch_8b(uint8_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle);
+void texture_fetch_16b(uint16_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle);
+void texture_fetch_32b(uint32_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle);
+
+/* 4 or 8-bit texels through a table. */
+void texture_decode_lut32(uint32_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle,
+      unsigned bits, const uint32_t *lut);
+void texture_decode_lut16(uint16_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle,
+      unsigned bits, const uint16_t *lut);
+void texture_decode_lut8(uint8_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle,
+      unsigned bits, const uint8_t *lut);
+
+/* 16-bit RGBA (5551) texels. */
+void texture_decode_rgba16_32(uint32_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle, unsigned flags);
+void texture_decode_rgba16_1555(uint16_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle);
+
+/* 16-bit IA (88) texels, intensity in every color channel. */
+void texture_decode_ia16_32(uint32_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle);
+void texture_decode_ia16_4444(uint16_t *dst, const uint8_t *src,
+      unsigned first, unsigned count, unsigned swizzle, unsigned flags);
+
+/* Name of the implementation in use, for logging. */
+const char *texture_decode_impl(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,281 @@
+#include <string.h>
+
+#include "texture_hash.h"
+
+#if defined(ARCH_MIN_SSE2)
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TEXTURE_HASH_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#define STRIPE_BYTES    32
+#define SCRAMBLE_STRIPES 16
+
+#define PRIME32_1 UINT64_C(0x9E3779B1)
+#define PRIME64_1 UINT64_C(0x9E3779B185EBCA87)
+#define PRIME64_2 UINT64_C(0xC2B2AE3D27D4EB4F)
+
+typedef void (*accumulate_func)(uint64_t *acc, const uint8_t *p,
+      size_t stripes, unsigned *count);
+
+static const uint64_t lane_init[4] =
+{
+   UINT64_C(0x00000000C2B2AE3D), UINT64_C(0x9E3779B185EBCA87),
+   UINT64_C(0xC2B2AE3D27D4EB4F), UINT64_C(0x165667B19E3779F9)
+};
+
+static const uint64_t lane_key[4] =
+{
+   UINT64_C(0xBE4BA423396CFEB8), UINT64_C(0x1CAD21F72C81017C),
+   UINT64_C(0xDB979083E96DD4DE), UINT64_C(0x1F67B3B7A4A44072)
+};
+
+static const uint64_t scramble_key[4] =
+{
+   UINT64_C(0x78E5C0CC4EE679CB), UINT64_C(0x2172FFCC7DD05A82),
+   UINT64_C(0x8E2443F7744608B8), UINT64_C(0x4C263A81E69035E0)
+};
+
+/* Per stripe, lane i takes the 64-bit word d[i]:
+ *    acc[i]   += lo32(d[i] ^ key[i]) * hi32(d[i] ^ key[i])
+ *    acc[i^1] += d[i]
+ * and every SCRAMBLE_STRIPES stripes each lane is scrambled:
+ *    acc[i] = ((acc[i] ^ (acc[i] >> 47)) ^ scramble_key[i]) * PRIME32_1 */
+
+static void accumulate_scalar(uint64_t *acc, const uint8_t *p,
+      size_t stripes, unsigned *count)
+{
+   uint64_t a0 = acc[0], a1 = acc[1], a2 = acc[2], a3 = acc[3];
+
+   for (; stripes != 0; --stripes, p += STRIPE_BYTES)
+   {
+      uint64_t d[4], k0, k1, k2, k3;
+
+      memcpy(d, p, sizeof(d));
+      k0 = d[0] ^ lane_key[0];
+      k1 = d[1] ^ lane_key[1];
+      k2 = d[2] ^ lane_key[2];
+      k3 = d[3] ^ lane_key[3];
+
+      a0 += (k0 & 0xffffffff) * (k0 >> 32) + d[1];
+      a1 += (k1 & 0xffffffff) * (k1 >> 32) + d[0];
+      a2 += (k2 & 0xffffffff) * (k2 >> 32) + d[3];
+      a3 += (k3 & 0xffffffff) * (k3 >> 32) + d[2];
+
+      if ((++*count % SCRAMBLE_STRIPES) == 0)
+      {
+         a0 = ((a0 ^ (a0 >> 47)) ^ scramble_key[0]) * PRIME32_1;
+         a1 = ((a1 ^ (a1 >> 47)) ^ scramble_key[1]) * PRIME32_1;
+         a2 = ((a2 ^ (a2 >> 47)) ^ scramble_key[2]) * PRIME32_1;
+         a3 = ((a3 ^ (a3 >> 47)) ^ scramble_key[3]) * PRIME32_1;
+      }
+   }
+
+   acc[0] = a0; acc[1] = a1; acc[2] = a2; acc[3] = a3;
+}
+
+#if defined(ARCH_MIN_SSE2)
+static __m128i scramble_sse2(__m128i a, __m128i key, __m128i prime)
+{
+   a = _mm_xor_si128(_mm_xor_si128(a, _mm_srli_epi64(a, 47)), key);
+   return _mm_add_epi64(_mm_mul_epu32(a, prime),
+         _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), prime), 32));
+}
+
+static void accumulate_sse2(uint64_t *acc, const uint8_t *p,
+      size_t stripes, unsigned *count)
+{
+   const __m128i key0   = _mm_loadu_si128((const __m128i*)lane_key);
+   const __m128i key1   = _mm_loadu_si128((const __m128i*)(lane_key + 2));
+   const __m128i skey0  = _mm_loadu_si128((const __m128i*)scramble_key);
+   const __m128i skey1  = _mm_loadu_si128((const __m128i*)(scramble_key + 2));
+   const __m128i prime  = _mm_set1_epi32((int)PRIME32_1);
+   __m128i a0 = _mm_loadu_si128((const __m128i*)acc);
+   __m128i a1 = _mm_loadu_si128((const __m128i*)(acc + 2));
+
+   for (; stripes != 0; --stripes, p += STRIPE_BYTES)
+   {
+      __m128i d0 = _mm_loadu_si128((const __m128i*)p);
+      __m128i d1 = _mm_loadu_si128((const __m128i*)(p + 16));
+      __m128i k0 = _mm_xor_si128(d0, key0);
+      __m128i k1 = _mm_xor_si128(d1, key1);
+
+      a0 = _mm_add_epi64(a0, _mm_mul_epu32(k0, _mm_srli_epi64(k0, 32)));
+      a1 = _mm_add_epi64(a1, _mm_mul_epu32(k1, _mm_srli_epi64(k1, 32)));
+      a0 = _mm_add_epi64(a0, _mm_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2)));
+      a1 = _mm_add_epi64(a1, _mm_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2)));
+
+      if ((++*count % SCRAMBLE_STRIPES) == 0)
+      {
+         a0 = scramble_sse2(a0, skey0, prime);
+         a1 = scramble_sse2(a1, skey1, prime);
+      }
+   }
+
+   _mm_storeu_si128((__m128i*)acc, a0);
+   _mm_storeu_si128((__m128i*)(acc + 2), a1);
+}
+
+#ifdef TEXTURE_HASH_AVX2
+__attribute__((target("avx2")))
+static void accumulate_avx2(uint64_t *acc, const uint8_t *p,
+      size_t stripes, unsigned *count)
+{
+   const __m256i key   = _mm256_loadu_si256((const __m256i*)lane_key);
+   const __m256i skey  = _mm256_loadu_si256((const __m256i*)scramble_key);
+   const __m256i prime = _mm256_set1_epi32((int)PRIME32_1);
+   __m256i a = _mm256_loadu_si256((const __m256i*)acc);
+
+   for (; stripes != 0; --stripes, p += STRIPE_BYTES)
+   {
+      __m256i d = _mm256_loadu_si256((const __m256i*)p);
+      __m256i k = _mm256_xor_si256(d, key);
+
+      a = _mm256_add_epi64(a, _mm256_mul_epu32(k, _mm256_srli_epi64(k, 32)));
+      a = _mm256_add_epi64(a, _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+
+      if ((++*count % SCRAMBLE_STRIPES) == 0)
+      {
+         a = _mm256_xor_si256(_mm256_xor_si256(a, _mm256_srli_epi64(a, 47)), skey);
+         a = _mm256_add_epi64(_mm256_mul_epu32(a, prime),
+               _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime), 32));
+      }
+   }
+
+   _mm256_storeu_si256((__m256i*)acc, a);
+}
+#endif
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+static uint64x2_t scramble_neon(uint64x2_t a, uint64x2_t key, uint32x2_t prime)
+{
+   a = veorq_u64(veorq_u64(a, vshrq_n_u64(a, 47)), key);
+   return vaddq_u64(vmull_u32(vmovn_u64(a), prime),
+         vshlq_n_u64(vmull_u32(vshrn_n_u64(a, 32), prime), 32));
+}
+
+static void accumulate_neon(uint64_t *acc, const uint8_t *p,
+      size_t stripes, unsigned *count)
+{
+   const uint64x2_t key0  = vld1q_u64(lane_key);
+   const uint64x2_t key1  = vld1q_u64(lane_key + 2);
+   const uint64x2_t skey0 = vld1q_u64(scramble_key);
+   const uint64x2_t skey1 = vld1q_u64(scramble_key + 2);
+   const uint32x2_t prime = vdup_n_u32((uint32_t)PRIME32_1);
+   uint64x2_t a0 = vld1q_u64(acc);
+   uint64x2_t a1 = vld1q_u64(acc + 2);
+
+   for (; stripes != 0; --stripes, p += STRIPE_BYTES)
+   {
+      uint64x2_t d0 = vreinterpretq_u64_u8(vld1q_u8(p));
+      uint64x2_t d1 = vreinterpretq_u64_u8(vld1q_u8(p + 16));
+      uint64x2_t k0 = veorq_u64(d0, key0);
+      uint64x2_t k1 = veorq_u64(d1, key1);
+
+      a0 = vaddq_u64(a0, vmull_u32(vmovn_u64(k0), vshrn_n_u64(k0, 32)));
+      a1 = vaddq_u64(a1, vmull_u32(vmovn_u64(k1), vshrn_n_u64(k1, 32)));
+      a0 = vaddq_u64(a0, vextq_u64(d0, d0, 1));
+      a1 = vaddq_u64(a1, vextq_u64(d1, d1, 1));
+
+      if ((++*count % SCRAMBLE_STRIPES) == 0)
+      {
+         a0 = scramble_neon(a0, skey0, prime);
+         a1 = scramble_neon(a1, skey1, prime);
+      }
+   }
+
+   vst1q_u64(acc, a0);
+   vst1q_u64(acc + 2, a1);
+}
+#endif
+
+static accumulate_func accumulate;
+static const char *accumulate_name;
+
+static void select_impl(void)
+{
+#if defined(TEXTURE_HASH_AVX2)
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+   {
+      accumulate_name = "avx2";
+      accumulate      = accumulate_avx2;
+      return;
+   }
+#endif
+#if defined(ARCH_MIN_SSE2)
+   accumulate_name = "sse2";
+   accumulate      = accumulate_sse2;
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+   accumulate_name = "neon";
+   accumulate      = accumulate_neon;
+#else
+   accumulate_name = "scalar";
+   accumulate      = accumulate_scalar;
+#endif
+}
+
+static uint64_t mix64(uint64_t h)
+{
+   h ^= h >> 33;
+   h *= UINT64_C(0xFF51AFD7ED558CCD);
+   h ^= h >> 33;
+   h *= UINT64_C(0xC4CEB9FE1A85EC53);
+   h ^= h >> 33;
+   return h;
+}
+
+uint64_t texture_hash_rows(uint64_t seed, const void *data,
+      size_t row_bytes, size_t rows, ptrdiff_t stride)
+{
+   const uint8_t *row = (const uint8_t*)data;
+   const size_t stripes = row_bytes / STRIPE_BYTES;
+   const size_t tail    = row_bytes % STRIPE_BYTES;
+   uint64_t acc[4];
+   uint64_t h;
+   unsigned count = 0;
+   unsigned i;
+
+   if (accumulate == NULL)
+      select_impl();
+
+   for (i = 0; i < 4; ++i)
+      acc[i] = lane_init[i] ^ seed;
+
+   for (; rows != 0; --rows, row += stride)
+   {
+      if (stripes != 0)
+         accumulate(acc, row, stripes, &count);
+
+      if (tail != 0)
+      {
+         uint8_t last[STRIPE_BYTES] = {0};
+         memcpy(last, row + stripes * STRIPE_BYTES, tail);
+         accumulate(acc, last, 1, &count);
+      }
+   }
+
+   h = seed ^ ((uint64_t)row_bytes * PRIME64_1) ^ ((uint64_t)count * PRIME64_2);
+   for (i = 0; i < 4; ++i)
+   {
+      h = (h ^ mix64(acc[i])) * PRIME64_1;
+      h = (h << 31) | (h >> 33);
+   }
+
+   return mix64(h);
+}
+
+uint64_t texture_hash(uint64_t seed, const void *data, size_t length)
+{
+   return texture_hash_rows(seed, data, length, 1, (ptrdiff_t)length);
+}
+
+const char *texture_hash_impl(void)
+{
+   if (accumulate == NULL)
+      select_impl();
+   return accumulate_name;
+}
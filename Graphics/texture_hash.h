@@ -0,0 +1,34 @@
+#ifndef _TEXTURE_HASH_H
+#define _TEXTURE_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 64-bit non-cryptographic hash for texture cache keys.
+ *
+ * Data is consumed in 32-byte stripes by four 64-bit lanes, so it maps onto
+ * SSE2/AVX2/NEON registers directly. The implementation is picked from the
+ * host CPU features on first use and every implementation gives the same
+ * result for the same bytes.
+ *
+ * texture_hash_rows() hashes rows of row_bytes bytes, stride bytes apart,
+ * the way textures sit in TMEM or RDRAM. Each row is zero padded to a whole
+ * stripe, so a row based hash differs from a flat hash of the same bytes.
+ * stride may be negative or smaller than row_bytes, as TMEM lines can be. */
+
+uint64_t texture_hash(uint64_t seed, const void *data, size_t length);
+uint64_t texture_hash_rows(uint64_t seed, const void *data,
+      size_t row_bytes, size_t rows, ptrdiff_t stride);
+
+/* Name of the implementation in use, for logging. */
+const char *texture_hash_impl(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
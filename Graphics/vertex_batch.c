@@ -0,0 +1,268 @@
+#include <math.h>
+
+#include "vertex_batch.h"
+
+/* Each pass is written once against the small set of operations below.
+ * The scalar build uses them one vertex at a time. 32-bit ARM NEON has no
+ * exact divide or square root, so only AArch64 takes the NEON path. */
+
+#if defined(ARCH_MIN_SSE2)
+#include <emmintrin.h>
+#define VERTEX_BATCH_SSE2
+#define VWIDTH 4
+
+typedef __m128 vfloat;
+typedef __m128 vmask;
+
+#define VLOAD(p)         _mm_loadu_ps(p)
+#define VSTORE(p, v)     _mm_storeu_ps(p, v)
+#define VSET1(f)         _mm_set1_ps(f)
+#define VADD(a, b)       _mm_add_ps(a, b)
+#define VMUL(a, b)       _mm_mul_ps(a, b)
+#define VDIV(a, b)       _mm_div_ps(a, b)
+#define VSQRT(a)         _mm_sqrt_ps(a)
+/* (a < b ? a : b) and (a > b ? a : b), as MIN and MAX */
+#define VMIN(a, b)       _mm_min_ps(a, b)
+#define VMAX(a, b)       _mm_max_ps(a, b)
+#define VNEG(a)          _mm_xor_ps(a, _mm_set1_ps(-0.0f))
+#define VABS(a)          _mm_andnot_ps(_mm_set1_ps(-0.0f), a)
+#define VLT(a, b)        _mm_cmplt_ps(a, b)
+#define VGT(a, b)        _mm_cmpgt_ps(a, b)
+#define VNE(a, b)        _mm_cmpneq_ps(a, b)
+#define VSELECT(m, a, b) _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b))
+#define VBITS(m)         ((unsigned)_mm_movemask_ps(m))
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define VERTEX_BATCH_NEON
+#define VWIDTH 4
+
+typedef float32x4_t vfloat;
+typedef uint32x4_t  vmask;
+
+#define VLOAD(p)         vld1q_f32(p)
+#define VSTORE(p, v)     vst1q_f32(p, v)
+#define VSET1(f)         vdupq_n_f32(f)
+#define VADD(a, b)       vaddq_f32(a, b)
+#define VMUL(a, b)       vmulq_f32(a, b)
+#define VDIV(a, b)       vdivq_f32(a, b)
+#define VSQRT(a)         vsqrtq_f32(a)
+#define VMIN(a, b)       vbslq_f32(vcltq_f32(a, b), a, b)
+#define VMAX(a, b)       vbslq_f32(vcgtq_f32(a, b), a, b)
+#define VNEG(a)          vnegq_f32(a)
+#define VABS(a)          vabsq_f32(a)
+#define VLT(a, b)        vcltq_f32(a, b)
+#define VGT(a, b)        vcgtq_f32(a, b)
+#define VNE(a, b)        vmvnq_u32(vceqq_f32(a, b))
+#define VSELECT(m, a, b) vbslq_f32(m, a, b)
+
+static unsigned vbits_neon(uint32x4_t m)
+{
+   static const uint32_t lane[4] = { 1, 2, 4, 8 };
+   return vaddvq_u32(vandq_u32(m, vld1q_u32(lane)));
+}
+
+#define VBITS(m)         vbits_neon(m)
+#else
+#define VWIDTH 1
+
+typedef float    vfloat;
+typedef unsigned vmask;
+
+#define VLOAD(p)         (*(p))
+#define VSTORE(p, v)     (*(p) = (v))
+#define VSET1(f)         (f)
+#define VADD(a, b)       ((a) + (b))
+#define VMUL(a, b)       ((a) * (b))
+#define VDIV(a, b)       ((a) / (b))
+#define VSQRT(a)         sqrtf(a)
+#define VMIN(a, b)       ((a) < (b) ? (a) : (b))
+#define VMAX(a, b)       ((a) > (b) ? (a) : (b))
+#define VNEG(a)          (-(a))
+#define VABS(a)          fabsf(a)
+#define VLT(a, b)        ((vmask)((a) < (b)))
+#define VGT(a, b)        ((vmask)((a) > (b)))
+#define VNE(a, b)        ((vmask)((a) != (b)))
+#define VSELECT(m, a, b) ((m) ? (a) : (b))
+#define VBITS(m)         (m)
+#endif
+
+/* Spreads the lane bits of a mask into clip codes. */
+static void add_clip_bits(uint32_t *clip, unsigned bits, uint32_t code)
+{
+   unsigned i;
+   for (i = 0; i < VWIDTH; i++)
+      if (bits & (1u << i))
+         clip[i] |= code;
+}
+
+void vertex_transform_batch(struct vertex_batch *b, unsigned n,
+      float mtx[4][4])
+{
+   unsigned i;
+   const vfloat m00 = VSET1(mtx[0][0]), m01 = VSET1(mtx[0][1]);
+   const vfloat m02 = VSET1(mtx[0][2]), m03 = VSET1(mtx[0][3]);
+   const vfloat m10 = VSET1(mtx[1][0]), m11 = VSET1(mtx[1][1]);
+   const vfloat m12 = VSET1(mtx[1][2]), m13 = VSET1(mtx[1][3]);
+   const vfloat m20 = VSET1(mtx[2][0]), m21 = VSET1(mtx[2][1]);
+   const vfloat m22 = VSET1(mtx[2][2]), m23 = VSET1(mtx[2][3]);
+   const vfloat m30 = VSET1(mtx[3][0]), m31 = VSET1(mtx[3][1]);
+   const vfloat m32 = VSET1(mtx[3][2]), m33 = VSET1(mtx[3][3]);
+
+   for (i = 0; i < n; i += VWIDTH)
+   {
+      vfloat x = VLOAD(&b->x[i]);
+      vfloat y = VLOAD(&b->y[i]);
+      vfloat z = VLOAD(&b->z[i]);
+
+      VSTORE(&b->x[i], VADD(VADD(VADD(VMUL(x, m00), VMUL(y, m10)), VMUL(z, m20)), m30));
+      VSTORE(&b->y[i], VADD(VADD(VADD(VMUL(x, m01), VMUL(y, m11)), VMUL(z, m21)), m31));
+      VSTORE(&b->z[i], VADD(VADD(VADD(VMUL(x, m02), VMUL(y, m12)), VMUL(z, m22)), m32));
+      VSTORE(&b->w[i], VADD(VADD(VADD(VMUL(x, m03), VMUL(y, m13)), VMUL(z, m23)), m33));
+   }
+}
+
+void vertex_project_batch(struct vertex_batch *b, unsigned n, float w_min)
+{
+   unsigned i;
+   const vfloat one  = VSET1(1.0f);
+   const vfloat wmin = VSET1(w_min);
+
+   for (i = 0; i < n; i += VWIDTH)
+   {
+      vfloat w   = VLOAD(&b->w[i]);
+      vfloat oow;
+
+      w   = VSELECT(VLT(VABS(w), wmin), wmin, w);
+      oow = VDIV(one, w);
+
+      VSTORE(&b->w[i],   w);
+      VSTORE(&b->oow[i], oow);
+      VSTORE(&b->x_w[i], VMUL(VLOAD(&b->x[i]), oow));
+      VSTORE(&b->y_w[i], VMUL(VLOAD(&b->y[i]), oow));
+      VSTORE(&b->z_w[i], VMUL(VLOAD(&b->z[i]), oow));
+   }
+}
+
+void vertex_clip_batch(struct vertex_batch *b, unsigned n, float w_min)
+{
+   unsigned i;
+   const vfloat wmin = VSET1(w_min);
+
+   for (i = 0; i < n; i += VWIDTH)
+   {
+      unsigned k;
+      vfloat x  = VLOAD(&b->x[i]);
+      vfloat y  = VLOAD(&b->y[i]);
+      vfloat w  = VLOAD(&b->w[i]);
+      vfloat nw = VNEG(w);
+
+      for (k = 0; k < VWIDTH; k++)
+         b->clip[i + k] = 0;
+
+      add_clip_bits(&b->clip[i], VBITS(VGT(x, w)),    VERTEX_CLIP_POSX);
+      add_clip_bits(&b->clip[i], VBITS(VLT(x, nw)),   VERTEX_CLIP_NEGX);
+      add_clip_bits(&b->clip[i], VBITS(VGT(y, w)),    VERTEX_CLIP_POSY);
+      add_clip_bits(&b->clip[i], VBITS(VLT(y, nw)),   VERTEX_CLIP_NEGY);
+      add_clip_bits(&b->clip[i], VBITS(VLT(w, wmin)), VERTEX_CLIP_W);
+   }
+}
+
+void vertex_fog_batch(struct vertex_batch *b, unsigned n,
+      float multiplier, float offset)
+{
+   unsigned i;
+   const vfloat zero = VSET1(0.0f);
+   const vfloat max  = VSET1(255.0f);
+   const vfloat mul  = VSET1(multiplier);
+   const vfloat add  = VSET1(offset);
+
+   for (i = 0; i < n; i += VWIDTH)
+   {
+      vfloat f = VADD(VMUL(VLOAD(&b->z_w[i]), mul), add);
+
+      f = VMIN(max, VMAX(zero, f));
+      VSTORE(&b->fog[i], VSELECT(VLT(VLOAD(&b->w[i]), zero), zero, f));
+   }
+}
+
+void vertex_normal_batch(struct vertex_batch *b, unsigned n,
+      float mtx[4][4])
+{
+   unsigned i;
+   const vfloat zero = VSET1(0.0f);
+
+   for (i = 0; i < n; i += VWIDTH)
+   {
+      vfloat x = VLOAD(&b->nx[i]);
+      vfloat y = VLOAD(&b->ny[i]);
+      vfloat z = VLOAD(&b->nz[i]);
+      vfloat len;
+      vmask  nonzero;
+
+      if (mtx)
+      {
+         vfloat tx = VADD(VADD(VMUL(VSET1(mtx[0][0]), x), VMUL(VSET1(mtx[1][0]), y)), VMUL(VSET1(mtx[2][0]), z));
+         vfloat ty = VADD(VADD(VMUL(VSET1(mtx[0][1]), x), VMUL(VSET1(mtx[1][1]), y)), VMUL(VSET1(mtx[2][1]), z));
+         vfloat tz = VADD(VADD(VMUL(VSET1(mtx[0][2]), x), VMUL(VSET1(mtx[1][2]), y)), VMUL(VSET1(mtx[2][2]), z));
+         x = tx;
+         y = ty;
+         z = tz;
+      }
+
+      len     = VADD(VADD(VMUL(x, x), VMUL(y, y)), VMUL(z, z));
+      nonzero = VNE(len, zero);
+      len     = VSQRT(len);
+
+      VSTORE(&b->nx[i], VSELECT(nonzero, VDIV(x, len), x));
+      VSTORE(&b->ny[i], VSELECT(nonzero, VDIV(y, len), y));
+      VSTORE(&b->nz[i], VSELECT(nonzero, VDIV(z, len), z));
+   }
+}
+
+void vertex_light_batch(struct vertex_batch *b, unsigned n,
+      const struct vertex_light *lights, unsigned count,
+      const float ambient[3])
+{
+   unsigned i, l;
+   const vfloat zero = VSET1(0.0f);
+   const vfloat one  = VSET1(1.0f);
+
+   for (i = 0; i < n; i += VWIDTH)
+   {
+      vfloat nx = VLOAD(&b->nx[i]);
+      vfloat ny = VLOAD(&b->ny[i]);
+      vfloat nz = VLOAD(&b->nz[i]);
+      vfloat r  = VSET1(ambient[0]);
+      vfloat g  = VSET1(ambient[1]);
+      vfloat bl = VSET1(ambient[2]);
+
+      for (l = 0; l < count; l++)
+      {
+         const struct vertex_light *light = &lights[l];
+         vfloat intensity = VADD(VADD(
+                  VMUL(nx, VSET1(light->dir[0])),
+                  VMUL(ny, VSET1(light->dir[1]))),
+                  VMUL(nz, VSET1(light->dir[2])));
+
+         intensity = VMAX(zero, intensity);
+         r  = VADD(r,  VMUL(VSET1(light->col[0]), intensity));
+         g  = VADD(g,  VMUL(VSET1(light->col[1]), intensity));
+         bl = VADD(bl, VMUL(VSET1(light->col[2]), intensity));
+      }
+
+      VSTORE(&b->r[i], VMIN(one, r));
+      VSTORE(&b->g[i], VMIN(one, g));
+      VSTORE(&b->b[i], VMIN(one, bl));
+   }
+}
+
+const char *vertex_batch_impl(void)
+{
+#if defined(VERTEX_BATCH_SSE2)
+   return "sse2";
+#elif defined(VERTEX_BATCH_NEON)
+   return "neon";
+#else
+   return "scalar";
+#endif
+}
@@ -0,0 +1,94 @@
+#ifndef _VERTEX_BATCH_H
+#define _VERTEX_BATCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Batched vertex math for the HLE plugins.
+ *
+ * A gSPVertex command loads up to VERTEX_BATCH_SIZE vertices. The plugins
+ * copy them into a struct vertex_batch, one array per component, run the
+ * passes below over the whole load and copy the results back. Four
+ * vertices are handled per step with SSE2 or NEON where available.
+ *
+ * Every pass does the same float operations in the same order as the
+ * per-vertex code it replaces, without fused multiply-adds, reciprocal
+ * estimates or reordered sums, so results match the scalar path exactly.
+ * Vector passes may read and write the array slots past n up to the next
+ * multiple of four, which are scratch space. */
+
+#define VERTEX_BATCH_SIZE 64
+
+/* Clip codes, as used by both gln64 and Glide64. */
+#define VERTEX_CLIP_NEGX 0x01
+#define VERTEX_CLIP_POSX 0x02
+#define VERTEX_CLIP_NEGY 0x04
+#define VERTEX_CLIP_POSY 0x08
+#define VERTEX_CLIP_W    0x10
+
+struct vertex_batch
+{
+   float x[VERTEX_BATCH_SIZE];
+   float y[VERTEX_BATCH_SIZE];
+   float z[VERTEX_BATCH_SIZE];
+   float w[VERTEX_BATCH_SIZE];
+
+   float nx[VERTEX_BATCH_SIZE];
+   float ny[VERTEX_BATCH_SIZE];
+   float nz[VERTEX_BATCH_SIZE];
+
+   float r[VERTEX_BATCH_SIZE];
+   float g[VERTEX_BATCH_SIZE];
+   float b[VERTEX_BATCH_SIZE];
+
+   float oow[VERTEX_BATCH_SIZE];
+   float x_w[VERTEX_BATCH_SIZE];
+   float y_w[VERTEX_BATCH_SIZE];
+   float z_w[VERTEX_BATCH_SIZE];
+   float fog[VERTEX_BATCH_SIZE];
+
+   uint32_t clip[VERTEX_BATCH_SIZE];
+};
+
+struct vertex_light
+{
+   float dir[3];
+   float col[3];
+};
+
+/* x, y, z (w taken as 1) to x, y, z, w by mtx, rows applied as
+ * x * mtx[0] + y * mtx[1] + z * mtx[2] + mtx[3]. */
+void vertex_transform_batch(struct vertex_batch *b, unsigned n,
+      float mtx[4][4]);
+
+/* Raises w to w_min where |w| < w_min, then sets oow and x_w, y_w, z_w. */
+void vertex_project_batch(struct vertex_batch *b, unsigned n, float w_min);
+
+/* Clip codes from x, y and w, VERTEX_CLIP_W when w < w_min. */
+void vertex_clip_batch(struct vertex_batch *b, unsigned n, float w_min);
+
+/* fog = clamp(z_w * multiplier + offset, 0, 255), 0 when w < 0. */
+void vertex_fog_batch(struct vertex_batch *b, unsigned n,
+      float multiplier, float offset);
+
+/* nx, ny, nz by the upper 3x3 of mtx, then normalized. NULL mtx only
+ * normalizes. Zero normals are left alone. */
+void vertex_normal_batch(struct vertex_batch *b, unsigned n,
+      float mtx[4][4]);
+
+/* r, g, b = min(1, ambient + sum of col * max(0, dot(normal, dir))). */
+void vertex_light_batch(struct vertex_batch *b, unsigned n,
+      const struct vertex_light *lights, unsigned count,
+      const float ambient[3]);
+
+/* Name of the implementation in use, for logging. */
+const char *vertex_batch_impl(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
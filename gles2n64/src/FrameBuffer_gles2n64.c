@@ -9,6 +9,8 @@
 #include "ShaderCombiner.h"
 #include "VI.h"
 
+#include "../../Graphics/RDP/rdram_gen.h"
+
 struct FrameBufferInfo frameBuffer;
 CachedTexture *g_RDRAMtoFB;
 
@@ -171,6 +173,7 @@ void FrameBuffer_SaveBuffer( uint32_t address, uint16_t format, uint16_t size, u
 
          /* code goes here */
          *(uint32_t*)&gfx_info.RDRAM[current->m_startAddress] = current->m_startAddress;
+         rdram_gen_mark(current->m_startAddress, 4);
 
          current->m_changed = true;
 
@@ -212,6 +215,7 @@ void FrameBuffer_SaveBuffer( uint32_t address, uint16_t format, uint16_t size, u
 
    /* code goes here - just bind texture and copy it over */
    *(uint32_t*)&gfx_info.RDRAM[current->m_startAddress] = current->m_startAddress;
+   rdram_gen_mark(current->m_startAddress, 4);
 
    current->m_changed = true;
 
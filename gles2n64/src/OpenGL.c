@@ -27,6 +27,7 @@
 #include "Config.h"
 
 #include "../../Graphics/RDP/gDP_state.h"
+#include "../../Graphics/RDP/rdram_gen.h"
 #include "../../Graphics/RSP/gSP_state.h"
 
 GLInfo OGL;
@@ -810,6 +811,7 @@ bool texturedRectDepthBufferCopy(const struct TexturedRectParams *_params)
       pDst = (uint16_t*)(gfx_info.RDRAM + gDP.colorImage.address);
       for (x = 0; x < width; ++x)
          pDst[(ulx + x) ^ 1] = swapword(pSrc[x]);
+      rdram_gen_mark(gDP.colorImage.address, (ulx + width + 1) << 1);
 
       return true;
    }
@@ -851,6 +853,7 @@ static bool texturedRectBGCopy(const struct TexturedRectParams *_params)
 		uint8_t *dst = fbaddr + y * gDP.colorImage.width;
 		memcpy(dst, src, width);
 	}
+	rdram_gen_mark(gDP.colorImage.address + (uint32_t)_params->ulx, lry * gDP.colorImage.width);
 	FrameBuffer_RemoveBuffer(gDP.colorImage.address);
 	return true;
 }
@@ -874,6 +877,7 @@ static bool texturedRectPaletteMod(const struct TexturedRectParams *_params)
 	dst = (uint16_t*)(gfx_info.RDRAM + gDP.colorImage.address);
 	for (i = 0; i < 16; ++i)
 		dst[i ^ 1] = (src[i<<2] & 0x100) ? prim16 : env16;
+	rdram_gen_mark(gDP.colorImage.address, 32);
 	return true;
 }
 
@@ -18,7 +18,11 @@
 #include "FrameBuffer.h"
 
 #include "../../Graphics/RDP/gDP_state.h"
+#include "../../Graphics/RDP/rdram_gen.h"
+#include "../../Graphics/RDP/tmem_memo.h"
 #include "../../Graphics/image_convert.h"
+#include "../../Graphics/texture_hash.h"
+#include "../../Graphics/texture_decode.h"
 
 #define FORMAT_NONE     0
 #define FORMAT_I8       1
@@ -780,11 +784,97 @@ static void _loadBackground( CachedTexture *pTexture )
 	free(pDest);
 }
 
+#define DECODE_LUT         1
+#define DECODE_RGBA16      2
+#define DECODE_RGBA5551    3
+#define DECODE_IA16        4
+#define DECODE_IA16_4444   5
+
+struct RowDecoder
+{
+	int kind;
+	unsigned bits;
+	uint32_t lut32[256];
+	uint16_t lut16[256];
+};
+
+/* Picks a row decoder from Graphics/texture_decode.c matching GetTexel.
+ * 4 and 8-bit texels go through a table filled by GetTexel itself, so
+ * palettes and conversions come out exactly as texel by texel. */
+static int _getRowDecoder(const CachedTexture *tmptex, GLuint glInternalFormat,
+      GetTexelFunc GetTexel, struct RowDecoder *dec)
+{
+	if (tmptex->size == G_IM_SIZ_4b || tmptex->size == G_IM_SIZ_8b)
+	{
+		unsigned v;
+
+		dec->kind = DECODE_LUT;
+		dec->bits = tmptex->size == G_IM_SIZ_4b ? 4 : 8;
+		for (v = 0; v < (1u << dec->bits); ++v)
+		{
+			uint64_t texel = 0;
+			uint32_t c;
+
+			((uint8_t*)&texel)[0] = dec->bits == 4 ? v << 4 : v;
+			c = GetTexel(&texel, 0, 0, tmptex->palette);
+			dec->lut32[v]  = c;
+			dec->lut16[v]  = (uint16_t)c;
+		}
+		return true;
+	}
+
+	if (tmptex->size != G_IM_SIZ_16b)
+		return false;
+
+	if (GetTexel == GetRGBA5551_RGBA8888)
+		dec->kind = DECODE_RGBA16;
+	else if (GetTexel == GetRGBA5551_RGBA5551)
+		dec->kind = DECODE_RGBA5551;
+	else if (GetTexel == GetIA88_RGBA8888)
+		dec->kind = DECODE_IA16;
+	else if (GetTexel == GetIA88_RGBA4444)
+		dec->kind = DECODE_IA16_4444;
+	else
+		return false;
+
+	return (glInternalFormat == GL_RGBA) ==
+		(dec->kind == DECODE_RGBA16 || dec->kind == DECODE_IA16);
+}
+
+static void _decodeRow(const struct RowDecoder *dec, GLuint glInternalFormat,
+      void *dst, const uint64_t *src, unsigned count, unsigned swizzle)
+{
+	const uint8_t *src8 = (const uint8_t*)src;
+
+	switch (dec->kind)
+	{
+		case DECODE_LUT:
+			if (glInternalFormat == GL_RGBA)
+				texture_decode_lut32((uint32_t*)dst, src8, 0, count, swizzle, dec->bits, dec->lut32);
+			else
+				texture_decode_lut16((uint16_t*)dst, src8, 0, count, swizzle, dec->bits, dec->lut16);
+			break;
+		case DECODE_RGBA16:
+			texture_decode_rgba16_32((uint32_t*)dst, src8, 0, count, swizzle, TEXTURE_DECODE_ROUND);
+			break;
+		case DECODE_RGBA5551:
+			texture_fetch_16b((uint16_t*)dst, src8, 0, count, swizzle);
+			break;
+		case DECODE_IA16:
+			texture_decode_ia16_32((uint32_t*)dst, src8, 0, count, swizzle);
+			break;
+		case DECODE_IA16_4444:
+			texture_decode_ia16_4444((uint16_t*)dst, src8, 0, count, swizzle, 0);
+			break;
+	}
+}
+
 static INLINE void TextureCache_getTextureDestData(CachedTexture *tmptex, uint32_t* pDest, GLuint glInternalFormat, GetTexelFunc GetTexel, uint16_t* pLine)
 {
 	uint64_t *pSrc;
 	uint16_t x, y, i, j, tx, ty;
 	uint16_t mirrorSBit, maskSMask, clampSClamp;
+	struct RowDecoder decoder;
 	uint16_t mirrorTBit, maskTMask, clampTClamp;
 
    if (tmptex->maskS > 0) {
@@ -860,6 +950,63 @@ static INLINE void TextureCache_getTextureDestData(CachedTexture *tmptex, uint32
          }
       }
    }
+   else if (_getRowDecoder(tmptex, glInternalFormat, GetTexel, &decoder))
+   {
+      /* The S wrap is the same on every row: decode texels 0 to txMax of
+       * the row and pick from them, or decode in place if it is identity. */
+      const unsigned shift = glInternalFormat == GL_RGBA ? 2 : 1;
+      uint16_t *txMap = (uint16_t*)malloc(tmptex->realWidth * sizeof(uint16_t));
+      uint8_t *row = NULL;
+      uint32_t tMemMask;
+      uint16_t txMax = 0;
+      bool identity = true;
+
+      tMemMask = gDP.otherMode.textureLUT == G_TT_NONE ? 0x1FF : 0xFF;
+
+      for (x = 0; x < tmptex->realWidth; ++x) {
+         tx = MIN(x, clampSClamp) & maskSMask;
+         if (x & mirrorSBit)
+            tx ^= maskSMask;
+         txMap[x] = tx;
+         identity &= tx == x;
+         txMax = MAX(txMax, tx);
+      }
+
+      if (!identity)
+         row = (uint8_t*)malloc((txMax + 1) << shift);
+
+      for (y = 0; y < tmptex->realHeight; ++y)
+      {
+         uint8_t *dst = (uint8_t*)pDest + ((y * tmptex->realWidth) << shift);
+
+         ty = MIN(y, clampTClamp) & maskTMask;
+
+         if (y & mirrorTBit)
+            ty ^= maskTMask;
+
+         pSrc = &TMEM[(tmptex->tMem + *pLine * ty) & tMemMask];
+
+         if (identity)
+         {
+            _decodeRow(&decoder, glInternalFormat, dst, pSrc, tmptex->realWidth,
+                  (ty & 1) ? TEXTURE_SWIZZLE_ODD : TEXTURE_SWIZZLE_TMEM);
+            continue;
+         }
+
+         _decodeRow(&decoder, glInternalFormat, row, pSrc, txMax + 1,
+               (ty & 1) ? TEXTURE_SWIZZLE_ODD : TEXTURE_SWIZZLE_TMEM);
+
+         if (glInternalFormat == GL_RGBA)
+            for (x = 0; x < tmptex->realWidth; ++x)
+               ((uint32_t*)dst)[x] = ((uint32_t*)row)[txMap[x]];
+         else
+            for (x = 0; x < tmptex->realWidth; ++x)
+               ((uint16_t*)dst)[x] = ((uint16_t*)row)[txMap[x]];
+      }
+
+      free(row);
+      free(txMap);
+   }
    else
    {
       uint32_t tMemMask;
@@ -1008,29 +1155,36 @@ struct TextureParams
 	uint8_t size;
 };
 
-static uint32_t _calculateCRC(uint32_t t, const struct TextureParams *_params)
+static uint64_t _calculateCRC(uint32_t t, const struct TextureParams *_params)
 {
    const uint32_t line = gSP.textureTile[t]->line;
    const uint32_t lineBytes = line << 3;
 
    const uint64_t *src = (uint64_t*)&TMEM[gSP.textureTile[t]->tmem];
-   uint32_t crc = 0xFFFFFFFF;
-   crc = Hash_Calculate(crc, src, _params->height*lineBytes);
+   const uint32_t bytes = _params->height*lineBytes;
+   const uint32_t key = bytes;
+   uint64_t crc = 0;
 
    if (gSP.textureTile[t]->size == G_IM_SIZ_32b)
    {
+      crc = texture_hash(crc, src, bytes);
       src = (uint64_t*)&TMEM[gSP.textureTile[t]->tmem + 256];
-      crc = Hash_Calculate(crc, src, _params->height*lineBytes);
+      crc = texture_hash(crc, src, bytes);
+   }
+   else if (!tmem_memo_lookup(gSP.textureTile[t]->tmem << 3, bytes, &key, 1, &crc))
+   {
+      crc = texture_hash(crc, src, bytes);
+      tmem_memo_store(gSP.textureTile[t]->tmem << 3, bytes, &key, 1, crc);
    }
 
    if (gDP.otherMode.textureLUT != G_TT_NONE || gSP.textureTile[t]->format == G_IM_FMT_CI) {
       if (gSP.textureTile[t]->size == G_IM_SIZ_4b)
-         crc = Hash_Calculate( crc, &gDP.paletteCRC16[gSP.textureTile[t]->palette], 4 );
+         crc = texture_hash(crc, &gDP.paletteCRC16[gSP.textureTile[t]->palette], 4);
       else if (gSP.textureTile[t]->size == G_IM_SIZ_8b)
-         crc = Hash_Calculate( crc, &gDP.paletteCRC256, 4 );
+         crc = texture_hash(crc, &gDP.paletteCRC256, 4);
    }
 
-   crc = Hash_Calculate(crc, _params, sizeof(_params));
+   crc = texture_hash(crc, _params, sizeof(*_params));
 
    return crc;
 }
@@ -1104,7 +1258,7 @@ void TextureCache_ActivateDummy( uint32_t t)
    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 }
 
-int _background_compare(CachedTexture *current, uint32_t crc)
+int _background_compare(CachedTexture *current, uint64_t crc)
 {
    if ((current != NULL) &&
          (current->crc == crc) &&
@@ -1119,19 +1273,32 @@ int _background_compare(CachedTexture *current, uint32_t crc)
 
 void _updateBackground(void)
 {
-   uint32_t numBytes, crc;
+   static uint32_t lastAddress, lastBytes, lastStamp;
+   static uint64_t lastCrc;
+   uint32_t numBytes;
+   uint64_t crc;
    CachedTexture *current;
    CachedTexture *pCurrent;
 
    numBytes = gSP.bgImage.width * gSP.bgImage.height << gSP.bgImage.size >> 1;
-   crc = Hash_Calculate( 0xFFFFFFFF, &gfx_info.RDRAM[gSP.bgImage.address], numBytes );
+   if (gSP.bgImage.address == lastAddress && numBytes == lastBytes
+         && rdram_gen_unchanged(lastAddress, lastBytes, lastStamp))
+      crc = lastCrc;
+   else
+   {
+      crc = texture_hash(0, &gfx_info.RDRAM[gSP.bgImage.address], numBytes);
+      lastAddress = gSP.bgImage.address;
+      lastBytes   = numBytes;
+      lastCrc     = crc;
+      lastStamp   = rdram_gen_current();
+   }
 
    if (gDP.otherMode.textureLUT != G_TT_NONE || gSP.bgImage.format == G_IM_FMT_CI)
    {
       if (gSP.bgImage.size == G_IM_SIZ_4b)
-         crc = Hash_Calculate( crc, &gDP.paletteCRC16[gSP.bgImage.palette], 4 );
+         crc = texture_hash(crc, &gDP.paletteCRC16[gSP.bgImage.palette], 4);
       else if (gSP.bgImage.size == G_IM_SIZ_8b)
-         crc = Hash_Calculate( crc, &gDP.paletteCRC256, 4 );
+         crc = texture_hash(crc, &gDP.paletteCRC256, 4);
    }
 
    //before we traverse cache, check to see if texture is already bound:
@@ -1199,7 +1366,7 @@ void _updateBackground(void)
    cache.current[0] = pCurrent;
 }
 
-int _texture_compare(uint32_t t, CachedTexture *current, uint32_t crc,  uint32_t width, uint32_t height, uint32_t clampWidth, uint32_t clampHeight)
+int _texture_compare(uint32_t t, CachedTexture *current, uint64_t crc,  uint32_t width, uint32_t height, uint32_t clampWidth, uint32_t clampHeight)
 {
    return  ((current != NULL) &&
          (current->crc == crc) &&
@@ -1238,7 +1405,7 @@ void TextureCache_Update( uint32_t _t )
 {
    CachedTexture *current;
    CachedTexture *pCurrent;
-   uint32_t crc;
+   uint64_t crc;
    struct TextureParams params;
    struct TileSizes sizes;
 
@@ -19,7 +19,7 @@ typedef struct CachedTexture
 {
    GLuint  glName;
    uint32_t     address;
-   uint32_t     crc;
+   uint64_t     crc;
    float   offsetS, offsetT;
    uint32_t     maskS, maskT;
    uint32_t     clampS, clampT;
@@ -11,6 +11,7 @@
 #include "3DMath.h"
 
 #include "../../Graphics/RDP/gDP_state.h"
+#include "../../Graphics/RDP/rdram_gen.h"
 #include "../../Graphics/RSP/gSP_state.h"
 #include "../../Graphics/HLE/Microcode/ZSort.h"
 
@@ -438,6 +439,7 @@ void ZSort_MoveMem( uint32_t _w0, uint32_t _w1 )
          {
             int dmem_addr = (idx<<3) + ofs;
             memcpy(gfx_info.RDRAM + addr, gfx_info.DMEM + dmem_addr, len);
+            rdram_gen_mark(addr, len);
          }
          break;
 
@@ -25,6 +25,7 @@
 
 #include "../../Graphics/RDP/gDP_state.h"
 #include "../../Graphics/RDP/RDP_state.h"
+#include "../../Graphics/RDP/tmem_memo.h"
 #include "../../Graphics/RSP/gSP_state.h"
 
 void gln64gDPSetOtherMode( uint32_t mode0, uint32_t mode1 )
@@ -529,13 +530,19 @@ void gln64gDPLoadTile(uint32_t tile, uint32_t uls, uint32_t ult, uint32_t lrs, u
 		return;
 
 	if (gDP.loadTile->size == G_IM_SIZ_32b)
+   {
 		gln64gDPLoadTile32b(gDP.loadTile->uls, gDP.loadTile->ult, gDP.loadTile->lrs, gDP.loadTile->lrt);
+      tmem_memo_forget(0, 4096);
+   }
 	else
    {
       uint32_t y;
       uint32_t tmemAddr = gDP.loadTile->tmem;
 
       const uint32_t line = gDP.loadTile->line;
+
+      tmem_memo_load(tmemAddr << 3, height * bpl, address, height * gDP.textureImage.bpl,
+            bpl | 0x80000000, gDP.textureImage.bpl);
       for (y = 0; y < height; ++y)
       {
          UnswapCopyWrap(gfx_info.RDRAM, address, (uint8_t*)TMEM, tmemAddr << 3, 0xFFF, bpl);
@@ -646,9 +653,15 @@ void gln64gDPLoadBlock(uint32_t tile, uint32_t uls, uint32_t ult, uint32_t lrs,
 	CheckForFrameBufferTexture(address, bytes); // Load data to TMEM even if FB texture is found. See comment to texturedRectDepthBufferCopy
 
 	if (gDP.loadTile->size == G_IM_SIZ_32b)
+   {
 		gln64gDPLoadBlock32(gDP.loadTile->uls, gDP.loadTile->lrs, dxt);
+      tmem_memo_forget(0, 4096);
+   }
 	else if (gDP.loadTile->format == G_IM_FMT_YUV)
+   {
 		memcpy(TMEM, &gfx_info.RDRAM[address], bytes); // HACK!
+      tmem_memo_forget(0, bytes);
+   }
 	else {
       uint32_t tmemAddr = gDP.loadTile->tmem;
 
@@ -659,6 +672,8 @@ void gln64gDPLoadBlock(uint32_t tile, uint32_t uls, uint32_t ult, uint32_t lrs,
          uint32_t bpl = line << 3;
          uint32_t height = bytes / bpl;
 
+         tmem_memo_load(tmemAddr << 3, height * bpl, address, height * bpl, dxt, 0);
+
          for (y = 0; y < height; ++y)
          {
             UnswapCopyWrap(gfx_info.RDRAM, address, (uint8_t*)TMEM, tmemAddr << 3, 0xFFF, bpl);
@@ -668,8 +683,12 @@ void gln64gDPLoadBlock(uint32_t tile, uint32_t uls, uint32_t ult, uint32_t lrs,
             address += bpl;
             tmemAddr += line;
          }
-      } else
+      }
+      else
+      {
          UnswapCopyWrap(gfx_info.RDRAM, address, (uint8_t*)TMEM, tmemAddr << 3, 0xFFF, bytes);
+         tmem_memo_load(tmemAddr << 3, bytes, address, bytes, 0, 0);
+      }
 	}
 }
 
@@ -686,6 +705,7 @@ void gln64gDPLoadTLUT( uint32_t tile, uint32_t uls, uint32_t ult, uint32_t lrs,
 	address = gDP.textureImage.address + gDP.tiles[tile].ult * gDP.textureImage.bpl + (gDP.tiles[tile].uls << gDP.textureImage.size >> 1);
 	pal = (uint16_t)((gDP.tiles[tile].tmem - 256) >> 4);
 	dest = (uint16_t*)&TMEM[gDP.tiles[tile].tmem];
+	tmem_memo_forget(gDP.tiles[tile].tmem << 3, count << 3);
 
 	i = 0;
 	while (i < count)
@@ -27,6 +27,8 @@
 #include "../../Graphics/RDP/gDP_state.h"
 #include "../../Graphics/RSP/gSP_state.h"
 #include "../../Graphics/image_convert.h"
+#include "../../Graphics/vertex_batch.h"
+#include "../../Graphics/RSP/vertex_memo.h"
 
 //Note: 0xC0 is used by 1080 alot, its an unknown command.
 
@@ -322,6 +324,34 @@ void gln64gSPClipVertex(uint32_t v)
    if (vtx->w < 0.01f)      vtx->clip |= CLIP_Z;
 }
 
+static void gln64gSPTexGenVertex(struct SPVertex *vtx)
+{
+   float fLightDir[3] = {vtx->nx, vtx->ny, vtx->nz};
+   float x, y;
+
+   if (gSP.lookatEnable)
+   {
+      x = DotProduct(&gSP.lookat[0].x, fLightDir);
+      y = DotProduct(&gSP.lookat[1].x, fLightDir);
+   }
+   else
+   {
+      x = fLightDir[0];
+      y = fLightDir[1];
+   }
+
+   if (gSP.geometryMode & G_TEXTURE_GEN_LINEAR)
+   {
+      vtx->s = acosf(x) * 325.94931f;
+      vtx->t = acosf(y) * 325.94931f;
+   }
+   else /* G_TEXTURE_GEN */
+   {
+      vtx->s = (x + 1.0f) * 512.0f;
+      vtx->t = (y + 1.0f) * 512.0f;
+   }
+}
+
 void gln64gSPProcessVertex(uint32_t v)
 {
    
@@ -359,35 +389,144 @@ void gln64gSPProcessVertex(uint32_t v)
 			gln64gSPLightVertex(vtx);
 
       if (/* GBI.isTextureGen() && */ gSP.geometryMode & G_TEXTURE_GEN)
+         gln64gSPTexGenVertex(vtx);
+   }
+   else
+		vtx->HWLight = 0;
+}
+
+static struct vertex_batch gln64_vertex_batch;
+
+/* Same as calling gln64gSPProcessVertex on each vertex in turn, with the
+ * transform, clip codes, normals and directional lights done as a batch. */
+static void gln64gSPProcessVertexBatch(uint32_t v0, uint32_t n)
+{
+   uint32_t i;
+   struct vertex_batch *batch = &gln64_vertex_batch;
+   struct SPVertex *vtx       = (struct SPVertex*)&OGL.triangles.vertices[v0];
+
+   for (i = 0; i < n; i++)
+   {
+      batch->x[i] = vtx[i].x;
+      batch->y[i] = vtx[i].y;
+      batch->z[i] = vtx[i].z;
+   }
+
+   vertex_transform_batch(batch, n, gSP.matrix.combined);
+
+   for (i = 0; i < n; i++)
+   {
+      vtx[i].x = (gSP.viewport.vscale[0] < 0) ? -batch->x[i] : batch->x[i];
+      vtx[i].y = batch->y[i];
+      vtx[i].z = batch->z[i];
+      vtx[i].w = batch->w[i];
+   }
+
+   if (gSP.matrix.billboard)
+   {
+      for (i = 0; i < n; i++)
+         gln64gSPBillboardVertex(v0 + i, 0);
+   }
+
+   for (i = 0; i < n; i++)
+   {
+      batch->x[i] = vtx[i].x;
+      batch->y[i] = vtx[i].y;
+      batch->w[i] = vtx[i].w;
+   }
+
+   vertex_clip_batch(batch, n, 0.01f);
+
+   for (i = 0; i < n; i++)
+      vtx[i].clip = batch->clip[i];
+
+   if (!(gSP.geometryMode & G_LIGHTING))
+   {
+      for (i = 0; i < n; i++)
+         vtx[i].HWLight = 0;
+      return;
+   }
+
+   for (i = 0; i < n; i++)
+   {
+      batch->nx[i] = vtx[i].nx;
+      batch->ny[i] = vtx[i].ny;
+      batch->nz[i] = vtx[i].nz;
+   }
+
+   vertex_normal_batch(batch, n, gSP.matrix.modelView[gSP.matrix.modelViewi]);
+
+   for (i = 0; i < n; i++)
+   {
+      vtx[i].nx = batch->nx[i];
+      vtx[i].ny = batch->ny[i];
+      vtx[i].nz = batch->nz[i];
+   }
+
+   if (gSP.geometryMode & G_POINT_LIGHTING)
+   {
+      for (i = 0; i < n; i++)
       {
-			float fLightDir[3] = {vtx->nx, vtx->ny, vtx->nz};
-			float x, y;
+         float vPos[3];
+         vPos[0] = vtx[i].x;
+         vPos[1] = vtx[i].y;
+         vPos[2] = vtx[i].z;
+         gln64gSPPointLightVertex(&vtx[i], vPos);
+      }
+   }
+   else if (gln64gSPLightVertex == gln64gSPLightVertex_default
+         && !config.generalEmulation.enableHWLighting)
+   {
+      struct vertex_light lights[12];
+      const struct SPLight *ambient = &gSP.lights[gSP.numLights];
+      const float ambientColor[3]   = { ambient->r, ambient->g, ambient->b };
 
-			if (gSP.lookatEnable)
-         {
-				x = DotProduct(&gSP.lookat[0].x, fLightDir);
-				y = DotProduct(&gSP.lookat[1].x, fLightDir);
-			}
-         else
-         {
-				x = fLightDir[0];
-				y = fLightDir[1];
-			}
+      for (i = 0; i < gSP.numLights; i++)
+      {
+         lights[i].dir[0] = gSP.lights[i].x;
+         lights[i].dir[1] = gSP.lights[i].y;
+         lights[i].dir[2] = gSP.lights[i].z;
+         lights[i].col[0] = gSP.lights[i].r;
+         lights[i].col[1] = gSP.lights[i].g;
+         lights[i].col[2] = gSP.lights[i].b;
+      }
 
-         if (gSP.geometryMode & G_TEXTURE_GEN_LINEAR)
-         {
-            vtx->s = acosf(x) * 325.94931f;
-            vtx->t = acosf(y) * 325.94931f;
-         }
-         else /* G_TEXTURE_GEN */
-         {
-            vtx->s = (x + 1.0f) * 512.0f;
-            vtx->t = (y + 1.0f) * 512.0f;
-         }
+      vertex_light_batch(batch, n, lights, gSP.numLights, ambientColor);
+
+      for (i = 0; i < n; i++)
+      {
+         vtx[i].HWLight = 0;
+         vtx[i].r       = batch->r[i];
+         vtx[i].g       = batch->g[i];
+         vtx[i].b       = batch->b[i];
       }
    }
    else
-		vtx->HWLight = 0;
+   {
+      for (i = 0; i < n; i++)
+         gln64gSPLightVertex(&vtx[i]);
+   }
+
+   if (/* GBI.isTextureGen() && */ gSP.geometryMode & G_TEXTURE_GEN)
+   {
+      for (i = 0; i < n; i++)
+         gln64gSPTexGenVertex(&vtx[i]);
+   }
+}
+
+void gln64gSPProcessVertices(uint32_t v0, uint32_t n)
+{
+   if (gSP.changed & CHANGED_MATRIX)
+      gln64gSPCombineMatrices();
+
+   while (n > 0)
+   {
+      uint32_t count = MIN(n, VERTEX_BATCH_SIZE);
+
+      gln64gSPProcessVertexBatch(v0, count);
+      v0 += count;
+      n  -= count;
+   }
 }
 
 void gln64gSPLoadUcodeEx( uint32_t uc_start, uint32_t uc_dstart, uint16_t uc_dsize )
@@ -617,6 +756,65 @@ void gln64gSPLookAt( uint32_t _l, uint32_t _n )
    NormalizeVector(&gSP.lookat[_n].x);
 }
 
+/* Everything a gSPVertex load depends on besides its RDRAM range. The
+ * lighting state at the end is only part of the key with G_LIGHTING. */
+struct gln64_vertex_key
+{
+   float combined[4][4];
+   float vscale;
+   float billboard[4];
+   uint32_t v0;
+   uint32_t geometryMode;
+   uint32_t hwLighting;
+
+   float modelView[4][4];
+   uint32_t lookatEnable;
+   struct SPLight lookat[2];
+   struct SPLight lights[12];
+};
+
+/* Fills the key, returns its size in words or 0 when the load should not
+ * be memoized. */
+static unsigned gln64gSPVertexKey(struct gln64_vertex_key *key, uint32_t v0)
+{
+   uint32_t count;
+
+   if (gln64gSPLightVertex != gln64gSPLightVertex_default
+         || gln64gSPPointLightVertex != gln64gSPPointLightVertex_default
+         || gln64gSPBillboardVertex != gln64gSPBillboardVertex_default)
+      return 0;
+
+   if (gSP.changed & CHANGED_MATRIX)
+      gln64gSPCombineMatrices();
+
+   memset(key, 0, sizeof(*key));
+   memcpy(key->combined, gSP.matrix.combined, sizeof(key->combined));
+   key->vscale       = gSP.viewport.vscale[0];
+   key->v0           = v0;
+   key->geometryMode = gSP.geometryMode;
+   key->hwLighting   = config.generalEmulation.enableHWLighting;
+
+   if (gSP.matrix.billboard)
+   {
+      key->billboard[0] = OGL.triangles.vertices[0].x;
+      key->billboard[1] = OGL.triangles.vertices[0].y;
+      key->billboard[2] = OGL.triangles.vertices[0].z;
+      key->billboard[3] = OGL.triangles.vertices[0].w;
+   }
+
+   if (!(gSP.geometryMode & G_LIGHTING))
+      return offsetof(struct gln64_vertex_key, modelView) / sizeof(uint32_t);
+
+   memcpy(key->modelView, gSP.matrix.modelView[gSP.matrix.modelViewi], sizeof(key->modelView));
+   key->lookatEnable = gSP.lookatEnable;
+   memcpy(key->lookat, gSP.lookat, sizeof(key->lookat));
+
+   count = MIN((uint32_t)gSP.numLights + 1, 12);
+   memcpy(key->lights, gSP.lights, count * sizeof(struct SPLight));
+
+   return (offsetof(struct gln64_vertex_key, lights) + count * sizeof(struct SPLight)) / sizeof(uint32_t);
+}
+
 void gln64gSPVertex( uint32_t v, uint32_t n, uint32_t v0 )
 {
    unsigned int i;
@@ -630,6 +828,26 @@ void gln64gSPVertex( uint32_t v, uint32_t n, uint32_t v0 )
 
    if ((n + v0) <= INDEXMAP_SIZE)
    {
+      struct gln64_vertex_key key;
+      unsigned key_count = 0;
+
+      /* Static geometry loads the same vertices under the same state
+       * every frame, reuse what the last identical load produced */
+      if (vertex_memo_active())
+         key_count = gln64gSPVertexKey(&key, v0);
+
+      if (key_count)
+      {
+         const void *cached = vertex_memo_lookup(address, sizeof(Vertex) * n,
+               (const uint32_t*)&key, key_count, sizeof(struct SPVertex) * n);
+
+         if (cached)
+         {
+            memcpy(&OGL.triangles.vertices[v0], cached, sizeof(struct SPVertex) * n);
+            return;
+         }
+      }
+
       for (i = v0; i < n + v0; i++)
       {
          uint32_t v = i;
@@ -656,9 +874,15 @@ void gln64gSPVertex( uint32_t v, uint32_t n, uint32_t v0 )
             vtx->a = vertex->color.a * 0.0039215689f;
          }
 
-         gln64gSPProcessVertex(v);
          vertex++;
       }
+
+      gln64gSPProcessVertices(v0, n);
+
+      if (key_count)
+         vertex_memo_store(address, sizeof(Vertex) * n,
+               (const uint32_t*)&key, key_count,
+               &OGL.triangles.vertices[v0], sizeof(struct SPVertex) * n);
    }
 }
 
@@ -704,9 +928,10 @@ void gln64gSPCIVertex( uint32_t v, uint32_t n, uint32_t v0 )
             vtx->a = color[0] * 0.0039215689f;
          }
 
-         gln64gSPProcessVertex(v);
          vertex++;
       }
+
+      gln64gSPProcessVertices(v0, n);
    }
 }
 
@@ -744,9 +969,10 @@ void gln64gSPDMAVertex( uint32_t v, uint32_t n, uint32_t v0 )
             vtx->a = *(uint8_t*)&gfx_info.RDRAM[(address + 9) ^ 3] * 0.0039215689f;
          }
 
-         gln64gSPProcessVertex(v);
          address += 10;
       }
+
+      gln64gSPProcessVertices(v0, n);
    }
 }
 
@@ -784,9 +1010,10 @@ void gln64gSPCBFDVertex( uint32_t a, uint32_t n, uint32_t v0 )
 			vtx->g = vertex->color.g * 0.0039215689f;
 			vtx->b = vertex->color.b * 0.0039215689f;
 			vtx->a = vertex->color.a * 0.0039215689f;
-			gln64gSPProcessVertex(v);
 			vertex++;
 		}
+
+		gln64gSPProcessVertices(v0, n);
 	} else {
 		LOG(LOG_ERROR, "Using Vertex outside buffer v0=%i, n=%i\n", v0, n);
 	}
@@ -226,6 +226,7 @@ typedef struct {
     uint32_t  textureEnhancement;
     uint32_t  textureEnhancementControl;
     uint32_t  textureQuality;
+    uint32_t  textureCacheSize;     // In MB, 0 for no limit
     uint32_t  anisotropicFiltering;
     uint32_t  multiSampling;
     bool    bTexRectOnly;
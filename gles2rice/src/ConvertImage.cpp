@@ -21,6 +21,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "ConvertImage.h"
 #include "RenderBase.h"
 
+#include "../../Graphics/texture_decode.h"
+
 ConvertFunction     gConvertFunctions_FullTMEM[ 8 ][ 4 ] = 
 {
     // 4bpp             8bpp            16bpp               32bpp
@@ -61,67 +63,57 @@ ConvertFunction     gConvertTlutFunctions[ 8 ][ 4 ] =
 
 extern bool conkerSwapHack;
 
-void ConvertRGBA16(CTexture *pTexture, const TxtrInfo &tinfo)
+// Rows go through Graphics/texture_decode.c. Odd rows of swapped textures
+// have their 32-bit words swapped.
+static inline unsigned RowSwizzle(const TxtrInfo &tinfo, uint32_t y)
 {
-    DrawInfo dInfo;
-
-    // Copy of the base pointer
-    uint16_t * pSrc = (uint16_t*)(tinfo.pPhysicalAddress);
+    if (tinfo.bSwapped && (y & 1))
+        return TEXTURE_SWIZZLE_RDRAM | TEXTURE_SWIZZLE_ODD;
+    return TEXTURE_SWIZZLE_RDRAM;
+}
 
-    uint8_t * pByteSrc = (uint8_t *)pSrc;
-    if (!pTexture->StartUpdate(&dInfo))
+// 16-bit texels from a byte offset, which is only odd for odd pitches
+static void DecodeRow16(uint32_t *pDst, const uint8_t *pByteSrc, uint32_t dwWordOffset,
+                        uint32_t count, unsigned swizzle, bool bIA)
+{
+    if ((dwWordOffset & 1) == 0)
+    {
+        if (bIA)
+            texture_decode_ia16_32(pDst, pByteSrc, dwWordOffset >> 1, count, swizzle);
+        else
+            texture_decode_rgba16_32(pDst, pByteSrc, dwWordOffset >> 1, count, swizzle, TEXTURE_DECODE_BGRA);
         return;
+    }
 
-    uint32_t nFiddle;
-
-    if (tinfo.bSwapped)
+    for (uint32_t x = 0; x < count; x++, dwWordOffset += 2)
     {
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            if ((y&1) == 0)
-                nFiddle = 0x2;
-            else
-                nFiddle = 0x2 | 0x4;
+        uint16_t w = *(uint16_t *)&pByteSrc[dwWordOffset ^ swizzle ^ 1];
+        pDst[x] = bIA ? ConvertIA16ToRGBA(w) : Convert555ToRGBA(w);
+    }
+}
 
-            // dwDst points to start of destination row
-            uint32_t * dwDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y*dInfo.lPitch);
+// 4-bit rows are written in pairs of texels, except for a single texel
+static inline uint32_t Count4b(const TxtrInfo &tinfo)
+{
+    return tinfo.WidthToLoad == 1 ? 1 : (tinfo.WidthToLoad + 1) & ~1;
+}
 
-            // DWordOffset points to the current dword we're looking at
-            // (process 2 pixels at a time). May be a problem if we don't start on even pixel
-            uint32_t dwWordOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + (tinfo.LeftToLoad * 2);
+void ConvertRGBA16(CTexture *pTexture, const TxtrInfo &tinfo)
+{
+    DrawInfo dInfo;
 
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint16_t w = *(uint16_t *)&pByteSrc[dwWordOffset ^ nFiddle];
+    uint8_t * pByteSrc = (uint8_t *)(tinfo.pPhysicalAddress);
+    if (!pTexture->StartUpdate(&dInfo))
+        return;
 
-                dwDst[x] = Convert555ToRGBA(w);
-                
-                // Increment word offset to point to the next two pixels
-                dwWordOffset += 2;
-            }
-        }
-    }
-    else
+    for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
     {
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            // dwDst points to start of destination row
-            uint32_t * dwDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y*dInfo.lPitch);
-
-            // DWordOffset points to the current dword we're looking at
-            // (process 2 pixels at a time). May be a problem if we don't start on even pixel
-            uint32_t dwWordOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + (tinfo.LeftToLoad * 2);
+        // dwDst points to start of destination row
+        uint32_t * dwDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y*dInfo.lPitch);
 
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint16_t w = *(uint16_t *)&pByteSrc[dwWordOffset ^ 0x2];
+        uint32_t dwWordOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + (tinfo.LeftToLoad * 2);
 
-                dwDst[x] = Convert555ToRGBA(w);
-                
-                // Increment word offset to point to the next two pixels
-                dwWordOffset += 2;
-            }
-        }
+        DecodeRow16(dwDst, pByteSrc, dwWordOffset, tinfo.WidthToLoad, RowSwizzle(tinfo, y), false);
     }
 
     pTexture->EndUpdate(&dInfo);
@@ -338,7 +330,7 @@ void ConvertIA4(CTexture *pTexture, const TxtrInfo &tinfo)
 void ConvertIA8(CTexture *pTexture, const TxtrInfo &tinfo)
 {
     DrawInfo dInfo;
-    uint32_t nFiddle;
+    uint32_t lut[256];
 
     uint8_t * pSrc = (uint8_t*)(tinfo.pPhysicalAddress);
 
@@ -349,56 +341,20 @@ void ConvertIA8(CTexture *pTexture, const TxtrInfo &tinfo)
     if (!pTexture->StartUpdate(&dInfo))
         return;
 
-    if (tinfo.bSwapped)
+    for (uint32_t i = 0; i < 256; i++)
     {
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            // For odd lines, swap words too
-            if ((y%2) == 0)
-                nFiddle = 0x3;
-            else
-                nFiddle = 0x7;
-
-            uint8_t *pDst = (uint8_t *)dInfo.lpSurface + y * dInfo.lPitch;
-            // Points to current byte
-            uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
-
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint8_t b = pSrc[dwByteOffset ^ nFiddle];
-                uint8_t I = FourToEight[(b & 0xf0)>>4];
-
-                *pDst++ = I;
-                *pDst++ = I;
-                *pDst++ = I;
-                *pDst++ = FourToEight[(b & 0x0f)   ];
-
-                dwByteOffset++;
-            }
-        }
+        uint32_t I = FourToEight[i >> 4];
+        lut[i] = COLOR_RGBA(I, I, I, FourToEight[i & 0x0F]);
     }
-    else
-    {
-        const uint8_t* FourToEightArray = &FourToEight[0];
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            uint8_t *pDst = (uint8_t *)dInfo.lpSurface + y * dInfo.lPitch;
 
-            // Points to current byte
-            uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
+    for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
+    {
+        uint32_t *pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
 
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint8_t b = pSrc[(dwByteOffset++) ^ 0x3];
-                uint8_t I = *(FourToEightArray+(b>>4));
+        uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
 
-                *pDst++ = I;
-                *pDst++ = I;
-                *pDst++ = I;
-                *pDst++ = *(FourToEightArray+(b&0xF));
-            }
-        }
-    }   
+        texture_decode_lut32(pDst, pSrc, dwByteOffset, tinfo.WidthToLoad, RowSwizzle(tinfo, y), 8, lut);
+    }
     
     pTexture->EndUpdate(&dInfo);
     pTexture->SetOthersVariables();
@@ -409,71 +365,27 @@ void ConvertIA8(CTexture *pTexture, const TxtrInfo &tinfo)
 void ConvertIA16(CTexture *pTexture, const TxtrInfo &tinfo)
 {
     DrawInfo dInfo;
-    uint32_t nFiddle;
 
-    uint16_t * pSrc = (uint16_t*)(tinfo.pPhysicalAddress);
-    uint8_t * pByteSrc = (uint8_t *)pSrc;
+    uint8_t * pByteSrc = (uint8_t *)(tinfo.pPhysicalAddress);
 
     if (!pTexture->StartUpdate(&dInfo))
         return;
 
-    if (tinfo.bSwapped)
-    {
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            uint8_t *pDst = (uint8_t *)dInfo.lpSurface + y * dInfo.lPitch;
-
-            if ((y%2) == 0)
-                nFiddle = 0x2;
-            else
-                nFiddle = 0x4 | 0x2;
-
-            // Points to current word
-            uint32_t dwWordOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + (tinfo.LeftToLoad * 2);
-
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint16_t w = *(uint16_t *)&pByteSrc[dwWordOffset^nFiddle];
-
-                *pDst++ = (uint8_t)(w >> 8);
-                *pDst++ = (uint8_t)(w >> 8);
-                *pDst++ = (uint8_t)(w >> 8);
-                *pDst++ = (uint8_t)(w & 0xFF);
-
-                dwWordOffset += 2;
-            }
-        }
-    }
-    else
+    for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
     {
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            uint8_t *pDst = (uint8_t *)dInfo.lpSurface + y * dInfo.lPitch;
-
-            // Points to current word
-            uint32_t dwWordOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + (tinfo.LeftToLoad * 2);
+        uint32_t *pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
 
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint16_t w = *(uint16_t *)&pByteSrc[dwWordOffset^0x2];
+        // Points to current word
+        uint32_t dwWordOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + (tinfo.LeftToLoad * 2);
 
-                *pDst++ = (uint8_t)(w >> 8);
-                *pDst++ = (uint8_t)(w >> 8);
-                *pDst++ = (uint8_t)(w >> 8);
-                *pDst++ = (uint8_t)(w & 0xFF);
-
-                dwWordOffset += 2;
-            }
-        }       
+        DecodeRow16(pDst, pByteSrc, dwWordOffset, tinfo.WidthToLoad, RowSwizzle(tinfo, y), true);
     }
 
-
     pTexture->EndUpdate(&dInfo);
     pTexture->SetOthersVariables();
 }
 
 
-
 // Used by MarioKart
 void ConvertI4(CTexture *pTexture, const TxtrInfo &tinfo)
 {
@@ -592,58 +504,25 @@ void ConvertI4(CTexture *pTexture, const TxtrInfo &tinfo)
 void ConvertI8(CTexture *pTexture, const TxtrInfo &tinfo)
 {
     DrawInfo dInfo;
-    uint32_t nFiddle;
+    uint32_t lut[256];
+
+    // Swizzled by absolute address rather than by offset from the texture
+    uint8_t *pBase = (uint8_t*)((uintptr_t)tinfo.pPhysicalAddress & ~(uintptr_t)7);
+    uint32_t dwBaseOffset = (uint32_t)((uint8_t*)tinfo.pPhysicalAddress - pBase);
 
-    int64_t pSrc = (int64_t) tinfo.pPhysicalAddress;
     if (!pTexture->StartUpdate(&dInfo))
         return;
 
-    if (tinfo.bSwapped)
-    {
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            if ((y%2) == 0)
-                nFiddle = 0x3;
-            else
-                nFiddle = 0x7;
-
-            uint8_t *pDst = (uint8_t *)dInfo.lpSurface + y * dInfo.lPitch;
-
-            uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
+    for (uint32_t i = 0; i < 256; i++)
+        lut[i] = i * 0x01010101;        // Alpha not 255?
 
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint8_t b = *(uint8_t*)((pSrc+dwByteOffset)^nFiddle);
-
-                *pDst++ = b;
-                *pDst++ = b;
-                *pDst++ = b;
-                *pDst++ = b;        // Alpha not 255?
-
-                dwByteOffset++;
-            }
-        }
-    }
-    else
+    for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
     {
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            uint8_t *pDst = (uint8_t *)dInfo.lpSurface + y * dInfo.lPitch;
-
-            uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
-
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint8_t b = *(uint8_t*)((pSrc+dwByteOffset)^0x3);
+        uint32_t *pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
 
-                *pDst++ = b;
-                *pDst++ = b;
-                *pDst++ = b;
-                *pDst++ = b;        // Alpha not 255?
+        uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
 
-                dwByteOffset++;
-            }
-        }
+        texture_decode_lut32(pDst, pBase, dwBaseOffset + dwByteOffset, tinfo.WidthToLoad, RowSwizzle(tinfo, y), 8, lut);
     }
 
     pTexture->EndUpdate(&dInfo);
@@ -685,104 +564,29 @@ void ConvertCI8( CTexture * p_texture, const TxtrInfo & tinfo )
 void ConvertCI4_RGBA16(CTexture *pTexture, const TxtrInfo &tinfo)
 {
     DrawInfo dInfo;
-    uint32_t nFiddle;
+    uint32_t lut[16];
 
     uint8_t * pSrc = (uint8_t*)(tinfo.pPhysicalAddress);
     uint16_t * pPal = (uint16_t *)tinfo.PalAddress;
     bool bIgnoreAlpha = (tinfo.TLutFmt==TLUT_FMT_NONE);
-    
+
     if (!pTexture->StartUpdate(&dInfo))
         return;
 
-    if (tinfo.bSwapped)
-    {
-        for (uint32_t y = 0; y <  tinfo.HeightToLoad; y++)
-        {
-            if ((y%2) == 0)
-                nFiddle = 0x3;
-            else
-                nFiddle = 0x7;
-
-            uint32_t * pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
-
-            uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch);
+    // Remember palette is in different endian order!
+    for (uint32_t i = 0; i < 16; i++)
+        lut[i] = Convert555ToRGBA(pPal[i^1]) | (bIgnoreAlpha ? 0xFF000000 : 0);
 
-            if (tinfo.WidthToLoad == 1)
-            {
-                // corner case
-                uint8_t b = pSrc[dwByteOffset ^ nFiddle];
-                uint8_t bhi = (b&0xf0)>>4;
-                *pDst = Convert555ToRGBA(pPal[bhi^1]);    // Remember palette is in different endian order!
-                if( bIgnoreAlpha )
-                {
-                    *pDst |= 0xFF000000;
-                }
-            }
-            else for (uint32_t x = 0; x < tinfo.WidthToLoad; x+=2)
-            {
-                // two at a time
-                uint8_t b = pSrc[dwByteOffset ^ nFiddle];
-
-                uint8_t bhi = (b&0xf0)>>4;
-                uint8_t blo = (b&0x0f);
-
-                pDst[0] = Convert555ToRGBA(pPal[bhi^1]);    // Remember palette is in different endian order!
-                pDst[1] = Convert555ToRGBA(pPal[blo^1]);    // Remember palette is in different endian order!
-
-                if( bIgnoreAlpha )
-                {
-                    pDst[0] |= 0xFF000000;
-                    pDst[1] |= 0xFF000000;
-                }
-
-                pDst+=2;
-
-                dwByteOffset++;
-            }
-        }
-    }
-    else
+    for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
     {
-        for (uint32_t y = 0; y <  tinfo.HeightToLoad; y++)
-        {
-            uint32_t * pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
-
-            uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + (tinfo.LeftToLoad / 2);
-
-            if (tinfo.WidthToLoad == 1)
-            {
-                // corner case
-                uint8_t b = pSrc[dwByteOffset ^ 0x3];
-                uint8_t bhi = (b&0xf0)>>4;
-                *pDst = Convert555ToRGBA(pPal[bhi^1]);    // Remember palette is in different endian order!
-                if( bIgnoreAlpha )
-                {
-                    *pDst |= 0xFF000000;
-                }
-            }
-            else for (uint32_t x = 0; x < tinfo.WidthToLoad; x+=2)
-            {
-                // two at a time
-                uint8_t b = pSrc[dwByteOffset ^ 0x3];
-
-                uint8_t bhi = (b&0xf0)>>4;
-                uint8_t blo = (b&0x0f);
-
-                pDst[0] = Convert555ToRGBA(pPal[bhi^1]);    // Remember palette is in different endian order!
-                pDst[1] = Convert555ToRGBA(pPal[blo^1]);    // Remember palette is in different endian order!
-                
-                if( bIgnoreAlpha )
-                {
-                    pDst[0] |= 0xFF000000;
-                    pDst[1] |= 0xFF000000;
-                }
+        uint32_t * pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
 
-                pDst+=2;
+        // Swapped rows have always started at the first texel here
+        uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + (tinfo.bSwapped ? 0 : tinfo.LeftToLoad / 2);
 
-                dwByteOffset++;
-            }
-        }
+        texture_decode_lut32(pDst, pSrc, dwByteOffset << 1, Count4b(tinfo), RowSwizzle(tinfo, y), 4, lut);
     }
+
     pTexture->EndUpdate(&dInfo);
     pTexture->SetOthersVariables();
 }
@@ -791,105 +595,28 @@ void ConvertCI4_RGBA16(CTexture *pTexture, const TxtrInfo &tinfo)
 void ConvertCI4_IA16(CTexture *pTexture, const TxtrInfo &tinfo)
 {
     DrawInfo dInfo;
-    uint32_t nFiddle;
+    uint32_t lut[16];
 
     uint8_t * pSrc = (uint8_t*)(tinfo.pPhysicalAddress);
-
-#ifdef DEBUGGER
-    if (((int64_t) pSrc) % 4) TRACE0("Texture src addr is not aligned to 4 bytes, check me");
-#endif
-
     uint16_t * pPal = (uint16_t *)tinfo.PalAddress;
     bool bIgnoreAlpha = (tinfo.TLutFmt==TLUT_FMT_UNKNOWN);
 
     if (!pTexture->StartUpdate(&dInfo))
         return;
 
-    if (tinfo.bSwapped)
-    {
-        for (uint32_t y = 0; y <  tinfo.HeightToLoad; y++)
-        {
-            if ((y%2) == 0)
-                nFiddle = 0x3;
-            else
-                nFiddle = 0x7;
-
-            uint32_t * pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
+    // Remember palette is in different endian order!
+    for (uint32_t i = 0; i < 16; i++)
+        lut[i] = ConvertIA16ToRGBA(pPal[i^1]) | (bIgnoreAlpha ? 0xFF000000 : 0);
 
-            uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + (tinfo.LeftToLoad / 2);
-
-            if (tinfo.WidthToLoad == 1)
-            {
-                // corner case
-                uint8_t b = pSrc[dwByteOffset ^ nFiddle];
-                uint8_t bhi = (b&0xf0)>>4;
-                *pDst = ConvertIA16ToRGBA(pPal[bhi^1]);   // Remember palette is in different endian order!
-                if( bIgnoreAlpha )
-                    *pDst |= 0xFF000000;
-            }
-            else for (uint32_t x = 0; x < tinfo.WidthToLoad; x+=2)
-            {
-                // two at a time
-                uint8_t b = pSrc[dwByteOffset ^ nFiddle];
-
-                uint8_t bhi = (b&0xf0)>>4;
-                uint8_t blo = (b&0x0f);
-
-                pDst[0] = ConvertIA16ToRGBA(pPal[bhi^1]);   // Remember palette is in different endian order!
-                pDst[1] = ConvertIA16ToRGBA(pPal[blo^1]);   // Remember palette is in different endian order!
-                
-                if( bIgnoreAlpha )
-                {
-                    pDst[0] |= 0xFF000000;
-                    pDst[1] |= 0xFF000000;
-                }
-
-                pDst+=2;
-
-                dwByteOffset++;
-            }
-        }
-    }
-    else
+    for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
     {
-        for (uint32_t y = 0; y <  tinfo.HeightToLoad; y++)
-        {
-            uint32_t * pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
-
-            uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + (tinfo.LeftToLoad / 2);
-
-            if (tinfo.WidthToLoad == 1)
-            {
-                // corner case
-                uint8_t b = pSrc[dwByteOffset ^ 0x3];
-                uint8_t bhi = (b&0xf0)>>4;
-                *pDst = ConvertIA16ToRGBA(pPal[bhi^1]);   // Remember palette is in different endian order!
-                if( bIgnoreAlpha )
-                    *pDst |= 0xFF000000;
-            }
-            else for (uint32_t x = 0; x < tinfo.WidthToLoad; x+=2)
-            {
-                // two pixels at a time
-                uint8_t b = pSrc[dwByteOffset ^ 0x3];
-
-                uint8_t bhi = (b&0xf0)>>4;
-                uint8_t blo = (b&0x0f);
-
-                pDst[0] = ConvertIA16ToRGBA(pPal[bhi^1]);   // Remember palette is in different endian order!
-                pDst[1] = ConvertIA16ToRGBA(pPal[blo^1]);   // Remember palette is in different endian order!
-                
-                if( bIgnoreAlpha )
-                {
-                    pDst[0] |= 0xFF000000;
-                    pDst[1] |= 0xFF000000;
-                }
+        uint32_t * pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
 
-                pDst+=2;
+        uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + (tinfo.LeftToLoad / 2);
 
-                dwByteOffset++;
-            }
-        }
+        texture_decode_lut32(pDst, pSrc, dwByteOffset << 1, Count4b(tinfo), RowSwizzle(tinfo, y), 4, lut);
     }
+
     pTexture->EndUpdate(&dInfo);
     pTexture->SetOthersVariables();
 }
@@ -899,74 +626,30 @@ void ConvertCI4_IA16(CTexture *pTexture, const TxtrInfo &tinfo)
 void ConvertCI8_RGBA16(CTexture *pTexture, const TxtrInfo &tinfo)
 {
     DrawInfo dInfo;
-    uint32_t nFiddle;
+    uint32_t lut[256];
 
     uint8_t * pSrc = (uint8_t*)(tinfo.pPhysicalAddress);
-
-#ifdef DEBUGGER
-    if (((int64_t) pSrc) % 4) TRACE0("Texture src addr is not aligned to 4 bytes, check me");
-#endif
-
     uint16_t * pPal = (uint16_t *)tinfo.PalAddress;
     bool bIgnoreAlpha = (tinfo.TLutFmt==TLUT_FMT_NONE);
 
     if (!pTexture->StartUpdate(&dInfo))
         return;
-    
-    if (tinfo.bSwapped)
-    {
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            if ((y%2) == 0)
-                nFiddle = 0x3;
-            else
-                nFiddle = 0x7;
-
-            uint32_t *pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
-
-            uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
-            
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint8_t b = pSrc[dwByteOffset ^ nFiddle];
 
-                *pDst++ = Convert555ToRGBA(pPal[b^1]);  // Remember palette is in different endian order!
-                
-                if( bIgnoreAlpha )
-                {
-                    *(pDst-1) |= 0xFF000000;
-                }
+    // Remember palette is in different endian order!
+    for (uint32_t i = 0; i < 256; i++)
+        lut[i] = Convert555ToRGBA(pPal[i^1]) | (bIgnoreAlpha ? 0xFF000000 : 0);
 
-                dwByteOffset++;
-            }
-        }
-    }
-    else
+    for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
     {
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            uint32_t *pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
-
-            int dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
-            
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint8_t b = pSrc[dwByteOffset ^ 0x3];
+        uint32_t * pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
 
-                *pDst++ = Convert555ToRGBA(pPal[b^1]);  // Remember palette is in different endian order!
-                if( bIgnoreAlpha )
-                {
-                    *(pDst-1) |= 0xFF000000;
-                }
+        uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
 
-                dwByteOffset++;
-            }
-        }
+        texture_decode_lut32(pDst, pSrc, dwByteOffset, tinfo.WidthToLoad, RowSwizzle(tinfo, y), 8, lut);
     }
 
     pTexture->EndUpdate(&dInfo);
     pTexture->SetOthersVariables();
-
 }
 
 
@@ -974,68 +657,26 @@ void ConvertCI8_RGBA16(CTexture *pTexture, const TxtrInfo &tinfo)
 void ConvertCI8_IA16(CTexture *pTexture, const TxtrInfo &tinfo)
 {
     DrawInfo dInfo;
-    uint32_t nFiddle;
+    uint32_t lut[256];
 
     uint8_t * pSrc = (uint8_t*)(tinfo.pPhysicalAddress);
-
-#ifdef DEBUGGER
-    if (((int64_t) pSrc) % 4) TRACE0("Texture src addr is not aligned to 4 bytes, check me");
-#endif
-
     uint16_t * pPal = (uint16_t *)tinfo.PalAddress;
     bool bIgnoreAlpha = (tinfo.TLutFmt==TLUT_FMT_UNKNOWN);
 
     if (!pTexture->StartUpdate(&dInfo))
         return;
 
-    if (tinfo.bSwapped)
-    {
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            if ((y%2) == 0)
-                nFiddle = 0x3;
-            else
-                nFiddle = 0x7;
-
-            uint32_t *pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
-
-            uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
-            
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint8_t b = pSrc[dwByteOffset ^ nFiddle];
-
-                *pDst++ = ConvertIA16ToRGBA(pPal[b^1]); // Remember palette is in different endian order!
-                if( bIgnoreAlpha )
-                {
-                    *(pDst-1) |= 0xFF000000;
-                }
+    // Remember palette is in different endian order!
+    for (uint32_t i = 0; i < 256; i++)
+        lut[i] = ConvertIA16ToRGBA(pPal[i^1]) | (bIgnoreAlpha ? 0xFF000000 : 0);
 
-                dwByteOffset++;
-            }
-        }
-    }
-    else
+    for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
     {
-        for (uint32_t y = 0; y < tinfo.HeightToLoad; y++)
-        {
-            uint32_t *pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
-
-            uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
-            
-            for (uint32_t x = 0; x < tinfo.WidthToLoad; x++)
-            {
-                uint8_t b = pSrc[dwByteOffset ^ 0x3];
+        uint32_t * pDst = (uint32_t *)((uint8_t *)dInfo.lpSurface + y * dInfo.lPitch);
 
-                *pDst++ = ConvertIA16ToRGBA(pPal[b^1]); // Remember palette is in different endian order!
-                if( bIgnoreAlpha )
-                {
-                    *(pDst-1) |= 0xFF000000;
-                }
+        uint32_t dwByteOffset = ((y+tinfo.TopToLoad) * tinfo.Pitch) + tinfo.LeftToLoad;
 
-                dwByteOffset++;
-            }
-        }
+        texture_decode_lut32(pDst, pSrc, dwByteOffset, tinfo.WidthToLoad, RowSwizzle(tinfo, y), 8, lut);
     }
 
     pTexture->EndUpdate(&dInfo);
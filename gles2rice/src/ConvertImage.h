@@ -227,8 +227,6 @@ uint32_t ConvertYUV16ToR8G8B8(int Y, int U, int V);
 uint16_t ConvertYUV16ToR4G4B4(int Y, int U, int V);
 
 
-typedef void    ( * ConvertFunction )( CTexture * p_texture, const TxtrInfo & ti );
-
 void ConvertRGBA16(CTexture *pTexture, const TxtrInfo &tinfo);
 void ConvertRGBA32(CTexture *pTexture, const TxtrInfo &tinfo);
 
@@ -29,8 +29,11 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "UcodeDefs.h"
 #include "RSP_Parser.h"
 #include "Render.h"
+#include "TextureDecoder.h"
 
+#include "../../Graphics/RDP/rdram_gen.h"
 #include "../../Graphics/RSP/RSP_state.h"
+#include "../../Graphics/texture_hash.h"
 
 extern TMEMLoadMapInfo g_tmemLoadAddrMap[0x200];    // Totally 4KB TMEM;
 
@@ -481,6 +484,9 @@ void TexRectToFrameBuffer_8b(uint32_t dwXL, uint32_t dwYL, uint32_t dwXH, uint32
     if (maxH <= dwTop)
         return;
 
+    TextureDecoderWaitAll();
+    rdram_gen_mark(g_pRenderTextureInfo->CI_Info.dwAddr, maxOff + 4);
+
     for (uint32_t y = 0; y < dwHeight; y++)
     {
         uint32_t dwByteOffset = (uint32_t)(((y*yScale+dwSrcOffY) * dwSrcPitch) + dwSrcOffX);
@@ -506,6 +512,8 @@ void TexRectToN64FrameBuffer_16b(uint32_t x0, uint32_t y0, uint32_t width, uint3
 {
     // Copy the framebuffer texture into the N64 RDRAM framebuffer memory structure
 
+    TextureDecoderWaitAll();
+
     DrawInfo srcInfo;   
     if (g_textures[dwTile].m_pCTexture->StartUpdate(&srcInfo) == false)
     {
@@ -516,6 +524,8 @@ void TexRectToN64FrameBuffer_16b(uint32_t x0, uint32_t y0, uint32_t width, uint3
     uint32_t n64CIaddr = g_CI.dwAddr;
     uint32_t n64CIwidth = g_CI.dwWidth;
 
+    rdram_gen_mark(n64CIaddr&(g_dwRamSize-1), (y0+height)*n64CIwidth*2);
+
     for (uint32_t y = 0; y < height; y++)
     {
        uint8_t *rdram_u8 = (uint8_t*)gfx_info.RDRAM;
@@ -540,10 +550,10 @@ void TexRectToN64FrameBuffer_16b(uint32_t x0, uint32_t y0, uint32_t width, uint3
 extern uint32_t dwAsmHeight;
 extern uint32_t dwAsmPitch;
 extern uint32_t dwAsmdwBytesPerLine;
-extern uint32_t dwAsmCRC;
+extern uint64_t dwAsmCRC;
 extern uint8_t* pAsmStart;
 
-uint32_t CalculateRDRAMCRC(void *pPhysicalAddress, uint32_t left, uint32_t top, uint32_t width, uint32_t height, uint32_t size, uint32_t pitchInBytes )
+uint64_t CalculateRDRAMCRC(void *pPhysicalAddress, uint32_t left, uint32_t top, uint32_t width, uint32_t height, uint32_t size, uint32_t pitchInBytes )
 {
     dwAsmCRC = 0;
     dwAsmdwBytesPerLine = ((width<<size)+1)/2;
@@ -569,57 +579,34 @@ uint32_t CalculateRDRAMCRC(void *pPhysicalAddress, uint32_t left, uint32_t top,
 
         // The original assembly code had a bug in it (it incremented pStart by 'pitch' in bytes, not in dwords)
         // This C code implements the same algorithm as the ASM but without the bug
+        uint32_t crc = 0;
         uint32_t y = 0;
         while (y < height)
         {
             uint32_t x = 0;
             while (x < realWidthInDWORD)
             {
-                dwAsmCRC = (dwAsmCRC << 4) + ((dwAsmCRC >> 28) & 15);
-                dwAsmCRC += pStart[x];
+                crc = (crc << 4) + ((crc >> 28) & 15);
+                crc += pStart[x];
                 x += xinc;
-                dwAsmCRC += x;
+                crc += x;
             }
-            dwAsmCRC ^= y;
+            crc ^= y;
             y += yinc;
             pStart += pitch;
         }
+        dwAsmCRC = crc;
     }
     else
     {
-       dwAsmdwBytesPerLine = ((width<<size)+1)/2;
-
+       // Full check: hash every row of the texture
        pAsmStart = (uint8_t*)(pPhysicalAddress);
        pAsmStart += (top * pitchInBytes) + (((left<<size)+1)>>1);
 
        dwAsmHeight = height - 1;
        dwAsmPitch = pitchInBytes;
 
-       uint32_t pitch = pitchInBytes>>2;
-       uint32_t* pStart = (uint32_t*)pPhysicalAddress;
-       pStart += (top * pitch) + (((left<<size)+1)>>3);
-
-       int y = dwAsmHeight;
-
-       while (y >= 0)
-       {
-          uint32_t esi = 0;
-          int x = dwAsmdwBytesPerLine - 4;
-          while (x >= 0)
-          {
-             esi = *(uint32_t*)(pAsmStart + x);
-             esi ^= x;
-
-             dwAsmCRC = (dwAsmCRC << 4) + ((dwAsmCRC >> 28) & 15);
-             dwAsmCRC += esi;
-             x-=4;
-          }
-          esi ^= y;
-          dwAsmCRC += esi;
-          pAsmStart += dwAsmPitch;
-          y--;
-       }
-
+       dwAsmCRC = texture_hash_rows(0, pAsmStart, dwAsmdwBytesPerLine, height, (ptrdiff_t)pitchInBytes);
     }
     return dwAsmCRC;
 }
@@ -674,7 +661,7 @@ bool FrameBufferManager::FrameBufferInRDRAMCheckCRC()
     RecentCIInfo &p = *(g_uRecentCIInfoPtrs[0]);
     uint8_t *pFrameBufferBase = (uint8_t*)(rdram_u8 + p.dwAddr);
     uint32_t pitch = (p.dwWidth << p.dwSize ) >> 1;
-    uint32_t crc = CalculateRDRAMCRC(pFrameBufferBase, 0, 0, p.dwWidth, p.dwHeight, p.dwSize, pitch);
+    uint64_t crc = CalculateRDRAMCRC(pFrameBufferBase, 0, 0, p.dwWidth, p.dwHeight, p.dwSize, pitch);
     if (crc != p.dwCRC)
     {
         p.dwCRC = crc;
@@ -1245,6 +1232,8 @@ void FrameBufferManager::CloseRenderTexture(bool toSave)
 
 void FrameBufferManager::ClearN64FrameBufferToBlack(uint32_t left, uint32_t top, uint32_t width, uint32_t height)
 {
+    TextureDecoderWaitAll();
+
    uint8_t *rdram_u8 = (uint8_t*)gfx_info.RDRAM;
     RecentCIInfo &p = *(g_uRecentCIInfoPtrs[0]);
     uint16_t *frameBufferBase = (uint16_t*)(rdram_u8 + p.dwAddr);
@@ -1258,9 +1247,11 @@ void FrameBufferManager::ClearN64FrameBufferToBlack(uint32_t left, uint32_t top,
             len = (p.dwHeight*p.dwWidth)>>1;
 
         memset(frameBufferBase, 0, len);
+        rdram_gen_mark(p.dwAddr, len);
     }
     else
     {
+        rdram_gen_mark(p.dwAddr, (top+height)*pitch*2);
         for (uint32_t y=0; y<height; y++)
         {
             for (uint32_t x=0; x<width; x++)
@@ -1318,7 +1309,7 @@ void FrameBufferManager::CheckRenderTextureCRCInRDRAM(void)
 
         if (gRenderTextureInfos[i].crcCheckedAtFrame < status.gDlistCount)
         {
-            uint32_t crc = ComputeRenderTextureCRCInRDRAM(i);
+            uint64_t crc = ComputeRenderTextureCRCInRDRAM(i);
             if (gRenderTextureInfos[i].crcInRDRAM != crc)
             {
                 // RDRAM has been modified by CPU core
@@ -1358,11 +1349,11 @@ int FrameBufferManager::CheckAddrInRenderTextures(uint32_t addr, bool checkcrc)
                 // Check the CRC in RDRAM
                 if( gRenderTextureInfos[i].crcCheckedAtFrame < status.gDlistCount )
                 {
-                    uint32_t crc = ComputeRenderTextureCRCInRDRAM(i);
+                    uint64_t crc = ComputeRenderTextureCRCInRDRAM(i);
                     if (gRenderTextureInfos[i].crcInRDRAM != crc)
                     {
                         // RDRAM has been modified by CPU core
-                        TRACE3("Buffer %d CRC in RDRAM changed from %08X to %08X", i, gRenderTextureInfos[i].crcInRDRAM, crc );
+                        TRACE3("Buffer %d CRC in RDRAM changed from %016llX to %016llX", i, (unsigned long long)gRenderTextureInfos[i].crcInRDRAM, (unsigned long long)crc );
                         TXTRBUF_DUMP(TRACE2("Delete texture buffer %d at %08X, crcInRDRAM failed.", i, gRenderTextureInfos[i].CI_Info.dwAddr ));
 
                         if (gRenderTextureInfos[i].pRenderTexture)
@@ -1422,7 +1413,7 @@ void FrameBufferManager::RestoreNormalBackBuffer()
     }
 }
 
-uint32_t FrameBufferManager::ComputeRenderTextureCRCInRDRAM(int infoIdx)
+uint64_t FrameBufferManager::ComputeRenderTextureCRCInRDRAM(int infoIdx)
 {
     if (infoIdx >= numOfTxtBufInfos || infoIdx < 0 || !gRenderTextureInfos[infoIdx].isUsed)
         return 0;
@@ -1724,6 +1715,9 @@ void FrameBufferManager::CopyBufferToRDRAM(uint32_t addr, uint32_t fmt, uint32_t
         TXTRBUF_DUMP(DebuggerAppendMsg("Start at: 0x%X, from line %d to %d", startaddr-addr, startline, endline););
     }
 
+    TextureDecoderWaitAll();
+    rdram_gen_mark(addr, endline * MAX(pitch, width) * 2);
+
     int indexes[600];
     {
         float ratio = bufWidth/(float)width;
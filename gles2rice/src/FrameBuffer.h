@@ -47,7 +47,7 @@ public:
     bool IsDIaRenderTexture();
 
     int         CheckAddrInRenderTextures(uint32_t addr, bool checkcrc);
-    uint32_t      ComputeRenderTextureCRCInRDRAM(int infoIdx);
+    uint64_t      ComputeRenderTextureCRCInRDRAM(int infoIdx);
     void        CheckRenderTextureCRCInRDRAM(void);
     int         CheckRenderTexturesWithNewCI(SetImgInfo &CIinfo, uint32_t height, bool byNewTxtrBuf);
     virtual void ClearN64FrameBufferToBlack(uint32_t left, uint32_t top, uint32_t width, uint32_t height);
@@ -143,7 +143,7 @@ extern int numOfTxtBufInfos;
 extern RecentCIInfo *g_uRecentCIInfoPtrs[5];
 extern uint8_t RevTlutTable[0x10000];
 
-extern uint32_t CalculateRDRAMCRC(void *pAddr, uint32_t left, uint32_t top, uint32_t width, uint32_t height, uint32_t size, uint32_t pitchInBytes);
+extern uint64_t CalculateRDRAMCRC(void *pAddr, uint32_t left, uint32_t top, uint32_t width, uint32_t height, uint32_t size, uint32_t pitchInBytes);
 extern uint16_t ConvertRGBATo555(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 extern uint16_t ConvertRGBATo555(uint32_t color32);
 extern void InitTlutReverseLookup(void);
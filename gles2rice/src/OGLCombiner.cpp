@@ -91,7 +91,7 @@ void COGLColorCombiner::DisableCombiner(void)
         if( pTexture ) 
         {
             m_pOGLRender->EnableTexUnit(0, true);
-            m_pOGLRender->BindTexture(pTexture->m_dwTextureName, 0);
+            m_pOGLRender->BindTexture(pTexture, 0);
             glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
             m_pOGLRender->SetAllTexelRepeatFlag();
         }
@@ -110,7 +110,7 @@ void COGLColorCombiner::InitCombinerCycleCopy(void)
     COGLTexture* pTexture = g_textures[gRSP.curTile].m_pCOGLTexture;
     if( pTexture )
     {
-        m_pOGLRender->BindTexture(pTexture->m_dwTextureName, 0);
+        m_pOGLRender->BindTexture(pTexture, 0);
         m_pOGLRender->SetTexelRepeatFlags(gRSP.curTile);
     }
 
@@ -169,6 +169,7 @@ void COGLColorCombiner::InitCombinerBlenderForSimpleTextureDraw(uint32_t tile)
     if( g_textures[tile].m_pCTexture )
     {
         m_pOGLRender->EnableTexUnit(0, true);
+        g_textures[tile].m_pCTexture->FlushUpload();
         glBindTexture(GL_TEXTURE_2D, ((COGLTexture*)(g_textures[tile].m_pCTexture))->m_dwTextureName);
     }
     m_pOGLRender->SetAllTexelRepeatFlag();
@@ -330,7 +330,7 @@ void COGL_FragmentProgramCombiner::InitCombinerCycleCopy(void)
     COGLTexture* pTexture = g_textures[gRSP.curTile].m_pCOGLTexture;
     if( pTexture )
     {
-        m_pOGLRender->BindTexture(pTexture->m_dwTextureName, 0);
+        m_pOGLRender->BindTexture(pTexture, 0);
         m_pOGLRender->SetTexelRepeatFlags(gRSP.curTile);
     }
 }
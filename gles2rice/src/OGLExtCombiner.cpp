@@ -336,12 +336,12 @@ void COGLColorCombiner4::GenerateCombinerSetting(int index)
         if( m_bTex0Enabled || gRDP.otherMode.cycle_type  == G_CYC_COPY )
         {
             pTexture = g_textures[gRSP.curTile].m_pCOGLTexture;
-            if( pTexture )  m_pOGLRender->BindTexture(pTexture->m_dwTextureName, 0);
+            if( pTexture )  m_pOGLRender->BindTexture(pTexture, 0);
         }
         if( m_bTex1Enabled )
         {
             pTexture1 = g_textures[(gRSP.curTile+1)&7].m_pCOGLTexture;
-            if( pTexture1 ) m_pOGLRender->BindTexture(pTexture1->m_dwTextureName, 1);
+            if( pTexture1 ) m_pOGLRender->BindTexture(pTexture1, 1);
         }
     }
 
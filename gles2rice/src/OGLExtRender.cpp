@@ -135,7 +135,7 @@ void COGLExtRender::SetTextureUFlag(TextureUVFlag dwFlag, uint32_t dwTile)
             if( pTexture ) 
             {
                 EnableTexUnit(textureNo, true);
-                BindTexture(pTexture->m_dwTextureName, textureNo);
+                BindTexture(pTexture, textureNo);
             }
             SetTexWrapS(textureNo, OGLXUVFlagMaps[dwFlag].realFlag);
         }
@@ -176,7 +176,7 @@ void COGLExtRender::SetTextureVFlag(TextureUVFlag dwFlag, uint32_t dwTile)
             if( pTexture )
             {
                 EnableTexUnit(textureNo, true);
-                BindTexture(pTexture->m_dwTextureName, textureNo);
+                BindTexture(pTexture, textureNo);
             }
             SetTexWrapT(textureNo, OGLXUVFlagMaps[dwFlag].realFlag);
         }
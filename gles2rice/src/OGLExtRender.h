@@ -25,6 +25,7 @@ class COGLExtRender : public OGLRender
 {
 public:
     void Initialize(void);
+    using OGLRender::BindTexture;
     void BindTexture(GLuint texture, int unitno);
     void DisBindTexture(GLuint texture, int unitno);
     void TexCoord2f(float u, float v);
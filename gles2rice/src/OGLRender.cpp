@@ -360,7 +360,7 @@ void OGLRender::SetTextureUFlag(TextureUVFlag dwFlag, uint32_t dwTile)
         if( pTexture )
         {
             EnableTexUnit(0, true);
-            BindTexture(pTexture->m_dwTextureName, 0);
+            BindTexture(pTexture, 0);
         }
         SetTexWrapS(0, OGLXUVFlagMaps[dwFlag].realFlag);
     }
@@ -374,7 +374,7 @@ void OGLRender::SetTextureVFlag(TextureUVFlag dwFlag, uint32_t dwTile)
         if( pTexture ) 
         {
             EnableTexUnit(0, true);
-            BindTexture(pTexture->m_dwTextureName, 0);
+            BindTexture(pTexture, 0);
         }
         SetTexWrapT(0, OGLXUVFlagMaps[dwFlag].realFlag);
     }
@@ -703,6 +703,17 @@ void OGLRender::BindTexture(GLuint texture, int unitno)
     }
 }
 
+// Uploads a texture whose decode was queued before binding it. Upload()
+// binds the texture to whichever unit is active, so the bindings tracked in
+// m_curBoundTex are forgotten.
+void OGLRender::BindTexture(COGLTexture *pTexture, int unitno)
+{
+    if (pTexture->FlushUpload())
+        memset(m_curBoundTex, 0, sizeof(m_curBoundTex));
+
+    BindTexture(pTexture->m_dwTextureName, unitno);
+}
+
 void OGLRender::DisBindTexture(GLuint texture, int unitno)
 {
     //EnableTexUnit(0, false);
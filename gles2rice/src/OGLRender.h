@@ -66,6 +66,7 @@ public:
     void SetTextureUFlag(TextureUVFlag dwFlag, uint32_t tile);
     void SetTextureVFlag(TextureUVFlag dwFlag, uint32_t tile);
     virtual void BindTexture(GLuint texture, int unitno);
+    void BindTexture(COGLTexture *pTexture, int unitno);
     virtual void DisBindTexture(GLuint texture, int unitno);
     virtual void TexCoord2f(float u, float v);
     virtual void TexCoord(TLITVERTEX &vtxInfo);
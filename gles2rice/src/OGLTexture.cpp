@@ -94,13 +94,37 @@ bool COGLTexture::StartUpdate(DrawInfo *di)
 
 void COGLTexture::EndUpdate(DrawInfo *di)
 {
-    COGLGraphicsContext *pcontext = (COGLGraphicsContext *)(CGraphicsContext::g_pGraphicsContext); // we need this to check if the GL extension is available
+    if (m_bDeferUpload)
+    {
+        m_bUploadPending = true;
+        return;
+    }
+
+    Upload();
+}
+
+// The internal format decides the size, plus a third for the mipmap chain
+uint32_t COGLTexture::GetDeviceSize(void)
+{
+    uint32_t size = m_dwCreatedTextureWidth * m_dwCreatedTextureHeight * (m_glFmt == GL_RGBA4 ? 2 : 4);
+
+    if (options.mipmapping)
+        size += size / 3;
+
+    return size;
+}
 
+void COGLTexture::Upload(void)
+{
     glBindTexture(GL_TEXTURE_2D, m_dwTextureName);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    // Mipmap support
+    // Copy the image data from main memory to video card texture memory
+    //GL_BGRA_IMG works on Adreno but not inside profiler.
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_dwCreatedTextureWidth, m_dwCreatedTextureHeight, GL_RGBA, GL_UNSIGNED_BYTE, m_pTexture);
+
+    // Mipmap support, built from the image just uploaded
     if(options.mipmapping)
     {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
@@ -110,10 +134,6 @@ void COGLTexture::EndUpdate(DrawInfo *di)
     {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     }
-
-    // Copy the image data from main memory to video card texture memory
-    //GL_BGRA_IMG works on Adreno but not inside profiler.
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_dwCreatedTextureWidth, m_dwCreatedTextureHeight, GL_RGBA, GL_UNSIGNED_BYTE, m_pTexture);
 }
 
 
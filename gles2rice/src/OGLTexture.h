@@ -31,12 +31,15 @@ public:
 
     bool StartUpdate(DrawInfo *di);
     void EndUpdate(DrawInfo *di);
+    uint32_t GetDeviceSize(void);
 
     GLuint m_dwTextureName;
     GLuint m_glFmt;
 protected:
     friend class OGLDeviceBuilder;
     COGLTexture(uint32_t dwWidth, uint32_t dwHeight, TextureUsage usage);
+
+    void Upload(void);
 };
 
 
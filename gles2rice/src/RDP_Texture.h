@@ -681,8 +681,9 @@ TxtrCacheEntry* LoadTexture(uint32_t tileno)
         status.UseLargerTile[idx]=true;
     }
 
-    // Loading the textures by using texture cache manager
-    return gTextureManager.GetTexture(&gti, true, true, true);  // Load the texture by using texture cache
+    // Loading the textures by using texture cache manager, the decode may
+    // finish on a worker until the texture is bound
+    return gTextureManager.GetTexture(&gti, true, true, true, true);  // Load the texture by using texture cache
 }
 
 void PrepareTextures()
@@ -30,6 +30,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "GraphicsContext.h"
 #include "Render.h"
 #include "RenderTexture.h"
+#include "TextureDecoder.h"
 #include "Video.h"
 #include "ucode.h"
 
@@ -779,6 +780,9 @@ void DLParser_Process(OSTask * pTask)
 
     CRender::g_pRender->EndRendering();
 
+    // The CPU runs next and may write the RDRAM a queued decode reads
+    TextureDecoderWaitAll();
+
     if( gRSP.ucode >= 17)
         TriggerDPInterrupt();
     TriggerSPInterrupt();
@@ -1296,6 +1300,8 @@ void RDP_DLParser_Process(void)
     }
 
     CRender::g_pRender->EndRendering();
+
+    TextureDecoderWaitAll();
 }
 
 void RDP_TriFill(Gfx *gfx)
@@ -42,7 +42,7 @@ typedef struct {
     bool        isUsed;
     uint32_t      knownHeight;
 
-    uint32_t      crcInRDRAM;
+    uint64_t      crcInRDRAM;
     uint32_t      crcCheckedAtFrame;
 
     TxtrCacheEntry txtEntry;
@@ -17,6 +17,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 */
 
+#include "TextureDecoder.h"
 #include "TextureManager.h"
 
 
@@ -37,9 +38,12 @@ CTexture::CTexture(uint32_t dwWidth, uint32_t dwHeight, TextureUsage usage) :
     m_bClampedS(false),
     m_bClampedT(false),
     m_bIsEnhancedTexture(false),
+    m_bDecodeQueued(false),
     m_Usage(usage),
         m_pTexture(NULL),
-        m_dwTextureFmt(TEXTURE_FMT_A8R8G8B8)
+        m_dwTextureFmt(TEXTURE_FMT_A8R8G8B8),
+        m_bDeferUpload(false),
+        m_bUploadPending(false)
 {
    // fix me, do something here
 }
@@ -49,6 +53,28 @@ CTexture::~CTexture(void)
 {
 }
 
+bool CTexture::FlushUpload(void)
+{
+    WaitDecode();
+
+    m_bDeferUpload = false;
+    if (!m_bUploadPending)
+        return false;
+
+    m_bUploadPending = false;
+    Upload();
+    return true;
+}
+
+void CTexture::WaitDecode(void)
+{
+    if (m_bDecodeQueued)
+    {
+        TextureDecoderWait(this);
+        m_bDecodeQueued = false;
+    }
+}
+
 TextureFmt CTexture::GetSurfaceFormat(void)
 {
    if (m_pTexture == NULL)
@@ -63,6 +89,11 @@ uint32_t CTexture::GetPixelSize()
    return 2;
 }
 
+uint32_t CTexture::GetDeviceSize(void)
+{
+   return m_dwCreatedTextureWidth * m_dwCreatedTextureHeight * GetPixelSize();
+}
+
 
 // There are reasons to create this function. D3D and OGL will only create surface of width and height
 // as 2's pow, for example, N64's 20x14 image, D3D and OGL will create a 32x16 surface.
@@ -74,6 +74,9 @@ public:
     bool        m_bClampedT;
 
     bool        m_bIsEnhancedTexture;
+
+    // Set while a worker may still be decoding the surface, see TextureDecoder.h
+    bool        m_bDecodeQueued;
     
     TextureUsage    m_Usage;
 
@@ -84,6 +87,7 @@ public:
     virtual LPRICETEXTURE GetTexture() { return m_pTexture; }
 
     uint32_t          GetPixelSize();
+    virtual uint32_t  GetDeviceSize(void);  // Bytes the device holds for this texture
     TextureFmt      GetSurfaceFormat(void); // Surface pixel format...
     inline void     SetOthersVariables(void)
     {
@@ -95,12 +99,29 @@ public:
     virtual bool StartUpdate(DrawInfo *di)=0;
     virtual void EndUpdate(DrawInfo *di)=0;
 
+    // Between DeferUpload() and FlushUpload(), EndUpdate() only marks the
+    // surface as changed and FlushUpload() sends it to the device once.
+    // FlushUpload() waits for a queued decode first and returns true if it
+    // uploaded.
+    void DeferUpload(void) { m_bDeferUpload = true; }
+    bool FlushUpload(void);
+
+    // Waits until the surface is no longer written by a decode worker
+    void WaitDecode(void);
+
     virtual void RestoreAlphaChannel(void); // Restore Alpha channel from RGB channel
 
 protected:
     CTexture(uint32_t dwWidth, uint32_t dwHeight, TextureUsage usage);
+
+    // Sends the surface to the device
+    virtual void Upload(void) {}
+
     LPRICETEXTURE   m_pTexture;
     TextureFmt      m_dwTextureFmt;
+
+    bool        m_bDeferUpload;
+    bool        m_bUploadPending;
 };
 
 #endif
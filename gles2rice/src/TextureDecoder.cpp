@@ -0,0 +1,249 @@
+/*
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#include "TextureDecoder.h"
+
+#ifdef HAVE_RICE_DECODE_THREADS
+
+#include <string.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#define NUM_DECODE_THREADS  2
+#define MAX_DECODE_JOBS     8   // A draw loads two tiles, more queue up only
+                                // when textures are loaded but not drawn
+#define RDP_TLUT_ENTRIES    0x200
+
+extern uint16_t g_wRDPTlut[];
+
+enum
+{
+    JOB_FREE,
+    JOB_QUEUED,
+    JOB_RUNNING,
+};
+
+typedef struct
+{
+    int              state;
+    TxtrCacheEntry  *pEntry;
+    CTexture        *pTexture;
+    ConvertFunction  pF;
+    TxtrInfo         ti;
+    bool             bExpand;
+    uint16_t         tlut[RDP_TLUT_ENTRIES];
+} TxtrDecodeJob;
+
+class TextureDecoderPool
+{
+public:
+    TextureDecoderPool() :
+        m_quit(false)
+    {
+        for (int i = 0; i < MAX_DECODE_JOBS; i++)
+            m_jobs[i].state = JOB_FREE;
+
+        for (int i = 0; i < NUM_DECODE_THREADS; i++)
+            m_threads[i] = std::thread(&TextureDecoderPool::do_work, this);
+    }
+
+    ~TextureDecoderPool() {
+        wait_all();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_queued.notify_all();
+
+        for (int i = 0; i < NUM_DECODE_THREADS; i++)
+            m_threads[i].join();
+    }
+
+    // Returns false when every job slot is taken
+    bool queue(TxtrCacheEntry *pEntry, ConvertFunction pF, const TxtrInfo &ti, bool bExpand) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            TxtrDecodeJob *job = find(JOB_FREE, NULL);
+
+            if (job == NULL)
+                return false;
+
+            job->pEntry   = pEntry;
+            job->pTexture = pEntry->pTexture;
+            job->pF       = pF;
+            job->ti       = ti;
+            job->bExpand  = bExpand;
+
+            // Later TLUT loads must not reach the palette of this decode
+            uint8_t *tlut = (uint8_t*)g_wRDPTlut;
+            if (ti.PalAddress >= tlut && ti.PalAddress < tlut + sizeof(job->tlut))
+            {
+                memcpy(job->tlut, g_wRDPTlut, sizeof(job->tlut));
+                job->ti.PalAddress = (uint8_t*)job->tlut + (ti.PalAddress - tlut);
+            }
+
+            job->state = JOB_QUEUED;
+        }
+        m_queued.notify_one();
+
+        return true;
+    }
+
+    void wait(CTexture *pTexture) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (;;) {
+            TxtrDecodeJob *job = find(JOB_QUEUED, pTexture);
+
+            if (job != NULL) {
+                run(job, lock);
+                continue;
+            }
+
+            if (find(JOB_RUNNING, pTexture) == NULL)
+                break;
+
+            m_done.wait(lock);
+        }
+    }
+
+    void wait_all() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (;;) {
+            TxtrDecodeJob *job = find(JOB_QUEUED, NULL);
+
+            if (job != NULL) {
+                run(job, lock);
+                continue;
+            }
+
+            if (find(JOB_RUNNING, NULL) == NULL)
+                break;
+
+            m_done.wait(lock);
+        }
+    }
+
+private:
+    TxtrDecodeJob m_jobs[MAX_DECODE_JOBS];
+    bool m_quit;
+    std::mutex m_mutex;
+    std::condition_variable m_queued;
+    std::condition_variable m_done;
+    std::thread m_threads[NUM_DECODE_THREADS];
+
+    // A job in the given state, for pTexture or for any texture if NULL
+    TxtrDecodeJob *find(int state, CTexture *pTexture) {
+        for (int i = 0; i < MAX_DECODE_JOBS; i++) {
+            if (m_jobs[i].state == state && (pTexture == NULL || m_jobs[i].pTexture == pTexture))
+                return &m_jobs[i];
+        }
+
+        return NULL;
+    }
+
+    // Runs a queued job on the calling thread, the lock is dropped meanwhile
+    void run(TxtrDecodeJob *job, std::unique_lock<std::mutex> &lock) {
+        job->state = JOB_RUNNING;
+        lock.unlock();
+
+        gTextureManager.DecodeTexture(job->pEntry, job->pF, job->ti, job->bExpand);
+
+        lock.lock();
+        job->state = JOB_FREE;
+        m_done.notify_all();
+    }
+
+    void do_work() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (;;) {
+            TxtrDecodeJob *job = NULL;
+
+            m_queued.wait(lock, [this, &job] {
+                return m_quit || (job = find(JOB_QUEUED, NULL)) != NULL;
+            });
+            if (m_quit)
+                break;
+
+            run(job, lock);
+        }
+    }
+};
+
+static std::unique_ptr<TextureDecoderPool> decoder_pool;
+
+void TextureDecoderInit(void)
+{
+    if (!decoder_pool)
+        decoder_pool.reset(new TextureDecoderPool());
+}
+
+void TextureDecoderShutdown(void)
+{
+    decoder_pool.reset();
+}
+
+void TextureDecoderQueue(TxtrCacheEntry *pEntry, ConvertFunction pF, const TxtrInfo &ti, bool bExpand)
+{
+    if (decoder_pool && decoder_pool->queue(pEntry, pF, ti, bExpand))
+        pEntry->pTexture->m_bDecodeQueued = true;
+    else
+        gTextureManager.DecodeTexture(pEntry, pF, ti, bExpand);
+}
+
+void TextureDecoderWait(CTexture *pTexture)
+{
+    if (decoder_pool)
+        decoder_pool->wait(pTexture);
+}
+
+void TextureDecoderWaitAll(void)
+{
+    if (decoder_pool)
+        decoder_pool->wait_all();
+}
+
+#else
+
+void TextureDecoderInit(void)
+{
+}
+
+void TextureDecoderShutdown(void)
+{
+}
+
+void TextureDecoderQueue(TxtrCacheEntry *pEntry, ConvertFunction pF, const TxtrInfo &ti, bool bExpand)
+{
+    gTextureManager.DecodeTexture(pEntry, pF, ti, bExpand);
+}
+
+void TextureDecoderWait(CTexture *pTexture)
+{
+}
+
+void TextureDecoderWaitAll(void)
+{
+}
+
+#endif
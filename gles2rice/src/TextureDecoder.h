@@ -0,0 +1,46 @@
+/*
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+
+#ifndef __TEXTUREDECODER_H__
+#define __TEXTUREDECODER_H__
+
+#include "TextureManager.h"
+
+// Worker threads that convert and expand the textures PrepareTextures
+// loads while the display list moves on. The GL upload stays on the render
+// thread: CTexture::FlushUpload waits for the decode and uploads the
+// surface when the texture is bound for a draw.
+//
+// A decode reads RDRAM and the TLUT. The TLUT is copied when the job is
+// queued, RDRAM must not change until the job is done, so every place the
+// plugin writes RDRAM calls TextureDecoderWaitAll first, and so does the
+// end of each display list before the CPU runs again.
+//
+// Without HAVE_RICE_DECODE_THREADS a queued job runs straight away.
+
+void TextureDecoderInit(void);
+void TextureDecoderShutdown(void);
+
+// Converts the entry's surface with pF from ti, then expands it to the
+// entry's final size if bExpand is set, see CTextureManager::DecodeTexture
+void TextureDecoderQueue(TxtrCacheEntry *pEntry, ConvertFunction pF, const TxtrInfo &ti, bool bExpand);
+
+// Waits for the decode of pTexture, running it here if no worker took it yet
+void TextureDecoderWait(CTexture *pTexture);
+void TextureDecoderWaitAll(void);
+
+#endif
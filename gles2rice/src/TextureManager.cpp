@@ -23,13 +23,12 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "DeviceBuilder.h"
 #include "FrameBuffer.h"
 #include "RenderBase.h"
+#include "TextureDecoder.h"
 #include "TextureManager.h"
 
-CTextureManager gTextureManager;
+#include "../../Graphics/RDP/rdram_gen.h"
 
-unsigned int g_maxTextureMemUsage = (5*1024*1024);
-unsigned int g_amountToFree = (512*1024);
-bool g_bUseSetTextureMem = false;
+CTextureManager gTextureManager;
 
 // Returns the first prime greater than or equal to nFirst
 inline int GetNextPrime(int nFirst)
@@ -68,7 +67,6 @@ inline int GetNextPrime(int nFirst)
 //
 ///////////////////////////////////////////////////////////////////////
 CTextureManager::CTextureManager() :
-    m_pHead(NULL),
     m_pCacheTxtrList(NULL),
     m_numOfCachedTxtrList(809)
 {
@@ -83,6 +81,7 @@ CTextureManager::CTextureManager() :
     for (uint32_t i = 0; i < m_numOfCachedTxtrList; i++)
         m_pCacheTxtrList[i] = NULL;
 
+    memset(&m_stats, 0, sizeof(m_stats));
     memset(&m_blackTextureEntry, 0, sizeof(TxtrCacheEntry));
     memset(&m_PrimColorTextureEntry, 0, sizeof(TxtrCacheEntry));
     memset(&m_EnvColorTextureEntry, 0, sizeof(TxtrCacheEntry));
@@ -104,17 +103,6 @@ bool CTextureManager::CleanUp()
 {
     RecycleAllTextures();
 
-    if (!g_bUseSetTextureMem)
-    {
-        while (m_pHead)
-        {
-            TxtrCacheEntry * pVictim = m_pHead;
-            m_pHead = pVictim->pNext;
-
-            delete pVictim;
-        }
-    }
-
     if( m_blackTextureEntry.pTexture )      delete m_blackTextureEntry.pTexture;    
     if( m_PrimColorTextureEntry.pTexture )  delete m_PrimColorTextureEntry.pTexture;
     if( m_EnvColorTextureEntry.pTexture )   delete m_EnvColorTextureEntry.pTexture;
@@ -140,146 +128,109 @@ bool CTextureManager::TCacheEntryIsLoaded(TxtrCacheEntry *pEntry)
     return false;
 }
 
-// Purge any textures whos last usage was over 5 seconds ago
-void CTextureManager::PurgeOldTextures()
+// Cache budget in bytes, 0 for no limit
+static uint64_t TextureCacheBudget(void)
 {
-    if (m_pCacheTxtrList == NULL)
-        return;
-    
-    if (g_bUseSetTextureMem)
+    return (uint64_t)options.textureCacheSize * 1024 * 1024;
+}
+
+// Release the least recently used textures until dwIncoming more bytes fit
+// in the budget. A texture still bound to a tile stops the walk, everything
+// younger than it was used at least as recently.
+void CTextureManager::EvictTextures(uint32_t dwIncoming)
+{
+    uint64_t budget = TextureCacheBudget();
+
+    if (budget == 0)
         return;
 
-    static const uint32_t dwFramesToKill = 5*30;          // 5 secs at 30 fps
-    static const uint32_t dwFramesToDelete = 30*30;       // 30 secs at 30 fps
-    
-    for ( uint32_t i = 0; i < m_numOfCachedTxtrList; i++ )
+    while (m_pOldestTexture != NULL &&
+           (uint64_t)m_currentTextureMemUsage + dwIncoming > budget)
     {
-        TxtrCacheEntry * pEntry;
-        TxtrCacheEntry * pNext;
-        
-        pEntry = m_pCacheTxtrList[i];
-        while (pEntry)
-        {
-            pNext = pEntry->pNext;
-            
-            if ( status.gDlistCount - pEntry->FrameLastUsed > dwFramesToKill && !TCacheEntryIsLoaded(pEntry))
-                RemoveTexture(pEntry);
-            pEntry = pNext;
-        }
-    }
-    
-    
-    // Remove any old textures that haven't been recycled in 1 minute or so
-    // Normally these would be reused
-    TxtrCacheEntry* pPrev = NULL;
-    TxtrCacheEntry* pCurr = m_pHead;
-    TxtrCacheEntry * pNext;
+        TxtrCacheEntry *pVictim = m_pOldestTexture;
 
-    while (pCurr)
-    {
-        pNext = pCurr->pNext;
-        
-        if ( status.gDlistCount - pCurr->FrameLastUsed > dwFramesToDelete && !TCacheEntryIsLoaded(pCurr) )
-        {
-            if (pPrev != NULL)
-               pPrev->pNext = pCurr->pNext;
-            else
-               m_pHead      = pCurr->pNext;
-            
-            delete pCurr;
-            pCurr = pNext;  
-        }
-        else
-        {
-            pPrev = pCurr;
-            pCurr = pNext;
-        }
+        if (TCacheEntryIsLoaded(pVictim))
+            break;
+
+        m_stats.dwEvictions++;
+        m_stats.qwEvictedBytes += pVictim->dwDeviceSize;
+        RemoveTexture(pVictim);
     }
 }
 
-void CTextureManager::RecycleAllTextures()
+// Bring the cache back under budget, in case the budget was lowered or
+// bound textures kept it from shrinking when they were created
+void CTextureManager::PurgeOldTextures()
 {
     if (m_pCacheTxtrList == NULL)
         return;
-    
-    uint32_t dwCount = 0;
-    uint32_t dwTotalUses = 0;
-    
-    m_pYoungestTexture          = NULL;
-    m_pOldestTexture            = NULL;
 
-    for (uint32_t i = 0; i < m_numOfCachedTxtrList; i++)
-    {
-        while (m_pCacheTxtrList[i])
-        {
-            TxtrCacheEntry *pTVictim = m_pCacheTxtrList[i];
-            m_pCacheTxtrList[i] = pTVictim->pNext;
-            
-            dwTotalUses += pTVictim->dwUses;
-            dwCount++;
-            if (g_bUseSetTextureMem)
-                delete pTVictim;
-            else
-               RecycleTexture(pTVictim);
-        }
-    }
+    EvictTextures(0);
 }
 
-void CTextureManager::RecheckHiresForAllTextures()
+void CTextureManager::RecycleAllTextures()
 {
     if (m_pCacheTxtrList == NULL)
         return;
 
+    LogStats();
+
     for (uint32_t i = 0; i < m_numOfCachedTxtrList; i++)
-    {
-        while (m_pCacheTxtrList[i])
-        {
-            TxtrCacheEntry *pTVictim = m_pCacheTxtrList[i];
-            m_pCacheTxtrList[i] = pTVictim->pNext;
-            pTVictim->bExternalTxtrChecked = false;
+        m_pCacheTxtrList[i] = NULL;
 
-        }
+    // Every entry is on the age list, free them from there
+    while (m_pOldestTexture)
+    {
+        TxtrCacheEntry *pTVictim = m_pOldestTexture;
+        m_pOldestTexture = pTVictim->pNextYoungest;
+        DeleteCacheEntry(pTVictim);
     }
+
+    m_pYoungestTexture          = NULL;
+    m_currentTextureMemUsage    = 0;
+    memset(&m_stats, 0, sizeof(m_stats));
 }
 
+void CTextureManager::RecheckHiresForAllTextures()
+{
+    for (TxtrCacheEntry *pEntry = m_pOldestTexture; pEntry; pEntry = pEntry->pNextYoungest)
+        pEntry->bExternalTxtrChecked = false;
+}
 
-// Add to the recycle list
-void CTextureManager::RecycleTexture(TxtrCacheEntry *pEntry)
+void CTextureManager::DeleteCacheEntry(TxtrCacheEntry *pEntry)
 {
-   if (g_bUseSetTextureMem)
-      return;
+    if (pEntry->pTexture)
+        pEntry->pTexture->WaitDecode();
+
+    // The entry destructor only frees the memory, delete the textures
+    // so the device copies are released too
+    delete pEntry->pTexture;
+    delete pEntry->pEnhancedTexture;
+    pEntry->pTexture         = NULL;
+    pEntry->pEnhancedTexture = NULL;
 
-   // Fix me, why I can not reuse the texture in OpenGL,
-   // how can I unload texture from video card memory for OpenGL
-   delete pEntry;
+    delete pEntry;
 }
 
-// Search for a texture of the specified dimensions to recycle
-TxtrCacheEntry * CTextureManager::ReviveTexture( uint32_t width, uint32_t height )
+void CTextureManager::GetStats(TextureCacheStats *stats)
 {
-    if (g_bUseSetTextureMem)
-        return NULL;
+    *stats = m_stats;
+    stats->dwResidentBytes = m_currentTextureMemUsage;
+    stats->qwBudgetBytes   = TextureCacheBudget();
+}
 
-    TxtrCacheEntry* pPrev = NULL;
-    TxtrCacheEntry* pCurr = m_pHead;
+void CTextureManager::LogStats()
+{
+    uint32_t dwLookups = m_stats.dwHits + m_stats.dwReloads + m_stats.dwMisses;
 
-    while (pCurr)
-    {
-        if (pCurr->ti.WidthToCreate == width &&
-            pCurr->ti.HeightToCreate == height)
-        {
-            // Remove from list
-            if (pPrev != NULL) pPrev->pNext        = pCurr->pNext;
-            else               m_pHead = pCurr->pNext;
-            
-            return pCurr;
-        }
-        
-        pPrev = pCurr;
-        pCurr = pCurr->pNext;
-    }
-    
-    return NULL;
+    if (dwLookups == 0)
+        return;
+
+    DebugMessage(M64MSG_VERBOSE, "Texture cache: %u entries, %u KB resident, %u%% hits, %u reloads, %u misses, %u evicted (%u KB)",
+            m_stats.dwEntries, m_currentTextureMemUsage / 1024,
+            (uint32_t)((uint64_t)m_stats.dwHits * 100 / dwLookups),
+            m_stats.dwReloads, m_stats.dwMisses,
+            m_stats.dwEvictions, (uint32_t)(m_stats.qwEvictedBytes / 1024));
 }
 
 
@@ -290,31 +241,14 @@ uint32_t CTextureManager::Hash(uint32_t dwValue)
     return (dwValue>>2) % m_numOfCachedTxtrList;
 }
 
+// Move the entry to the young end of the age list, the oldest entry is
+// the next to be evicted
 void CTextureManager::MakeTextureYoungest(TxtrCacheEntry *pEntry)
 {
-    if (!g_bUseSetTextureMem)
-        return;
-
     if (pEntry == m_pYoungestTexture)
         return;
 
-    // if its the oldest, then change the oldest pointer
-    if (pEntry == m_pOldestTexture)
-        m_pOldestTexture = pEntry->pNextYoungest;
-
-    // if its a not a new texture, close the gap in the age list
-    // where pEntry use to reside
-    if (pEntry->pNextYoungest != NULL || pEntry->pLastYoungest != NULL)
-    {
-        if (pEntry->pNextYoungest != NULL)
-        {
-            pEntry->pNextYoungest->pLastYoungest = pEntry->pLastYoungest;
-        }
-        if (pEntry->pLastYoungest != NULL)
-        {
-            pEntry->pLastYoungest->pNextYoungest = pEntry->pNextYoungest;
-        }
-    }
+    UnlinkTexture(pEntry);
 
     // this texture is now the youngest, so place it on the end of the list
     if (m_pYoungestTexture != NULL)
@@ -326,9 +260,24 @@ void CTextureManager::MakeTextureYoungest(TxtrCacheEntry *pEntry)
      
     // if this is the first texture in memory then its also the oldest
     if (m_pOldestTexture == NULL)
-    {
         m_pOldestTexture = pEntry;
-    }
+}
+
+// Take the entry out of the age list
+void CTextureManager::UnlinkTexture(TxtrCacheEntry *pEntry)
+{
+    if (pEntry->pNextYoungest != NULL)
+        pEntry->pNextYoungest->pLastYoungest = pEntry->pLastYoungest;
+    else if (pEntry == m_pYoungestTexture)
+        m_pYoungestTexture = pEntry->pLastYoungest;
+
+    if (pEntry->pLastYoungest != NULL)
+        pEntry->pLastYoungest->pNextYoungest = pEntry->pNextYoungest;
+    else if (pEntry == m_pOldestTexture)
+        m_pOldestTexture = pEntry->pNextYoungest;
+
+    pEntry->pNextYoungest = NULL;
+    pEntry->pLastYoungest = NULL;
 }
 
 void CTextureManager::AddTexture(TxtrCacheEntry *pEntry)
@@ -379,97 +328,43 @@ void CTextureManager::RemoveTexture(TxtrCacheEntry * pEntry)
     if (m_pCacheTxtrList == NULL)
         return;
 
-    // See if it is already in the hash table
     uint32_t dwKey = Hash(pEntry->ti.Address);
 
-    TxtrCacheEntry* pPrev = NULL;
-    TxtrCacheEntry* pCurr = m_pCacheTxtrList[dwKey];
+    TxtrCacheEntry **p = &m_pCacheTxtrList[dwKey];
 
-    while (pCurr)
-    {
-        // Check that the attributes match
-        if ( pCurr->ti == pEntry->ti )
-        {
-            if (pPrev != NULL) 
-                pPrev->pNext = pCurr->pNext;
-            else
-               m_pCacheTxtrList[dwKey] = pCurr->pNext;
+    while (*p && *p != pEntry)
+        p = &(*p)->pNext;
 
-            if (g_bUseSetTextureMem)
-            {
-                // remove the texture from the age list
-                if (pEntry->pNextYoungest != NULL)
-                    pEntry->pNextYoungest->pLastYoungest = pEntry->pLastYoungest;
-                if (pEntry->pLastYoungest != NULL)
-                    pEntry->pLastYoungest->pNextYoungest = pEntry->pNextYoungest;
-
-                // decrease the mem usage counter
-                m_currentTextureMemUsage -= (pEntry->pTexture->m_dwWidth * pEntry->pTexture->m_dwHeight * 4);
-            
-                delete pEntry;
-            }
-            else
-                RecycleTexture(pEntry);
+    if (*p)
+        *p = pEntry->pNext;
 
-            break;
-        }
+    UnlinkTexture(pEntry);
 
-        pPrev = pCurr;
-        pCurr = pCurr->pNext;
-    }
+    m_currentTextureMemUsage -= pEntry->dwDeviceSize;
+    m_stats.dwEntries--;
+
+    DeleteCacheEntry(pEntry);
 }
     
 TxtrCacheEntry * CTextureManager::CreateNewCacheEntry(uint32_t dwAddr, uint32_t dwWidth, uint32_t dwHeight)
 {
-   TxtrCacheEntry * pEntry = NULL;
-
-   if (g_bUseSetTextureMem)
+   TxtrCacheEntry * pEntry = new TxtrCacheEntry;
+   if (pEntry == NULL)
    {
-      uint32_t widthToCreate = dwWidth;
-      uint32_t heightToCreate = dwHeight;
-      unsigned int freeUpSize = (widthToCreate * heightToCreate * 4) + g_amountToFree;
-
-      // make sure there is enough room for the new texture by deleting old textures
-      while ((m_currentTextureMemUsage + freeUpSize) > g_maxTextureMemUsage && m_pOldestTexture != NULL)
-      {
-         TxtrCacheEntry *nextYoungest = m_pOldestTexture->pNextYoungest;
-
-         RemoveTexture(m_pOldestTexture);
-
-         m_pOldestTexture = nextYoungest;
-
-         //printf("Freeing Texture\n");
-      }
+      _VIDEO_DisplayTemporaryMessage("Error to create an texture entry");
+      return NULL;
+   }
 
-      m_currentTextureMemUsage += widthToCreate * heightToCreate * 4;
+   pEntry->pTexture = CDeviceBuilder::GetBuilder()->CreateTexture(dwWidth, dwHeight);
+   if (pEntry->pTexture == NULL || pEntry->pTexture->GetTexture() == NULL)
+   {
+      _VIDEO_DisplayTemporaryMessage("Error to create an texture");
+      TRACE2("Warning, unable to create %d x %d texture!", dwWidth, dwHeight);
    }
    else
    {
-      // Find a used texture
-      pEntry = ReviveTexture(dwWidth, dwHeight);
-   }
-
-   if (pEntry == NULL || g_bUseSetTextureMem)
-   {
-      // Couldn't find on - recreate!
-      pEntry = new TxtrCacheEntry;
-      if (pEntry == NULL)
-      {
-         _VIDEO_DisplayTemporaryMessage("Error to create an texture entry");
-         return NULL;
-      }
-
-      pEntry->pTexture = CDeviceBuilder::GetBuilder()->CreateTexture(dwWidth, dwHeight);
-      if (pEntry->pTexture == NULL || pEntry->pTexture->GetTexture() == NULL)
-      {
-         _VIDEO_DisplayTemporaryMessage("Error to create an texture");
-         TRACE2("Warning, unable to create %d x %d texture!", dwWidth, dwHeight);
-      }
-      else
-      {
-         pEntry->pTexture->m_bScaledS = false;
-         pEntry->pTexture->m_bScaledT = false;
-      }
+      pEntry->pTexture->m_bScaledS = false;
+      pEntry->pTexture->m_bScaledT = false;
    }
 
    // Initialize
@@ -480,11 +375,19 @@ TxtrCacheEntry * CTextureManager::CreateNewCacheEntry(uint32_t dwAddr, uint32_t
    pEntry->dwUses = 0;
    pEntry->dwTimeLastUsed = status.gRDPTime;
    pEntry->dwCRC = 0;
+   pEntry->dwRDRAMGen = 0;
    pEntry->FrameLastUsed = status.gDlistCount;
    pEntry->FrameLastUpdated = 0;
    pEntry->lastEntry = NULL;
    pEntry->bExternalTxtrChecked = false;
    pEntry->maxCI = -1;
+   pEntry->dwDeviceSize = pEntry->pTexture ? pEntry->pTexture->GetDeviceSize() : 0;
+
+   // make sure there is enough room for the new texture by deleting old textures
+   EvictTextures(pEntry->dwDeviceSize);
+
+   m_currentTextureMemUsage += pEntry->dwDeviceSize;
+   m_stats.dwEntries++;
 
    // Add to the hash table
    AddTexture(pEntry);
@@ -496,14 +399,35 @@ TxtrCacheEntry * CTextureManager::CreateNewCacheEntry(uint32_t dwAddr, uint32_t
 uint32_t dwAsmHeight;
 uint32_t dwAsmPitch;
 uint32_t dwAsmdwBytesPerLine;
-uint32_t dwAsmCRC;
+uint64_t dwAsmCRC;
 uint32_t dwAsmCRC2;
 uint8_t* pAsmStart;
 
 TxtrCacheEntry *g_lastTextureEntry=NULL;
 bool lastEntryModified = false;
 
-TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, bool doCRCCheck, bool AutoExtendTexture)
+// True when none of the RDRAM pages the entry's CRC was taken from got
+// written since it was last checked
+static bool RDRAMUnchanged(const TxtrCacheEntry *pEntry, const TxtrInfo *pgti)
+{
+    const uint8_t *p = (const uint8_t*)pgti->pPhysicalAddress;
+
+    if (pEntry->ti.pPhysicalAddress != pgti->pPhysicalAddress ||
+        p < gfx_info.RDRAM || p >= gfx_info.RDRAM + g_dwRamSize)
+        return false;
+
+    return rdram_gen_unchanged((uint32_t)(p - gfx_info.RDRAM) + pgti->TopToLoad*pgti->Pitch,
+            (pgti->HeightToLoad+1)*pgti->Pitch, pEntry->dwRDRAMGen);
+}
+
+// A decode that only reads RDRAM and the TLUT can go to the decode workers,
+// see TextureDecoder.h
+static bool CanDecodeAsync(const TxtrInfo &ti)
+{
+    return !options.bUseFullTMEM && ti.Format != G_IM_FMT_YUV && gDP.tiles[7].format != G_IM_FMT_YUV;
+}
+
+TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, bool doCRCCheck, bool AutoExtendTexture, bool AsyncDecode)
 {
     TxtrCacheEntry *pEntry;
 
@@ -513,7 +437,8 @@ TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, boo
     gRDP.texturesAreReloaded = true;
 
     dwAsmCRC = 0;
-    uint32_t dwPalCRC = 0;
+    uint64_t dwPalCRC = 0;
+    uint32_t dwRDRAMGen = 0;
 
     pEntry = GetTxtrCacheEntry(pgti);
     bool loadFromTextureBuffer=false;
@@ -570,7 +495,13 @@ TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, boo
             if( loadFromTextureBuffer )
                 dwAsmCRC = gRenderTextureInfos[txtBufIdxToLoadFrom].crcInRDRAM;
             else
-                CalculateRDRAMCRC(pgti->pPhysicalAddress, pgti->LeftToLoad, pgti->TopToLoad, pgti->WidthToLoad, pgti->HeightToLoad, pgti->Size, pgti->Pitch);
+            {
+                if (pEntry && RDRAMUnchanged(pEntry, pgti))
+                    dwAsmCRC = pEntry->dwCRC;
+                else
+                    CalculateRDRAMCRC(pgti->pPhysicalAddress, pgti->LeftToLoad, pgti->TopToLoad, pgti->WidthToLoad, pgti->HeightToLoad, pgti->Size, pgti->Pitch);
+                dwRDRAMGen = rdram_gen_current();
+            }
         }
     }
 
@@ -607,7 +538,7 @@ TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, boo
         //  dwPalCRC = (dwPalCRC + *(uint32_t*)&pStart[y]);
         //}
 
-        uint32_t dwAsmCRCSave = dwAsmCRC;
+        uint64_t dwAsmCRCSave = dwAsmCRC;
         //dwPalCRC = CalculateRDRAMCRC(pStart, 0, 0, dwPalSize, 1, G_IM_SIZ_16b, dwPalSize*2);
         dwPalCRC = CalculateRDRAMCRC(pStart, 0, 0, maxCI+1, 1, G_IM_SIZ_16b, dwPalSize*2);
         dwAsmCRC = dwAsmCRCSave;
@@ -619,13 +550,20 @@ TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, boo
             (!loadFromTextureBuffer || gRenderTextureInfos[txtBufIdxToLoadFrom].updateAtFrame < pEntry->FrameLastUsed ) )
         {
             // Tile is ok, return
+            if (dwRDRAMGen != 0)
+                pEntry->dwRDRAMGen = dwRDRAMGen;
             pEntry->dwUses++;
+            m_stats.dwHits++;
             pEntry->dwTimeLastUsed = status.gRDPTime;
             pEntry->FrameLastUsed = status.gDlistCount;
             pEntry->lastEntry = g_lastTextureEntry;
             g_lastTextureEntry = pEntry;
             lastEntryModified = false;
 
+            // Callers that do not bind the texture for a draw get it finished
+            if (!AsyncDecode && pEntry->pTexture)
+                pEntry->pTexture->FlushUpload();
+
             return pEntry;
         }
         else
@@ -634,8 +572,12 @@ TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, boo
         }
     }
 
-    if (pEntry == NULL)
+    if (pEntry != NULL)
+        m_stats.dwReloads++;
+    else
     {
+        m_stats.dwMisses++;
+
         // We need to create a new entry, and add it
         //  to the hash table.
         pEntry = CreateNewCacheEntry(pgti->Address, pgti->WidthToCreate, pgti->HeightToCreate);
@@ -651,11 +593,18 @@ TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, boo
     pEntry->ti = *pgti;
     pEntry->dwCRC = dwAsmCRC;
     pEntry->dwPalCRC = dwPalCRC;
+    pEntry->dwRDRAMGen = dwRDRAMGen;
     pEntry->bExternalTxtrChecked = false;
     pEntry->maxCI = maxCI;
 
     if (pEntry->pTexture != NULL)
     {
+       // A decode queued earlier must not write over this one
+       pEntry->pTexture->WaitDecode();
+
+       // Conversion and expansion each update the surface, upload it once
+       pEntry->pTexture->DeferUpload();
+
        if( pEntry->pTexture->m_dwCreatedTextureWidth < pgti->WidthToCreate )
        {
           pEntry->ti.WidthToLoad = pEntry->pTexture->m_dwCreatedTextureWidth;
@@ -670,6 +619,8 @@ TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, boo
        }
 
        TextureFmt dwType = pEntry->pTexture->GetSurfaceFormat();
+       TxtrInfo convertInfo = pEntry->ti;
+       ConvertFunction pF = NULL;
 
        if (pEntry->pEnhancedTexture)
           free(pEntry->pEnhancedTexture);
@@ -697,9 +648,9 @@ TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, boo
           else
           {
              if (dwType == TEXTURE_FMT_A8R8G8B8)
-                ConvertTexture(pEntry, fromTMEM);
+                pF = GetConvertFunction(pEntry, fromTMEM);
              else
-                ConvertTexture_16(pEntry, fromTMEM);
+                pF = GetConvertFunction_16(pEntry, fromTMEM);
              pEntry->FrameLastUpdated = status.gDlistCount;
 
              if (pEntry->pEnhancedTexture)
@@ -712,10 +663,13 @@ TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, boo
        pEntry->ti.WidthToLoad = pgti->WidthToLoad;
        pEntry->ti.HeightToLoad = pgti->HeightToLoad;
 
-       if( AutoExtendTexture )
+       // The upload of a queued decode happens when the texture is bound
+       if( pF && AsyncDecode && CanDecodeAsync(pEntry->ti) )
+          TextureDecoderQueue(pEntry, pF, convertInfo, AutoExtendTexture);
+       else
        {
-          ExpandTextureS(pEntry);
-          ExpandTextureT(pEntry);
+          DecodeTexture(pEntry, pF, convertInfo, AutoExtendTexture);
+          pEntry->pTexture->FlushUpload();
        }
 
 #ifdef DEBUGGER
@@ -731,7 +685,7 @@ TxtrCacheEntry * CTextureManager::GetTexture(TxtrInfo * pgti, bool fromTMEM, boo
           }
           DebuggerAppendMsg("W:%d, H:%d, RealW:%d, RealH:%d, D3DW:%d, D3DH: %d", pEntry->ti.WidthToCreate, pEntry->ti.HeightToCreate,
                 pEntry->ti.WidthToLoad, pEntry->ti.HeightToLoad, pEntry->pTexture->m_dwCreatedTextureWidth, pEntry->pTexture->m_dwCreatedTextureHeight);
-          DebuggerAppendMsg("ScaledS:%s, ScaledT:%s, CRC=%08X", pEntry->pTexture->m_bScaledS?"T":"F", pEntry->pTexture->m_bScaledT?"T":"F", pEntry->dwCRC);
+          DebuggerAppendMsg("ScaledS:%s, ScaledT:%s, CRC=%016llX", pEntry->pTexture->m_bScaledS?"T":"F", pEntry->pTexture->m_bScaledT?"T":"F", (unsigned long long)pEntry->dwCRC);
           DebuggerPause();
           CRender::g_pRender->SetCurrentTexture( 0, NULL, 64, 64, NULL);
        }
@@ -758,10 +712,8 @@ extern ConvertFunction  gConvertTlutFunctions[ 8 ][ 4 ];
 extern ConvertFunction  gConvertFunctions_16[ 8 ][ 4 ];
 extern ConvertFunction  gConvertFunctions_16_FullTMEM[ 8 ][ 4 ];
 extern ConvertFunction  gConvertTlutFunctions_16[ 8 ][ 4 ];
-void CTextureManager::ConvertTexture(TxtrCacheEntry * pEntry, bool fromTMEM)
+ConvertFunction CTextureManager::GetConvertFunction(TxtrCacheEntry * pEntry, bool fromTMEM)
 {
-   static uint32_t dwCount = 0;
-
    ConvertFunction pF;
    if( options.bUseFullTMEM && fromTMEM && status.bAllowLoadFromTMEM )
       pF = gConvertFunctions_FullTMEM[ pEntry->ti.Format ][ pEntry->ti.Size ];
@@ -783,22 +735,16 @@ void CTextureManager::ConvertTexture(TxtrCacheEntry * pEntry, bool fromTMEM)
       }
    }
 
-   if( pF )
-   {
-      pF( pEntry->pTexture, pEntry->ti );
-   }
-   else
+   if( pF == NULL )
    {
       TRACE2("ConvertTexture: Unable to decompress %s/%dbpp", pszImgFormat[pEntry->ti.Format], pnImgSize[pEntry->ti.Size]);
    }
 
-   dwCount++;
+   return pF;
 }
 
-void CTextureManager::ConvertTexture_16(TxtrCacheEntry * pEntry, bool fromTMEM)
+ConvertFunction CTextureManager::GetConvertFunction_16(TxtrCacheEntry * pEntry, bool fromTMEM)
 {
-    static uint32_t dwCount = 0;
-    
     ConvertFunction pF;
 
     if( options.bUseFullTMEM && fromTMEM && status.bAllowLoadFromTMEM )
@@ -813,14 +759,27 @@ void CTextureManager::ConvertTexture_16(TxtrCacheEntry * pEntry, bool fromTMEM)
             pF = gConvertFunctions_16[ pEntry->ti.Format ][ pEntry->ti.Size ];
     }
 
-    if( pF )
-        pF( pEntry->pTexture, pEntry->ti );
-    else
+    if( pF == NULL )
     {
         TRACE2("ConvertTexture: Unable to decompress %s/%dbpp", pszImgFormat[pEntry->ti.Format], pnImgSize[pEntry->ti.Size]);
     }
 
-    dwCount++;
+    return pF;
+}
+
+// Converts the entry's surface from ti and expands it to the size the entry
+// was created for. May run on a decode worker, so it only touches the
+// entry's surface.
+void CTextureManager::DecodeTexture(TxtrCacheEntry * pEntry, ConvertFunction pF, const TxtrInfo &ti, bool AutoExtendTexture)
+{
+    if( pF )
+        pF( pEntry->pTexture, ti );
+
+    if( AutoExtendTexture )
+    {
+        ExpandTextureS(pEntry);
+        ExpandTextureT(pEntry);
+    }
 }
 
 void CTextureManager::ExpandTexture(TxtrCacheEntry * pEntry, uint32_t sizeToLoad, uint32_t sizeToCreate, uint32_t sizeCreated,
@@ -146,14 +146,16 @@ typedef struct TxtrCacheEntry
     struct TxtrCacheEntry *pLastYoungest;
 
     TxtrInfo ti;
-    uint32_t      dwCRC;
-    uint32_t      dwPalCRC;
+    uint64_t      dwCRC;
+    uint64_t      dwPalCRC;
+    uint32_t      dwRDRAMGen;     // RDRAM generation in which dwCRC was last checked
     int         maxCI;
 
     uint32_t  dwUses;         // Total times used (for stats)
     uint32_t  dwTimeLastUsed; // timeGetTime of time of last usage
     uint32_t  FrameLastUsed;  // Frame # that this was last used
     uint32_t  FrameLastUpdated;
+    uint32_t  dwDeviceSize;   // Bytes counted against the cache budget
 
     CTexture    *pTexture;
     CTexture    *pEnhancedTexture;
@@ -165,6 +167,20 @@ typedef struct TxtrCacheEntry
     TxtrCacheEntry *lastEntry;
 } TxtrCacheEntry;
 
+typedef struct
+{
+    uint32_t  dwEntries;
+    uint32_t  dwResidentBytes;
+    uint64_t  qwBudgetBytes;      // 0 for no limit
+    uint32_t  dwHits;             // Lookups that reused the cached texture
+    uint32_t  dwReloads;          // Lookups that found the entry but reconverted it
+    uint32_t  dwMisses;           // Lookups that created a new entry
+    uint32_t  dwEvictions;
+    uint64_t  qwEvictedBytes;
+} TextureCacheStats;
+
+
+typedef void    ( * ConvertFunction )( CTexture * p_texture, const TxtrInfo & ti );
 
 //*****************************************************************************
 // Texture cache implementation
@@ -175,12 +191,12 @@ protected:
     TxtrCacheEntry * CreateNewCacheEntry(uint32_t dwAddr, uint32_t dwWidth, uint32_t dwHeight);
     void AddTexture(TxtrCacheEntry *pEntry);
     void RemoveTexture(TxtrCacheEntry * pEntry);
-    void RecycleTexture(TxtrCacheEntry *pEntry);
-    TxtrCacheEntry * ReviveTexture( uint32_t width, uint32_t height );
+    void DeleteCacheEntry(TxtrCacheEntry *pEntry);
+    void EvictTextures(uint32_t dwIncoming);
     TxtrCacheEntry * GetTxtrCacheEntry(TxtrInfo * pti);
     
-    void ConvertTexture(TxtrCacheEntry * pEntry, bool fromTMEM);
-    void ConvertTexture_16(TxtrCacheEntry * pEntry, bool fromTMEM);
+    ConvertFunction GetConvertFunction(TxtrCacheEntry * pEntry, bool fromTMEM);
+    ConvertFunction GetConvertFunction_16(TxtrCacheEntry * pEntry, bool fromTMEM);
 
     void ClampS32(uint32_t *array, uint32_t width, uint32_t towidth, uint32_t arrayWidth, uint32_t rows);
     void ClampS16(uint16_t *array, uint32_t width, uint32_t towidth, uint32_t arrayWidth, uint32_t rows);
@@ -213,7 +229,6 @@ public:
     void Mirror(void *array, uint32_t width, uint32_t mask, uint32_t towidth, uint32_t arrayWidth, uint32_t rows, int flag, int size );
     
 protected:
-    TxtrCacheEntry * m_pHead;
     TxtrCacheEntry ** m_pCacheTxtrList;
     uint32_t m_numOfCachedTxtrList;
 
@@ -227,23 +242,33 @@ protected:
     TxtrCacheEntry * GetLODFracTexture(uint8_t fac);
     TxtrCacheEntry * GetPrimLODFracTexture(uint8_t fac);
 
+    // Every cached entry is on the age list, oldest first
     void MakeTextureYoungest(TxtrCacheEntry *pEntry);
+    void UnlinkTexture(TxtrCacheEntry *pEntry);
     unsigned int m_currentTextureMemUsage;
     TxtrCacheEntry *m_pYoungestTexture;
     TxtrCacheEntry *m_pOldestTexture;
 
+    TextureCacheStats m_stats;
+
 public:
     CTextureManager();
     ~CTextureManager();
 
     TxtrCacheEntry * GetBlackTexture(void);
     TxtrCacheEntry * GetConstantColorTexture(uint32_t constant);
-    TxtrCacheEntry * GetTexture(TxtrInfo * pgti, bool fromTMEM, bool doCRCCheck, bool AutoExtendTexture);
+    // With AsyncDecode the texture may come back still decoding, it is
+    // finished when it is bound for a draw (see TextureDecoder.h)
+    TxtrCacheEntry * GetTexture(TxtrInfo * pgti, bool fromTMEM, bool doCRCCheck, bool AutoExtendTexture, bool AsyncDecode = false);
+    void DecodeTexture(TxtrCacheEntry * pEntry, ConvertFunction pF, const TxtrInfo &ti, bool AutoExtendTexture);
     
     void PurgeOldTextures();
     void RecycleAllTextures();
     void RecheckHiresForAllTextures();
     bool CleanUp();
+
+    void GetStats(TextureCacheStats *stats);
+    void LogStats();
     
 #ifdef DEBUGGER
     TxtrCacheEntry * GetCachedTexture(uint32_t tex);
@@ -37,6 +37,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "GraphicsContext.h"
 #include "Render.h"
 #include "RSP_Parser.h"
+#include "TextureDecoder.h"
 #include "TextureManager.h"
 #include "Video.h"
 #include "version.h"
@@ -378,6 +379,8 @@ void riceRomClosed(void)
 
     status.bGameIsRunning = false;
 
+    TextureDecoderShutdown();
+
     // Kill all textures?
     gTextureManager.RecycleAllTextures();
     gTextureManager.CleanUp();
@@ -414,6 +417,8 @@ int riceRomOpen(void)
     if (!StartVideo())
         return 0;
 
+    TextureDecoderInit();
+
     return 1;
 }
 
@@ -332,7 +332,7 @@ typedef struct
     bool                bCopied;
     unsigned int    dwCopiedAtFrame;
 
-    unsigned int    dwCRC;
+    uint64_t        dwCRC;
     unsigned int    lastUsedFrame;
     unsigned int    bUsedByVIAtFrame;
     unsigned int    lastSetAtUcode;
@@ -37,6 +37,9 @@
 //
 //****************************************************************
 
+#include <string.h>
+#include <libretro.h>
+
 #include "Gfx_1.3.h"
 #include "Util.h"
 #include "Combine.h"
@@ -46,11 +49,11 @@
 
 #define HAVE_ASSUME_COMBINE_EXT
 
+extern retro_log_printf_t log_cb;
+
 float percent_org, percent, r, g, b;
 static uint32_t lod_frac;
 
-static uint32_t cc_lookup[257];
-static uint32_t ac_lookup[257];
 COMBINE cmb;
 
 //****************************************************************
@@ -13877,51 +13880,160 @@ static COMBINER alpha_cmb_list[] =
    // { #ACEND }
 };
 
-// CountCombine - count the # of entries in the combine lists
-void CountCombine(void)
+// Combiner dispatch tables
+//
+// Each combiner list gets a hash-and-displace table: the key picks a bucket,
+// the bucket's salt picks the slot, and CountCombine() chooses the salts so
+// no two keys share a slot. A lookup is then a single probe whether the key
+// is in the list or not.
+#define CMB_BUCKET_BITS 8
+#define CMB_CC_SLOT_BITS 11
+#define CMB_AC_SLOT_BITS 10
+#define CMB_EMPTY 0xFFFF
+
+typedef struct
 {
-   int i, index, a, b, size;
-   size = sizeof(color_cmb_list) / sizeof(COMBINER);
-   i = 0;
-   index = 0;
+   uint32_t key;
+   uint16_t index;
+} CMB_SLOT;
 
-   do {
-      a = color_cmb_list[index].key >> 24;
-      for (; i<=a; i++)
-         cc_lookup[i] = index;
+typedef struct
+{
+   const COMBINER *list;
+   CMB_SLOT *slots;
+   uint32_t slot_mask;
+   uint32_t salt[1 << CMB_BUCKET_BITS];
+} CMB_TABLE;
 
-      while (index < size)
-      {
-         b = color_cmb_list[index].key >> 24;
-         if (b != a) break;
-         index ++;
-      }
-   } while (index < size);
-   for (; i<257; i++)
-      cc_lookup[i] = index;
+static CMB_SLOT cc_slots[1 << CMB_CC_SLOT_BITS];
+static CMB_SLOT ac_slots[1 << CMB_AC_SLOT_BITS];
+static CMB_TABLE cc_table = { color_cmb_list, cc_slots, (1 << CMB_CC_SLOT_BITS) - 1 };
+static CMB_TABLE ac_table = { alpha_cmb_list, ac_slots, (1 << CMB_AC_SLOT_BITS) - 1 };
+
+// Recently resolved (cycle1, cycle2) pairs. The lists never change once
+// built, so entries stay valid and only get replaced on a collision.
+#define CMB_MEMO_BITS 6
+
+typedef struct
+{
+   uint32_t cycle1, cycle2;
+   const COMBINER *color;
+   const COMBINER *alpha;
+   int valid;
+} CMB_MEMO;
 
-   size = sizeof(alpha_cmb_list) / sizeof(COMBINER);
+static CMB_MEMO cmb_memo[1 << CMB_MEMO_BITS];
 
-   i=0, index=0;
+static INLINE uint32_t CmbMix(uint32_t x)
+{
+   x ^= x >> 16;
+   x *= 0x7FEB352D;
+   x ^= x >> 15;
+   x *= 0x846CA68B;
+   x ^= x >> 16;
+   return x;
+}
+
+static INLINE uint32_t CmbBucket(uint32_t key)
+{
+   return CmbMix(key) >> (32 - CMB_BUCKET_BITS);
+}
 
-   do
+static INLINE uint32_t CmbSlot(const CMB_TABLE *table, uint32_t key, uint32_t salt)
+{
+   return CmbMix(key ^ salt) & table->slot_mask;
+}
+
+static const COMBINER *CmbFind(const CMB_TABLE *table, uint32_t key)
+{
+   const CMB_SLOT *slot = &table->slots[CmbSlot(table, key, table->salt[CmbBucket(key)])];
+
+   if (slot->index != CMB_EMPTY && slot->key == key)
+      return &table->list[slot->index];
+   return NULL;
+}
+
+static int CmbBuild(CMB_TABLE *table, int size)
+{
+   int count[1 << CMB_BUCKET_BITS];
+   int order[1 << CMB_BUCKET_BITS];
+   int i, j, k, n;
+
+   for (i = 0; i <= (int)table->slot_mask; i++)
+      table->slots[i].index = CMB_EMPTY;
+   memset(count, 0, sizeof(count));
+   for (i = 0; i < size; i++)
+      count[CmbBucket(table->list[i].key)]++;
+
+   // Place the crowded buckets first, while the table is still empty
+   for (i = 0; i < (1 << CMB_BUCKET_BITS); i++)
+   {
+      for (j = i; j > 0 && count[order[j - 1]] < count[i]; j--)
+         order[j] = order[j - 1];
+      order[j] = i;
+   }
+
+   for (n = 0; n < (1 << CMB_BUCKET_BITS); n++)
    {
-      a = (alpha_cmb_list[index].key >> 20) & 0xFF;
-      for (; i<=a; i++)
-         ac_lookup[i] = index;
+      int bucket = order[n];
+      uint32_t seed;
 
-      while (index < size)
+      table->salt[bucket] = 0;
+      if (count[bucket] == 0)
+         continue;
+
+      for (seed = 1; seed < 0x10000; seed++)
       {
-         b = (alpha_cmb_list[index].key >> 20) & 0xFF;
-         if (b != a) break;
-         index ++;
+         uint32_t salt = CmbMix(seed * 0x9E3779B9);
+         int placed = 0;
+
+         for (i = 0; i < size && placed < count[bucket]; i++)
+         {
+            uint32_t key = table->list[i].key;
+            CMB_SLOT *slot;
+
+            if (CmbBucket(key) != (uint32_t)bucket)
+               continue;
+            slot = &table->slots[CmbSlot(table, key, salt)];
+            if (slot->index != CMB_EMPTY)
+               break;
+            slot->key = key;
+            slot->index = i;
+            placed++;
+         }
+
+         if (placed == count[bucket])
+         {
+            table->salt[bucket] = salt;
+            break;
+         }
+
+         // Collision, take this bucket's keys back out and try another salt
+         for (k = 0; k <= (int)table->slot_mask; k++)
+         {
+            if (table->slots[k].index != CMB_EMPTY &&
+                  CmbBucket(table->slots[k].key) == (uint32_t)bucket)
+               table->slots[k].index = CMB_EMPTY;
+         }
       }
-   } while (index < size);
-   for (; i<257; i++)
-      ac_lookup[i] = index;
 
-   //color_cmb_list_count = sizeof(color_cmb_list) >> 3; // #bytes/4/2
-   //alpha_cmb_list_count = sizeof(alpha_cmb_list) >> 3;
+      if (table->salt[bucket] == 0)
+         return false;
+   }
+
+   return true;
+}
+
+// CountCombine - build the combiner dispatch tables
+void CountCombine(void)
+{
+   if (!CmbBuild(&cc_table, sizeof(color_cmb_list) / sizeof(COMBINER)) ||
+         !CmbBuild(&ac_table, sizeof(alpha_cmb_list) / sizeof(COMBINER)))
+   {
+      if (log_cb)
+         log_cb(RETRO_LOG_ERROR, "Combiner dispatch table could not be built\n");
+   }
+   memset(cmb_memo, 0, sizeof(cmb_memo));
 }
 
 //****************************************************************
@@ -13930,9 +14042,10 @@ void CountCombine(void)
 
 void Combine(void)
 {
-   uint32_t found, cmb_mode_a, cmb_mode_c;
-   uint32_t actual_combine, current_combine, color_combine, alpha_combine;
-   int left, right, current, last;
+   uint32_t found, memo_hit, cmb_mode_a, cmb_mode_c;
+   uint32_t actual_combine, color_combine, alpha_combine;
+   const COMBINER *color, *alpha;
+   CMB_MEMO *memo;
 
 #if 0
    FRDP (" | |- color combine: %08lx, #1: (%s-%s)*%s+%s, #2: (%s-%s)*%s+%s\n",
@@ -13983,35 +14096,18 @@ void Combine(void)
    cmb.abf1 = GR_BLEND_SRC_ALPHA;
    cmb.abf2 = GR_BLEND_ONE_MINUS_SRC_ALPHA;
 
-   // Fast, ordered search
-   current = 0x7FFFFFFF;
+   memo = &cmb_memo[CmbMix(rdp.cycle1 ^ CmbMix(rdp.cycle2)) >> (32 - CMB_MEMO_BITS)];
+   memo_hit = memo->valid && memo->cycle1 == rdp.cycle1 && memo->cycle2 == rdp.cycle2;
 
    actual_combine = cmb_mode_c;
    color_combine = actual_combine;
    if ((rdp.cycle2 & 0xFFFF) == 0x1FFF)
       actual_combine = (rdp.cycle1 << 16) | (rdp.cycle1 & 0xFFFF);
 
-   left = cc_lookup[actual_combine>>24];
-   right = cc_lookup[(actual_combine>>24)+1];
-
-   while (1)
-   {
-      last = current;
-      current = left + ((right-left) >> 1);
-      if (current == last)
-         break;  // can't be found!
-
-      current_combine = color_cmb_list[current].key;
-      if (current_combine < actual_combine)
-         left = current;
-      else if (current_combine > actual_combine)
-         right = current;
-      else
-         break;  // found it!
-   }
+   color = memo_hit ? memo->color : CmbFind(&cc_table, actual_combine);
 
    // Check if we didn't find it
-   if (actual_combine != current_combine)
+   if (!color)
    {
 #ifdef UNIMP_LOG
       if (log_cb)
@@ -14026,12 +14122,11 @@ void Combine(void)
       cc_t0();
    }
    else
-      color_cmb_list[current].func();
+      color->func();
 
    LRDP(" | |- Color done\n");
 
    // Now again for alpha
-   current = 0x7FFFFFFF;
    actual_combine = cmb_mode_a;
    alpha_combine = actual_combine;
    if ((rdp.cycle2 & 0x0FFF0000) == 0x01FF0000)
@@ -14039,30 +14134,22 @@ void Combine(void)
    if ((rdp.cycle1 & 0x0FFF0000) == 0x0FFF0000)
       actual_combine = (rdp.cycle2 & 0x0FFF0000) | ((rdp.cycle2 >> 16) & 0x00000FFF);
 
-   left = ac_lookup[(actual_combine>>20)&0xFF];
-   right = ac_lookup[((actual_combine>>20)&0xFF)+1];
+   alpha = memo_hit ? memo->alpha : CmbFind(&ac_table, actual_combine);
 
-   while (1)
+   if (!memo_hit)
    {
-      last = current;
-      current = left + ((right-left) >> 1);
-      if (current == last)
-         break;  // can't be found!
-
-      current_combine = alpha_cmb_list[current].key;
-      if (current_combine < actual_combine)
-         left = current;
-      else if (current_combine > actual_combine)
-         right = current;
-      else
-         break;  // found it!
+      memo->cycle1 = rdp.cycle1;
+      memo->cycle2 = rdp.cycle2;
+      memo->color  = color;
+      memo->alpha  = alpha;
+      memo->valid  = true;
    }
 
    // Check if we didn't find it
-   if (actual_combine != current_combine || !found)
+   if (!alpha || !found)
    {
 #ifdef UNIMP_LOG
-      if (actual_combine != current_combine)
+      if (!alpha)
       {
          if (log_cb)
             log_cb(RETRO_LOG_INFO, "ALPHA combine not found: %08x, #1: (%s-%s)*%s+%s, #2: (%s-%s)*%s+%s\n",
@@ -14076,7 +14163,7 @@ void Combine(void)
       //tex |= 3;
    }
    else
-      alpha_cmb_list[current].func();
+      alpha->func();
 
 
    if (color_combine == 0x69351fff) //text, PD, need to change texture alpha
@@ -49,6 +49,7 @@
 #include "../../../Graphics/GBI.h"
 #include "../../../Graphics/image_convert.h"
 #include "../../../Graphics/RDP/gDP_state.h"
+#include "../../../Graphics/RDP/rdram_gen.h"
 
 #include "Framebuffer_glide64.h"
 #include "TexCache.h"
@@ -280,6 +281,9 @@ static void DepthBufferRasterize(struct vertexi * vtx, int vertices, int dzdx)
    if (y1 >= g_gdp.__clip.yl)
       return;
 
+   rdram_gen_mark(g_gdp.zb_address + MAX(y1, 0) * rdp.zi_width * 2,
+         (iceil(max_y) - MAX(y1, 0) + 1) * rdp.zi_width * 2);
+
    for(;;)
    {
       int width;
@@ -924,6 +928,8 @@ void copyWhiteToRDRAM(void)
    if(g_gdp.fb_width == 0)
       return;
 
+   rdram_gen_mark(gDP.colorImage.address, (g_gdp.fb_width * gDP.colorImage.height) << 2);
+
    if(g_gdp.fb_size == G_IM_SIZ_32b)
    {
       uint32_t *ptr_dst = (uint32_t*)(gfx_info.RDRAM + gDP.colorImage.address);
@@ -970,8 +976,12 @@ void DrawWholeFrameBufferToScreen(void)
   DrawFrameBufferToScreen(&fb_info);
 
   if (!(settings.frame_buffer & fb_ref))
+  {
     memset(gfx_info.RDRAM + gDP.colorImage.address, 0,
           (gDP.colorImage.width * gDP.colorImage.height) << g_gdp.fb_size >> 1);
+    rdram_gen_mark(gDP.colorImage.address,
+          (gDP.colorImage.width * gDP.colorImage.height) << g_gdp.fb_size >> 1);
+  }
 }
 
 void CopyFrameBuffer(int32_t buffer)
@@ -992,6 +1002,8 @@ void CopyFrameBuffer(int32_t buffer)
          height -= rdp.ci_upper_bound;
    }
 
+   rdram_gen_mark(gDP.colorImage.address, (width * height) << 2);
+
    if (rdp.scale_x < 1.1f)
    {
       uint16_t * ptr_src = (uint16_t*)glide64_frameBuffer;
@@ -1231,4 +1243,5 @@ void DrawPartFrameBufferToScreen(void)
 
    DrawFrameBufferToScreen(&fb_info);
    memset(gfx_info.RDRAM + gDP.colorImage.address, 0, (gDP.colorImage.width * gDP.colorImage.height) << g_gdp.fb_size >> 1);
+   rdram_gen_mark(gDP.colorImage.address, (gDP.colorImage.width * gDP.colorImage.height) << g_gdp.fb_size >> 1);
 }
@@ -48,13 +48,13 @@
 #include "CRC.h"
 
 #include <clamping.h>
-#include <encodings/crc32.h>
 
 #include "../../../Graphics/GBI.h"
 #include "../../../Graphics/RDP/gDP_state.h"
+#include "../../../Graphics/RDP/tmem_memo.h"
 #include "../../../Graphics/image_convert.h"
+#include "../../../Graphics/texture_hash.h"
 
-int GetTexAddrUMA(int tmu, int texsize);
 static void LoadTex (int id, int tmu);
 
 uint32_t tex1[2048*2048];		// temporary texture
@@ -69,7 +69,7 @@ typedef struct TEXINFO_t
    int mask_width, mask_height;
    int width, height;
    int wid_64, line;
-   uint32_t crc;
+   uint64_t crc;
    uint32_t flags;
    int splitheight;
 } TEXINFO;
@@ -78,74 +78,293 @@ TEXINFO texinfo[2];
 int tex_found[2][MAX_TMU];
 
 //****************************************************************
-// List functions
+// Cache index
+//
+// Cached textures live in the rdp.cache[0] pool. A slot is found by crc
+// through an open addressing table (linear probing), and live slots are
+// kept on a LRU list so that texture memory and slots can be reclaimed
+// one texture at a time instead of dropping the whole cache.
+
+#define CACHE_INDEX_SIZE (MAX_CACHE * 2)
+#define CACHE_INDEX_MASK (CACHE_INDEX_SIZE - 1)
+#define CACHE_NONE       0xFFFF
+
+static uint16_t cache_index[CACHE_INDEX_SIZE];
+static uint16_t cache_free[MAX_CACHE];
+static int cache_num_free;
+
+static uint16_t lru_prev[MAX_CACHE], lru_next[MAX_CACHE];
+static uint16_t lru_head, lru_tail;
 
-typedef struct NODE_t
+// Free texture memory, sorted by address and coalesced
+typedef struct
 {
-   uint32_t	crc;
-   uintptr_t	data;
-   int		tmu;
-   int		number;
-   struct NODE_t	*pNext;
-} NODE;
+   uint32_t addr;
+   uint32_t size;
+} TMEM_BLOCK;
 
-NODE *cachelut[65536];
+static TMEM_BLOCK tmem_free[MAX_CACHE + 2];
+static int tmem_num_free;
+
+TEXCACHE_STATS texcache_stats;
+
+static uint32_t CacheIndexHome(uint64_t crc)
+{
+   return (uint32_t)(crc ^ (crc >> 32)) & CACHE_INDEX_MASK;
+}
 
-static void AddToList (NODE **list, uint32_t crc, uintptr_t data, int tmu, int number)
+static void CacheIndexAdd(int slot)
 {
-   NODE *node = (NODE*)malloc(sizeof(NODE));
-   node->crc = crc;
-   node->data = data;
-   node->tmu = tmu;
-   node->number = number;
-   node->pNext = *list;
-   *list = node;
-   rdp.n_cached[tmu] ++;
-   rdp.n_cached[tmu^1] = rdp.n_cached[tmu];
+   uint32_t i = CacheIndexHome(rdp.cache[0][slot].crc);
+
+   while (cache_index[i] != CACHE_NONE)
+      i = (i + 1) & CACHE_INDEX_MASK;
+   cache_index[i] = slot;
 }
 
-static void DeleteList (NODE **list)
+static void CacheIndexRemove(int slot)
 {
-   while (*list)
+   uint32_t i = CacheIndexHome(rdp.cache[0][slot].crc);
+   uint32_t j, k;
+
+   while (cache_index[i] != slot)
+      i = (i + 1) & CACHE_INDEX_MASK;
+
+   // backward shift deletion, keeps probe sequences unbroken
+   for (;;)
    {
-      NODE *next = (*list)->pNext;
-      free(*list);
-      *list = next;
+      cache_index[i] = CACHE_NONE;
+      j = i;
+      for (;;)
+      {
+         j = (j + 1) & CACHE_INDEX_MASK;
+         if (cache_index[j] == CACHE_NONE)
+            return;
+         k = CacheIndexHome(rdp.cache[0][cache_index[j]].crc);
+         if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j))
+            continue;
+         break;
+      }
+      cache_index[i] = cache_index[j];
+      i = j;
    }
 }
 
-void TexCacheInit(void)
+static void LruUnlink(int slot)
+{
+   if (lru_prev[slot] != CACHE_NONE)
+      lru_next[lru_prev[slot]] = lru_next[slot];
+   else
+      lru_head = lru_next[slot];
+
+   if (lru_next[slot] != CACHE_NONE)
+      lru_prev[lru_next[slot]] = lru_prev[slot];
+   else
+      lru_tail = lru_prev[slot];
+}
+
+static void LruPushHead(int slot)
+{
+   lru_prev[slot] = CACHE_NONE;
+   lru_next[slot] = lru_head;
+   if (lru_head != CACHE_NONE)
+      lru_prev[lru_head] = slot;
+   else
+      lru_tail = slot;
+   lru_head = slot;
+}
+
+static void LruTouch(int slot)
+{
+   if (lru_head == slot)
+      return;
+   LruUnlink(slot);
+   LruPushHead(slot);
+}
+
+// The free block ending at tex_max_addr is where textures not owned by
+// the cache (frame buffer drawing) go.
+static void TexMemUpdateTop(void)
+{
+   uint32_t top = voodoo.tex_max_addr;
+
+   if (tmem_num_free > 0)
+   {
+      const TMEM_BLOCK *last = &tmem_free[tmem_num_free - 1];
+      if (last->addr + last->size == voodoo.tex_max_addr)
+         top = last->addr;
+   }
+
+   voodoo.tmem_ptr[0] = top;
+   voodoo.tmem_ptr[1] = top;
+}
+
+static void TexMemReset(void)
+{
+   tmem_num_free = 0;
+   if (voodoo.tex_max_addr > offset_textures)
+   {
+      tmem_free[0].addr = offset_textures;
+      tmem_free[0].size = voodoo.tex_max_addr - offset_textures;
+      tmem_num_free = 1;
+   }
+   TexMemUpdateTop();
+   if (tmem_num_free == 0)
+      voodoo.tmem_ptr[0] = voodoo.tmem_ptr[1] = offset_textures;
+}
+
+// First fit, keeps the top of texture memory free as long as possible
+static int TexMemAlloc(uint32_t size, uint32_t *addr)
 {
    int i;
-   for (i = 0; i < 65536; i++)
-      cachelut[i] = NULL;
+
+   for (i = 0; i < tmem_num_free; i++)
+   {
+      TMEM_BLOCK *block = &tmem_free[i];
+
+      // same margin as the old bump allocator kept below tex_max_addr
+      if (block->size < size || (block->size == size &&
+               block->addr + block->size == voodoo.tex_max_addr))
+         continue;
+
+      *addr = block->addr;
+      block->addr += size;
+      block->size -= size;
+      if (block->size == 0)
+      {
+         memmove(block, block + 1, (tmem_num_free - i - 1) * sizeof(*block));
+         tmem_num_free--;
+      }
+      TexMemUpdateTop();
+      return true;
+   }
+
+   return false;
 }
 
-// Clear the texture cache for both TMUs
-// TMU : Texture Memory Unit (3Dfx Voodoo term)
-void ClearCache(void)
+static void TexMemFree(uint32_t addr, uint32_t size)
+{
+   int i = 0;
+
+   if (size == 0)
+      return;
+
+   while (i < tmem_num_free && tmem_free[i].addr < addr)
+      i++;
+
+   if (i > 0 && tmem_free[i - 1].addr + tmem_free[i - 1].size == addr)
+   {
+      // merge with the previous block, and maybe the next one
+      tmem_free[i - 1].size += size;
+      if (i < tmem_num_free && addr + size == tmem_free[i].addr)
+      {
+         tmem_free[i - 1].size += tmem_free[i].size;
+         memmove(&tmem_free[i], &tmem_free[i + 1], (tmem_num_free - i - 1) * sizeof(TMEM_BLOCK));
+         tmem_num_free--;
+      }
+   }
+   else if (i < tmem_num_free && addr + size == tmem_free[i].addr)
+   {
+      tmem_free[i].addr  = addr;
+      tmem_free[i].size += size;
+   }
+   else
+   {
+      memmove(&tmem_free[i + 1], &tmem_free[i], (tmem_num_free - i) * sizeof(TMEM_BLOCK));
+      tmem_free[i].addr = addr;
+      tmem_free[i].size = size;
+      tmem_num_free++;
+   }
+
+   TexMemUpdateTop();
+}
+
+static int CachePinned(int slot)
+{
+   const CACHE_LUT *cache = &rdp.cache[0][slot];
+   int t;
+
+   if (cache == rdp.cur_cache[0] || cache == rdp.cur_cache[1])
+      return true;
+   for (t = 0; t < MAX_TMU; t++)
+   {
+      if (tex_found[0][t] == slot || tex_found[1][t] == slot)
+         return true;
+   }
+   return false;
+}
+
+static void CacheEvict(int slot)
+{
+   CACHE_LUT *cache = &rdp.cache[0][slot];
+
+   CacheIndexRemove(slot);
+   LruUnlink(slot);
+   TexMemFree(cache->tmem_addr, cache->tmem_size);
+
+   texcache_stats.bytes -= cache->tmem_size;
+   texcache_stats.entries--;
+   texcache_stats.evictions++;
+   cache->tmem_size = 0;
+
+   cache_free[cache_num_free++] = slot;
+   rdp.n_cached[0]--;
+   rdp.n_cached[1] = rdp.n_cached[0];
+}
+
+// Evicts the least recently used texture not in use by the current
+// primitive. Returns false when there is none.
+static int CacheEvictLRU(void)
+{
+   int slot = lru_tail;
+
+   while (slot != CACHE_NONE && CachePinned(slot))
+      slot = lru_prev[slot];
+
+   if (slot == CACHE_NONE)
+      return false;
+
+   CacheEvict(slot);
+   return true;
+}
+
+static void CacheReset(void)
 {
    int i;
-   voodoo.tmem_ptr[0] = offset_textures;
+
    rdp.n_cached[0] = 0;
-   voodoo.tmem_ptr[1] = offset_textures;
    rdp.n_cached[1] = 0;
+   for (i = 0; i < CACHE_INDEX_SIZE; i++)
+      cache_index[i] = CACHE_NONE;
+   for (i = 0; i < MAX_CACHE; i++)
+      cache_free[i] = MAX_CACHE - 1 - i;
+   cache_num_free = MAX_CACHE;
+   lru_head = lru_tail = CACHE_NONE;
+   texcache_stats.entries = 0;
+   texcache_stats.bytes   = 0;
+}
 
-   for (i = 0; i < 65536; i++)
-      DeleteList(&cachelut[i]);
+void TexCacheInit(void)
+{
+   memset(&texcache_stats, 0, sizeof(texcache_stats));
+   CacheReset();
 }
 
-static uint32_t textureCRC(uint32_t crc, uint8_t *addr, int width, int height, int line)
+// Clear the texture cache for both TMUs
+// TMU : Texture Memory Unit (3Dfx Voodoo term)
+void ClearCache(void)
 {
-   const size_t len = sizeof(uint32_t) * 2 * width;
+   if (texcache_stats.entries != 0)
+      texcache_stats.flushes++;
+   CacheReset();
+   TexMemReset();
+}
 
-   while (height--)
-   {
-      crc = encoding_crc32(crc, addr, len);
-      addr += len + line;
-   }
+static uint64_t textureCRC(uint64_t crc, uint8_t *addr, int width, int height, int line)
+{
+   const size_t len = sizeof(uint32_t) * 2 * width;
 
-   return crc;
+   return texture_hash_rows(crc, addr, len, height, (ptrdiff_t)len + line);
 }
 
 /* Gets information for either t0 or t1, checks if in cache & fills tex_found */
@@ -153,8 +372,9 @@ static void GetTexInfo (int id, int tile)
 {
    int t, tile_width, tile_height, mask_width, mask_height, width, height, wid_64, line;
    int real_image_width, real_image_height, crc_height;
-   uint32_t crc, flags, mod, modcolor, modcolor1, modcolor2, modfactor, mod_mask;
-   NODE *node;
+   uint64_t crc;
+   uint32_t flags, mod, modcolor, modcolor1, modcolor2, modfactor, mod_mask;
+   uint32_t i;
    CACHE_LUT *cache;
    TEXINFO *info;
 
@@ -305,7 +525,19 @@ static void GetTexInfo (int id, int tile)
       if (crc_height > 0) // Check the CRC
       {
          if (g_gdp.tile[tile].size < 3)
-            crc = textureCRC(crc, addr, wid_64, crc_height, line);
+         {
+            /* unchanged loads give unchanged TMEM, no need to rehash it */
+            const uint32_t tmem   = g_gdp.tile[tile].tmem << 3;
+            const uint32_t size   = (line >= 0) ? crc_height * ((wid_64 << 3) + line) : 0;
+            const uint32_t params[4] = { (uint32_t)crc, (uint32_t)wid_64, (uint32_t)crc_height, (uint32_t)line };
+
+            if (size == 0 || !tmem_memo_lookup(tmem, size, params, 4, &crc))
+            {
+               crc = textureCRC(crc, addr, wid_64, crc_height, line);
+               if (size != 0)
+                  tmem_memo_store(tmem, size, params, 4, crc);
+            }
+         }
          else //32b texture
          {
             int line_2, wid_64_2;
@@ -318,7 +550,7 @@ static void GetTexInfo (int id, int tile)
    }
 
 
-   FRDP ("Done.  CRC is: %08lx.\n", crc);
+   FRDP ("Done.  CRC is: %016llx.\n", (unsigned long long)crc);
 
    flags = (g_gdp.tile[tile].cs << 23) | (g_gdp.tile[tile].ms << 22) |
       (g_gdp.tile[tile].mask_s << 18) | (g_gdp.tile[tile].ct << 17) |
@@ -360,13 +592,12 @@ static void GetTexInfo (int id, int tile)
       modfactor = cmb.modfactor_1;
    }
 
-   node = (NODE*)cachelut[crc>>16];
    mod_mask = (g_gdp.tile[tile].format == G_IM_FMT_CI) ? 0xFFFFFFFF : 0xF0F0F0F0;
-   while (node)
+   for (i = CacheIndexHome(crc); cache_index[i] != CACHE_NONE; i = (i + 1) & CACHE_INDEX_MASK)
    {
-      if (node->crc == crc)
+      cache = &rdp.cache[0][cache_index[i]];
+      if (cache->crc == crc)
       {
-         cache = (CACHE_LUT*)node->data;
          if (/*tex_found[id][node->tmu] == -1 &&
                g_gdp.tile[tile].palette == cache->palette &&
                g_gdp.tile[tile].format == cache->format &&
@@ -381,14 +612,13 @@ static void GetTexInfo (int id, int tile)
                      (cache->mod_color2&mod_mask) == (modcolor2&mod_mask) &&
                      abs((int)(cache->mod_factor - modfactor)) < 8))
             {
-               FRDP (" | | | |- Texture found in cache (tmu=%d).\n", node->tmu);
-               tex_found[id][node->tmu] = node->number;
-               tex_found[id][node->tmu^1] = node->number;
+               LRDP(" | | | |- Texture found in cache.\n");
+               tex_found[id][0] = cache_index[i];
+               tex_found[id][1] = cache_index[i];
                return;
             }
          }
       }
-      node = node->pNext;
    }
 }
 
@@ -639,6 +869,8 @@ void TexCache(void)
          CACHE_LUT *cache;
          LRDP(" | |- T0 found in cache.\n");
          cache = (CACHE_LUT*)&rdp.cache[0][tex_found[0][0]];
+         LruTouch(tex_found[0][0]);
+         texcache_stats.hits++;
          rdp.cur_cache[0] = cache;
          rdp.cur_cache[0]->last_used = frame_count;
          rdp.cur_cache[0]->uses = 0;
@@ -658,6 +890,8 @@ void TexCache(void)
          CACHE_LUT *cache;
          LRDP(" | |- T1 found in cache.\n");
          cache = (CACHE_LUT*)&rdp.cache[0][tex_found[1][0]];
+         LruTouch(tex_found[1][0]);
+         texcache_stats.hits++;
          rdp.cur_cache[1] = cache;
          rdp.cur_cache[1]->last_used = frame_count;
          rdp.cur_cache[1]->uses = 0;
@@ -734,13 +968,14 @@ static void LoadTex(int id, int tmu)
    uint32_t size_x, size_y, real_x, real_y, result;
    uint32_t mod, modcolor, modcolor1, modcolor2, modfactor;
    CACHE_LUT *cache;
+   int slot;
    int td = rdp.cur_tile + id;
 
    if (texinfo[id].width < 0 || texinfo[id].height < 0)
       return;
 
-   // Clear the cache if it's full
-   if (rdp.n_cached[tmu] >= MAX_CACHE)
+   // Make room for one more texture, clear the cache if nothing can go
+   if (cache_num_free == 0 && !CacheEvictLRU())
    {
       LRDP("Cache count reached, clearing...\n");
       ClearCache ();
@@ -749,8 +984,10 @@ static void LoadTex(int id, int tmu)
    }
 
    // Get this cache object
-   cache = &rdp.cache[0][rdp.n_cached[0]];
+   slot  = cache_free[--cache_num_free];
+   cache = &rdp.cache[0][slot];
    rdp.cur_cache[id] = cache;
+   texcache_stats.misses++;
 
    //!Hackalert
    //GoldenEye water texture. It has CI format in fact, but the game set it to RGBA
@@ -769,15 +1006,20 @@ static void LoadTex(int id, int tmu)
    cache->height     = gDP.tiles[td].height;
    cache->format     = g_gdp.tile[td].format;
    cache->size       = g_gdp.tile[td].size;
-   cache->tmem_addr  = voodoo.tmem_ptr[tmu];
+   cache->tmem_addr  = 0;
+   cache->tmem_size  = 0;
    cache->set_by     = rdp.timg.set_by;
    cache->texrecting = rdp.texrecting;
    cache->last_used  = frame_count;
    cache->uses = 0;
    cache->flags = texinfo[id].flags;
 
-   // Add this cache to the list
-   AddToList (&cachelut[cache->crc>>16], cache->crc, (uintptr_t)(cache), tmu, rdp.n_cached[tmu]);
+   // Add this cache to the index
+   CacheIndexAdd(slot);
+   LruPushHead(slot);
+   rdp.n_cached[0]++;
+   rdp.n_cached[1] = rdp.n_cached[0];
+   texcache_stats.entries++;
 
    // temporary
    cache->t_info.format = GR_TEXFMT_ARGB_1555;
@@ -1691,9 +1933,13 @@ static void LoadTex(int id, int tmu)
 
       texture_size            = grTexCalcMemRequired (t_info->largeLodLog2, t_info->aspectRatioLog2, t_info->format);
 
-      /* Check for end of memory (too many textures to fit, clear cache) */
-      if (voodoo.tmem_ptr[tmu]+texture_size >= voodoo.tex_max_addr)
+      /* Evict old textures until this one fits, clear the cache if they
+       * are all in use */
+      while (!TexMemAlloc(texture_size, &tex_addr))
       {
+         if (CacheEvictLRU())
+            continue;
+
          LRDP("Cache size reached, clearing...\n");
          ClearCache ();
 
@@ -1703,10 +1949,11 @@ static void LoadTex(int id, int tmu)
          LoadTex (id, tmu);
          /* Don't continue (already done) */
          return;
-
       }
 
-      tex_addr = GetTexAddrUMA(tmu, texture_size);
+      cache->tmem_addr = tex_addr;
+      cache->tmem_size = texture_size;
+      texcache_stats.bytes += texture_size;
       grTexSource (tmu,
             tex_addr,
             GR_MIPMAPLEVELMASK_BOTH,
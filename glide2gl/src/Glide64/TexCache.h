@@ -46,6 +46,18 @@
 extern "C" {
 #endif
 
+typedef struct
+{
+   uint64_t hits;
+   uint64_t misses;
+   uint64_t evictions;   // textures dropped to make room
+   uint64_t flushes;     // whole cache dropped
+   uint32_t entries;     // textures currently cached
+   uint32_t bytes;       // texture memory they use
+} TEXCACHE_STATS;
+
+extern TEXCACHE_STATS texcache_stats;
+
 void TexCacheInit(void);
 void TexCache(void);
 void ClearCache(void);
@@ -5,6 +5,8 @@
 #include "Util.h"
 
 #include "../../Graphics/RDP/gDP_state.h"
+#include "../../Graphics/RDP/rdram_gen.h"
+#include "../../Graphics/RDP/tmem_memo.h"
 
 void apply_shading(void *data);
 
@@ -577,9 +579,15 @@ void glide64gDPLoadBlock( uint32_t tile, uint32_t ul_s, uint32_t ul_t,
    }
 
    if (g_gdp.ti_size == G_IM_SIZ_32b)
+   {
       LoadBlock32b(tile, ul_s, ul_t, lr_s, dxt);
+      tmem_memo_forget(0, 4096);
+   }
    else
+   {
       loadBlock((uint32_t *)gfx_info.RDRAM, (uint32_t *)dst, off, _dxt, cnt);
+      tmem_memo_load(g_gdp.tile[tile].tmem << 3, cnt << 3, off, cnt << 3, _dxt, 0);
+   }
 
    g_gdp.ti_address += cnt << 3;
    g_gdp.tile[tile].tl = ul_t + ((dxt*cnt)>>11);
@@ -643,11 +651,12 @@ void glide64gDPLoadTile(uint32_t tile, uint32_t ul_s, uint32_t ul_t,
    if (g_gdp.ti_size == G_IM_SIZ_32b)
    {
       LoadTile32b(tile, ul_s, ul_t, width, height);
+      tmem_memo_forget(0, 4096);
    }
    else
    {
       uint8_t *dst, *end;
-      uint32_t wid_64;
+      uint32_t wid_64, tmem, size;
 
       // check if points to bad location
       if (offs + line_n*height > BMASK)
@@ -659,6 +668,11 @@ void glide64gDPLoadTile(uint32_t tile, uint32_t ul_s, uint32_t ul_t,
       dst    = ((uint8_t*)g_gdp.tmem) + (g_gdp.tile[tile].tmem << 3);
       end    = ((uint8_t*)g_gdp.tmem) + 4096 - (wid_64<<3);
       loadTile((uint32_t *)gfx_info.RDRAM, (uint32_t *)dst, wid_64, height, line_n, offs, (uint32_t *)end);
+
+      tmem = g_gdp.tile[tile].tmem << 3;
+      size = MIN(height * (wid_64 << 3), 4096 - MIN(tmem, 4096));
+      tmem_memo_load(tmem, size, offs, line_n * height + (wid_64 << 3),
+            wid_64 | 0x80000000, line_n);
    }
 }
 
@@ -700,6 +714,7 @@ void glide64gDPFillRectangle(uint32_t ul_x, uint32_t ul_y, uint32_t lr_x, uint32
             ul_x >>= 1;
             lr_x >>= 1;
             dst = (uint32_t*)(gfx_info.RDRAM + gDP.colorImage.address);
+            rdram_gen_mark(gDP.colorImage.address, lr_y * zi_width_in_dwords * 4);
             dst += ul_y * zi_width_in_dwords;
             for (y = ul_y; y < lr_y; y++)
             {
@@ -4,6 +4,8 @@
 #include "../../../Graphics/3dmath.h"
 #include "../../../Graphics/RDP/gDP_state.h"
 #include "../../../Graphics/RSP/gSP_state.h"
+#include "../../../Graphics/vertex_batch.h"
+#include "../../../Graphics/RSP/vertex_memo.h"
 
 #include "glide64_gDP.h"
 #include "glide64_gSP.h"
@@ -451,6 +453,173 @@ static INLINE void pre_update(void)
    }
 }
 
+static struct vertex_batch glide64_vertex_batch;
+
+static void glide64gSPVertexBatch(uint8_t *vertex, uint32_t n, uint32_t v0)
+{
+   uint32_t i;
+   uint32_t iter              = 16;
+   struct vertex_batch *batch = &glide64_vertex_batch;
+   VERTEX *vtx                = (VERTEX*)&rdp.vtx[v0];
+
+   for (i = 0; i < n; i++)
+   {
+      int16_t *rdram = (int16_t*)(vertex + i * iter);
+      uint8_t *color = vertex + i * iter + 12;
+
+      batch->y[i]                = (float)rdram[0];
+      batch->x[i]                = (float)rdram[1];
+      vtx[i].flags               = (uint16_t)rdram[2];
+      batch->z[i]                = (float)rdram[3];
+      vtx[i].ov                  = (float)rdram[4];
+      vtx[i].ou                  = (float)rdram[5];
+      vtx[i].uv_scaled           = 0;
+      vtx[i].a                   = color[0];
+
+      vtx[i].uv_calculated       = 0xFFFFFFFF;
+      vtx[i].screen_translated   = 0;
+      vtx[i].shade_mod           = 0;
+
+      batch->nx[i]               = (int8_t)color[3];
+      batch->ny[i]               = (int8_t)color[2];
+      batch->nz[i]               = (int8_t)color[1];
+   }
+
+   vertex_transform_batch(batch, n, rdp.combined);
+   vertex_project_batch(batch, n, 0.001f);
+   vertex_clip_batch(batch, n, 0.1f);
+   if (rdp.flags & FOG_ENABLED)
+      vertex_fog_batch(batch, n, gSP.fog.multiplier, gSP.fog.offset);
+
+   for (i = 0; i < n; i++)
+   {
+      vtx[i].x       = batch->x[i];
+      vtx[i].y       = batch->y[i];
+      vtx[i].z       = batch->z[i];
+      vtx[i].w       = batch->w[i];
+      vtx[i].oow     = batch->oow[i];
+      vtx[i].x_w     = batch->x_w[i];
+      vtx[i].y_w     = batch->y_w[i];
+      vtx[i].z_w     = batch->z_w[i];
+      vtx[i].scr_off = batch->clip[i];
+
+      if (rdp.flags & FOG_ENABLED)
+      {
+         vtx[i].f = batch->fog[i];
+         vtx[i].a = (uint8_t)vtx[i].f;
+      }
+      else
+         vtx[i].f = 1.0f;
+   }
+
+   if (!(gSP.geometryMode & G_LIGHTING))
+   {
+      for (i = 0; i < n; i++)
+      {
+         uint8_t *color = vertex + i * iter + 12;
+         vtx[i].r = color[3];
+         vtx[i].g = color[2];
+         vtx[i].b = color[1];
+      }
+      return;
+   }
+
+   if (settings.ucode == 2 && gSP.geometryMode & G_POINT_LIGHTING)
+   {
+      for (i = 0; i < n; i++)
+      {
+         int16_t *rdram  = (int16_t*)(vertex + i * iter);
+         float tmpvec[3] = {(float)rdram[1], (float)rdram[0], (float)rdram[3]};
+
+         vtx[i].vec[0] = batch->nx[i];
+         vtx[i].vec[1] = batch->ny[i];
+         vtx[i].vec[2] = batch->nz[i];
+         glide64gSPPointLightVertex(&vtx[i], tmpvec);
+      }
+   }
+   else
+   {
+      struct vertex_light lights[12];
+
+      for (i = 0; i < gSP.numLights; i++)
+      {
+         lights[i].dir[0] = rdp.light_vector[i][0];
+         lights[i].dir[1] = rdp.light_vector[i][1];
+         lights[i].dir[2] = rdp.light_vector[i][2];
+         lights[i].col[0] = rdp.light[i].col[0];
+         lights[i].col[1] = rdp.light[i].col[1];
+         lights[i].col[2] = rdp.light[i].col[2];
+      }
+
+      vertex_normal_batch(batch, n, NULL);
+      vertex_light_batch(batch, n, lights, gSP.numLights, rdp.light[gSP.numLights].col);
+
+      for (i = 0; i < n; i++)
+      {
+         vtx[i].vec[0] = batch->nx[i];
+         vtx[i].vec[1] = batch->ny[i];
+         vtx[i].vec[2] = batch->nz[i];
+         vtx[i].r      = (uint8_t)(255.0f * clamp_float(batch->r[i], 0.0, 1.0));
+         vtx[i].g      = (uint8_t)(255.0f * clamp_float(batch->g[i], 0.0, 1.0));
+         vtx[i].b      = (uint8_t)(255.0f * clamp_float(batch->b[i], 0.0, 1.0));
+      }
+   }
+
+   if (gSP.geometryMode & G_TEXTURE_GEN)
+   {
+      for (i = 0; i < n; i++)
+      {
+         if (gSP.geometryMode & G_TEXTURE_GEN_LINEAR)
+            calc_linear (&vtx[i]);
+         else
+            calc_sphere (&vtx[i]);
+      }
+   }
+}
+
+/* Everything a gSPVertex load depends on besides its RDRAM range. The
+ * lights at the end are only part of the key with G_LIGHTING. */
+struct glide64_vertex_key
+{
+   float combined[4][4];
+   uint32_t fog;
+   int32_t fog_multiplier;
+   int32_t fog_offset;
+   uint32_t geometryMode;
+   uint32_t ucode;
+
+   float light_vector[12][3];
+   LIGHT light[12];
+};
+
+/* Fills the key, returns its size in words or 0 when the load should not
+ * be memoized. Texture generation also depends on the current tile and
+ * texture cache, so those loads are always redone. */
+static unsigned glide64gSPVertexKey(struct glide64_vertex_key *key)
+{
+   uint32_t count;
+
+   if ((gSP.geometryMode & G_LIGHTING) && (gSP.geometryMode & G_TEXTURE_GEN))
+      return 0;
+
+   memset(key, 0, sizeof(*key));
+   memcpy(key->combined, rdp.combined, sizeof(key->combined));
+   key->fog            = rdp.flags & FOG_ENABLED;
+   key->fog_multiplier = gSP.fog.multiplier;
+   key->fog_offset     = gSP.fog.offset;
+   key->geometryMode   = gSP.geometryMode;
+   key->ucode          = settings.ucode;
+
+   if (!(gSP.geometryMode & G_LIGHTING))
+      return offsetof(struct glide64_vertex_key, light_vector) / sizeof(uint32_t);
+
+   count = MIN((uint32_t)gSP.numLights + 1, 12);
+   memcpy(key->light_vector, rdp.light_vector, sizeof(key->light_vector));
+   memcpy(key->light, rdp.light, count * sizeof(LIGHT));
+
+   return (offsetof(struct glide64_vertex_key, light) + count * sizeof(LIGHT)) / sizeof(uint32_t);
+}
+
 /*
  * Loads into the RSP vertex buffer the vertices that will be used by the 
  * gSP1Triangle commands to generate polygons.
@@ -461,87 +630,46 @@ static INLINE void pre_update(void)
  */
 void glide64gSPVertex(uint32_t v, uint32_t n, uint32_t v0)
 {
-   unsigned int i;
-   float x, y, z;
-   uint32_t iter = 16;
-   void   *vertex  = (void*)(gfx_info.RDRAM + v);
+   struct glide64_vertex_key key;
+   unsigned key_count = 0;
+   uint8_t *vertex    = gfx_info.RDRAM + v;
+   uint32_t first     = v0;
+   uint32_t total     = n;
 
    pre_update();
 
-   for (i=0; i < (n * iter); i+= iter)
+   // Static geometry loads the same vertices under the same state every
+   // frame, reuse what the last identical load produced
+   if (vertex_memo_active())
+      key_count = glide64gSPVertexKey(&key);
+
+   if (key_count)
    {
-      VERTEX *vtx = (VERTEX*)&rdp.vtx[v0 + (i / iter)];
-      int16_t *rdram    = (int16_t*)vertex;
-      uint8_t *rdram_u8 = (uint8_t*)vertex;
-      uint8_t *color = (uint8_t*)(rdram_u8 + 12);
-      y                 = (float)rdram[0];
-      x                 = (float)rdram[1];
-      vtx->flags        = (uint16_t)rdram[2];
-      z                 = (float)rdram[3];
-      vtx->ov           = (float)rdram[4];
-      vtx->ou           = (float)rdram[5];
-      vtx->uv_scaled    = 0;
-      vtx->a            = color[0];
-
-      vtx->x = x*rdp.combined[0][0] + y*rdp.combined[1][0] + z*rdp.combined[2][0] + rdp.combined[3][0];
-      vtx->y = x*rdp.combined[0][1] + y*rdp.combined[1][1] + z*rdp.combined[2][1] + rdp.combined[3][1];
-      vtx->z = x*rdp.combined[0][2] + y*rdp.combined[1][2] + z*rdp.combined[2][2] + rdp.combined[3][2];
-      vtx->w = x*rdp.combined[0][3] + y*rdp.combined[1][3] + z*rdp.combined[2][3] + rdp.combined[3][3];
-
-      vtx->uv_calculated = 0xFFFFFFFF;
-      vtx->screen_translated = 0;
-      vtx->shade_mod = 0;
-
-      if (fabs(vtx->w) < 0.001)
-         vtx->w = 0.001f;
-      vtx->oow = 1.0f / vtx->w;
-      vtx->x_w = vtx->x * vtx->oow;
-      vtx->y_w = vtx->y * vtx->oow;
-      vtx->z_w = vtx->z * vtx->oow;
-      calculateVertexFog (vtx);
-
-      gSPClipVertex(v0 + (i / iter));
+      const void *cached = vertex_memo_lookup(v, total * 16,
+            (const uint32_t*)&key, key_count, sizeof(VERTEX) * total);
 
-      if (gSP.geometryMode & G_LIGHTING)
+      if (cached)
       {
-         vtx->vec[0] = (int8_t)color[3];
-         vtx->vec[1] = (int8_t)color[2];
-         vtx->vec[2] = (int8_t)color[1];
-
-         if (settings.ucode == 2 && gSP.geometryMode & G_POINT_LIGHTING)
-         {
-            float tmpvec[3] = {x, y, z};
-            glide64gSPPointLightVertex(vtx, tmpvec);
-         }
-         else
-         {
-            NormalizeVector (vtx->vec);
-            glide64gSPLightVertex(vtx);
-         }
+         memcpy(&rdp.vtx[first], cached, sizeof(VERTEX) * total);
+         return;
+      }
+   }
 
-         if (gSP.geometryMode & G_TEXTURE_GEN)
-         {
-            if (gSP.geometryMode & G_TEXTURE_GEN_LINEAR)
-               calc_linear (vtx);
-            else
-               calc_sphere (vtx);
-         }
+   // Transform, clipping, fog and directional lights run over the whole
+   // load at once, see Graphics/vertex_batch.h
+   while (n > 0)
+   {
+      uint32_t count = MIN(n, VERTEX_BATCH_SIZE);
 
-      }
-#if 0
-      else if (gSP.geometryMode & G_ACCLAIM_LIGHTING)
-      {
-         glide64gSPPointLightVertex_Acclaim(vtx);
-      }
-#endif
-      else
-      {
-         vtx->r = color[3];
-         vtx->g = color[2];
-         vtx->b = color[1];
-      }
-      vertex = (char*)vertex + iter;
+      glide64gSPVertexBatch(vertex, count, v0);
+      vertex += count * 16;
+      v0     += count;
+      n      -= count;
    }
+
+   if (key_count)
+      vertex_memo_store(v, total * 16, (const uint32_t*)&key, key_count,
+            &rdp.vtx[first], sizeof(VERTEX) * total);
 }
 
 void glide64gSPFogFactor(int16_t fm, int16_t fo )
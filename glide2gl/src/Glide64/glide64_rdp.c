@@ -55,6 +55,7 @@
 #include "../../Graphics/RSP/gSP_funcs_C.h"
 #include "../../Graphics/RDP/RDP_state.h"
 #include "../../Graphics/RDP/gDP_state.h"
+#include "../../Graphics/RDP/rdram_gen.h"
 #include "../../Graphics/RSP/RSP_state.h"
 
 /* angrylion's macro, helps to cut overflowed values. */
@@ -485,6 +486,8 @@ static void colorimage_yoshis_story_memrect(uint16_t ul_x, uint16_t ul_y,
   if (lr_y > g_gdp.__clip.yl)
     lr_y = g_gdp.__clip.yl;
 
+  rdram_gen_mark(gDP.colorImage.address, lr_y * gDP.colorImage.width + ul_x + width);
+
   for (y = ul_y; y < lr_y; y++)
   {
     uint8_t *src = (uint8_t*)(texaddr + (y - ul_y) * tex_width);
@@ -509,6 +512,7 @@ static void colorimage_palette_modification(void)
 
    for (i = 0; i < 16; i++)
       ptr_dst[i^1] = (rdp.pal_8[i]&1) ? prim16 : env16;
+   rdram_gen_mark(gDP.colorImage.address, 32);
 }
 
 static void colorimage_zbuffer_copy(uint32_t w0, uint32_t w1)
@@ -527,6 +531,7 @@ static void colorimage_zbuffer_copy(uint32_t w0, uint32_t w1)
       c = ((c << 8) & 0xFF00) | (c >> 8);
       ptr_dst[(ul_x+x)^1] = c;
    }
+   rdram_gen_mark(gDP.colorImage.address, (ul_x + width + 1) << 1);
 }
 
 enum rdp_tex_rect_mode
@@ -1343,6 +1348,7 @@ static void rdp_setcolorimage(uint32_t w0, uint32_t w1)
             rdp.skip_drawing = false;
             break;
          case CI_COPY:
+            rdram_gen_mark(cur_fb->addr, (cur_fb->width * cur_fb->height) << 2);
             if (!rdp.motionblur || (settings.frame_buffer&fb_motionblur))
             {
                if (cur_fb->width == gDP.colorImage.width)
@@ -1372,6 +1378,7 @@ static void rdp_setcolorimage(uint32_t w0, uint32_t w1)
             }
             break;
          case CI_OLD_COPY:
+            rdram_gen_mark(cur_fb->addr, (cur_fb->width * cur_fb->height) << 2);
             if (!rdp.motionblur || (settings.frame_buffer&fb_motionblur))
             {
                if (cur_fb->width == gDP.colorImage.width)
@@ -222,16 +222,6 @@ void WriteLog(m64p_msg_level level, const char *msg, ...)
 #endif
 }
 
-int GetTexAddrUMA(int tmu, int texsize)
-{
-   int addr;
-
-   addr = voodoo.tmem_ptr[0];
-   voodoo.tmem_ptr[0] += texsize;
-   voodoo.tmem_ptr[1] = voodoo.tmem_ptr[0];
-   return addr;
-}
-
 void guLoadTextures(void)
 {
    int tbuf_size = 0;
@@ -491,6 +481,11 @@ output:   none
 *******************************************************************/
 void glide64RomClosed (void)
 {
+   if (log_cb)
+      log_cb(RETRO_LOG_INFO, "Glide64 texture cache: %llu hits, %llu misses, %llu evictions, %llu flushes\n",
+            (unsigned long long)texcache_stats.hits, (unsigned long long)texcache_stats.misses,
+            (unsigned long long)texcache_stats.evictions, (unsigned long long)texcache_stats.flushes);
+
    romopen = false;
    ReleaseGfx ();
 }
@@ -254,7 +254,7 @@ typedef struct
 // This structure forms the lookup table for cached textures
 typedef struct {
   uint32_t addr;        // address in RDRAM
-  uint32_t crc;         // CRC check
+  uint64_t crc;         // CRC check
   uint32_t palette;     // Palette #
   uint32_t width;       // width
   uint32_t height;      // height
@@ -280,6 +280,7 @@ typedef struct {
 
   GrTexInfo t_info;     // texture info (glide)
   uint32_t tmem_addr;   // addres in texture memory (glide)
+  uint32_t tmem_size;   // bytes used in texture memory
 
   int uses;             // 1 triangle that uses this texture
 
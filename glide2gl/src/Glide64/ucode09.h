@@ -491,6 +491,7 @@ static void uc9_movemem(uint32_t w0, uint32_t w1)
          {
             int dmem_addr = (idx<<3) + ofs;
             memcpy(gfx_info.RDRAM + addr, gfx_info.DMEM + dmem_addr, len);
+            rdram_gen_mark(addr, len);
          }
          break;
 
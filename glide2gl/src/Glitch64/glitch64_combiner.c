@@ -27,17 +27,23 @@
 #endif // _WIN32
 #include <math.h>
 
+#include <file/file_path.h>
+#include <retro_miscellaneous.h>
+
 #include "glide.h"
 #include "glitchmain.h"
+#include "m64p_plugin.h"
 #include "../../libretro/libretro_private.h"
 
 #include "../../Graphics/RDP/RDP_state.h"
+#include "../../Graphics/texture_hash.h"
 
 float glide64_pow(float a, float b);
 
 typedef struct _shader_program_key
 {
    int index;
+   uint64_t key;
 
    int color_combiner;
    int alpha_combiner;
@@ -76,6 +82,31 @@ static shader_program_key *shader_programs = NULL;
 static shader_program_key *current_shader  = NULL;
 
 static int number_of_programs = 0;
+
+/* shader_programs indices by packed key, open addressing */
+static int *program_table = NULL;
+static unsigned program_table_size = 0;
+
+#if !defined(HAVE_OPENGLES) || defined(HAVE_OPENGLES_3_1)
+#define HAVE_PROGRAM_BINARY
+#endif
+
+/* Linked programs are kept per game in the save directory and
+ * reloaded with glProgramBinary on the next start. */
+#define PROGRAM_CACHE_MAGIC   "G64PRG01"
+#define PROGRAM_CACHE_FIELDS  11
+
+typedef struct
+{
+   int32_t fields[PROGRAM_CACHE_FIELDS];
+   uint32_t format;
+   uint32_t length;
+} program_cache_entry;
+
+static int program_cache_enabled;
+static int program_cache_valid;
+static uint64_t program_cache_env;
+static char program_cache_path[PATH_MAX_LENGTH];
 static int color_combiner_key;
 static int alpha_combiner_key;
 static int texture0_combiner_key;
@@ -437,6 +468,323 @@ void check_link(GLuint program)
    }
 }
 
+static void shader_get_fields(const shader_program_key *shader, int32_t *fields)
+{
+   fields[0]  = shader->color_combiner;
+   fields[1]  = shader->alpha_combiner;
+   fields[2]  = shader->texture0_combiner;
+   fields[3]  = shader->texture1_combiner;
+   fields[4]  = shader->texture0_combinera;
+   fields[5]  = shader->texture1_combinera;
+   fields[6]  = shader->fog_enabled;
+   fields[7]  = shader->chroma_enabled;
+   fields[8]  = shader->dither_enabled;
+   fields[9]  = shader->three_point_filter0;
+   fields[10] = shader->three_point_filter1;
+}
+
+static void shader_set_fields(shader_program_key *shader, const int32_t *fields)
+{
+   shader->color_combiner      = fields[0];
+   shader->alpha_combiner      = fields[1];
+   shader->texture0_combiner   = fields[2];
+   shader->texture1_combiner   = fields[3];
+   shader->texture0_combinera  = fields[4];
+   shader->texture1_combinera  = fields[5];
+   shader->fog_enabled         = fields[6];
+   shader->chroma_enabled      = fields[7];
+   shader->dither_enabled      = fields[8];
+   shader->three_point_filter0 = fields[9];
+   shader->three_point_filter1 = fields[10];
+}
+
+/* The small state fields are packed as is, the six combiner keys are
+ * folded in on top of them. */
+static uint64_t shader_pack_key(const shader_program_key *shader)
+{
+   int32_t fields[PROGRAM_CACHE_FIELDS];
+   uint64_t key;
+   int i;
+
+   shader_get_fields(shader, fields);
+
+   key = (uint64_t)(fields[6] & 3) | ((uint64_t)(fields[7] & 1) << 2) |
+      ((uint64_t)(fields[8] & 1) << 3) | ((uint64_t)(fields[9] & 1) << 4) |
+      ((uint64_t)(fields[10] & 1) << 5);
+
+   for (i = 0; i < 6; i++)
+   {
+      key = (key ^ ((uint64_t)(uint32_t)fields[i] << 6)) * UINT64_C(0x9E3779B97F4A7C15);
+      key ^= key >> 29;
+   }
+
+   return key;
+}
+
+static int shader_same_key(const shader_program_key *a, const shader_program_key *b)
+{
+   return a->key == b->key &&
+      a->color_combiner == b->color_combiner &&
+      a->alpha_combiner == b->alpha_combiner &&
+      a->texture0_combiner == b->texture0_combiner &&
+      a->texture1_combiner == b->texture1_combiner &&
+      a->texture0_combinera == b->texture0_combinera &&
+      a->texture1_combinera == b->texture1_combinera &&
+      a->fog_enabled == b->fog_enabled &&
+      a->chroma_enabled == b->chroma_enabled &&
+      a->dither_enabled == b->dither_enabled &&
+      a->three_point_filter0 == b->three_point_filter0 &&
+      a->three_point_filter1 == b->three_point_filter1;
+}
+
+static void program_table_insert(int index)
+{
+   unsigned mask = program_table_size - 1;
+   unsigned i    = (unsigned)shader_programs[index].key & mask;
+
+   while (program_table[i] >= 0)
+      i = (i + 1) & mask;
+   program_table[i] = index;
+}
+
+static int program_table_grow(void)
+{
+   unsigned size = program_table_size ? program_table_size * 2 : 64;
+   int *table    = (int*)malloc(size * sizeof(int));
+   unsigned i;
+
+   if (!table)
+      return false;
+
+   free(program_table);
+   program_table      = table;
+   program_table_size = size;
+   for (i = 0; i < size; i++)
+      program_table[i] = -1;
+   for (i = 0; i < (unsigned)number_of_programs; i++)
+      program_table_insert(i);
+
+   return true;
+}
+
+static shader_program_key *program_table_find(const shader_program_key *shader)
+{
+   unsigned mask, i;
+
+   if (!program_table)
+      return NULL;
+
+   mask = program_table_size - 1;
+   for (i = (unsigned)shader->key & mask; program_table[i] >= 0; i = (i + 1) & mask)
+   {
+      shader_program_key *program = &shader_programs[program_table[i]];
+      if (shader_same_key(program, shader))
+         return program;
+   }
+
+   return NULL;
+}
+
+static void program_table_free(void)
+{
+   free(program_table);
+   program_table      = NULL;
+   program_table_size = 0;
+}
+
+#ifdef HAVE_PROGRAM_BINARY
+static void program_cache_init(void)
+{
+   const uint32_t *header = (const uint32_t*)gfx_info.HEADER;
+   const char *strings[5];
+   char name[64];
+   GLint formats = 0;
+   int i;
+
+   program_cache_enabled = false;
+   program_cache_valid   = false;
+
+   /* GL_NUM_PROGRAM_BINARY_FORMATS is unknown without program binaries */
+   glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+   while (glGetError() != GL_NO_ERROR);
+   if (formats <= 0 || !header)
+      return;
+
+   snprintf(name, sizeof(name), "glide64-%08X-%08X.shaders",
+         (unsigned)header[4], (unsigned)header[5]);
+   fill_pathname_join(program_cache_path, retro_get_save_directory(),
+         name, sizeof(program_cache_path));
+
+   /* binaries only stay valid for the same driver and shader sources */
+   strings[0] = (const char*)glGetString(GL_RENDERER);
+   strings[1] = (const char*)glGetString(GL_VERSION);
+   strings[2] = vertex_shader;
+   strings[3] = fragment_shader_header;
+   strings[4] = fragment_shader_end;
+
+   program_cache_env = 0;
+   for (i = 0; i < 5; i++)
+   {
+      if (strings[i])
+         program_cache_env = texture_hash(program_cache_env, strings[i], strlen(strings[i]));
+   }
+
+   program_cache_enabled = true;
+}
+
+static int program_cache_write_program(FILE *fp, const shader_program_key *shader)
+{
+   program_cache_entry entry;
+   GLint length = 0;
+   GLenum format = 0;
+   void *binary;
+   int ok;
+
+   glGetProgramiv(shader->program_object, GL_PROGRAM_BINARY_LENGTH, &length);
+   if (length <= 0 || !(binary = malloc(length)))
+      return false;
+
+   glGetProgramBinary(shader->program_object, length, &length, &format, binary);
+
+   shader_get_fields(shader, entry.fields);
+   entry.format = format;
+   entry.length = length;
+
+   ok = fwrite(&entry, sizeof(entry), 1, fp) == 1 &&
+      fwrite(binary, length, 1, fp) == 1;
+
+   free(binary);
+   return ok;
+}
+
+/* Writes every program but the default one, index 0 */
+static void program_cache_rewrite(void)
+{
+   FILE *fp = fopen(program_cache_path, "wb");
+   int i;
+
+   program_cache_valid = false;
+   if (!fp)
+      return;
+
+   if (fwrite(PROGRAM_CACHE_MAGIC, 8, 1, fp) == 1 &&
+         fwrite(&program_cache_env, sizeof(program_cache_env), 1, fp) == 1)
+   {
+      program_cache_valid = true;
+      for (i = 1; i < number_of_programs; i++)
+         program_cache_write_program(fp, &shader_programs[i]);
+   }
+
+   fclose(fp);
+}
+
+static void program_cache_append(const shader_program_key *shader)
+{
+   FILE *fp;
+
+   if (!program_cache_enabled)
+      return;
+
+   if (!program_cache_valid)
+   {
+      program_cache_rewrite();
+      return;
+   }
+
+   fp = fopen(program_cache_path, "ab");
+   if (!fp)
+      return;
+   program_cache_write_program(fp, shader);
+   fclose(fp);
+}
+
+static void shader_find_uniforms(shader_program_key *shader);
+static void append_shader_program(shader_program_key *shader);
+
+/* Links every program seen by earlier sessions of this game up front */
+static void program_cache_load(void)
+{
+   FILE *fp;
+   char magic[8];
+   uint64_t env;
+   program_cache_entry entry;
+   int stale = false;
+
+   if (!program_cache_enabled)
+      return;
+
+   fp = fopen(program_cache_path, "rb");
+   if (!fp)
+      return;
+
+   if (fread(magic, sizeof(magic), 1, fp) != 1 ||
+         fread(&env, sizeof(env), 1, fp) != 1 ||
+         memcmp(magic, PROGRAM_CACHE_MAGIC, sizeof(magic)) != 0 ||
+         env != program_cache_env)
+   {
+      fclose(fp);
+      return;
+   }
+
+   while (fread(&entry, sizeof(entry), 1, fp) == 1)
+   {
+      shader_program_key shader;
+      GLint success = 0;
+      void *binary;
+
+      if (entry.length == 0 || entry.length > 16 * 1024 * 1024 ||
+            !(binary = malloc(entry.length)))
+      {
+         stale = true;
+         break;
+      }
+
+      if (fread(binary, entry.length, 1, fp) != 1)
+      {
+         free(binary);
+         stale = true;
+         break;
+      }
+
+      memset(&shader, 0, sizeof(shader));
+      shader_set_fields(&shader, entry.fields);
+      shader.key = shader_pack_key(&shader);
+
+      shader.program_object = glCreateProgram();
+      glProgramBinary(shader.program_object, entry.format, binary, entry.length);
+      free(binary);
+      glGetProgramiv(shader.program_object, GL_LINK_STATUS, &success);
+
+      if (!success || program_table_find(&shader))
+      {
+         glDeleteProgram(shader.program_object);
+         stale = true;
+         continue;
+      }
+
+      shader_find_uniforms(&shader);
+      append_shader_program(&shader);
+   }
+
+   fclose(fp);
+   while (glGetError() != GL_NO_ERROR);
+
+   if (log_cb)
+      log_cb(RETRO_LOG_INFO, "Glide64: %d shader programs loaded from %s\n",
+            number_of_programs - 1, program_cache_path);
+
+   /* drop what the driver refused, keep the rest */
+   if (stale)
+      program_cache_rewrite();
+   else
+      program_cache_valid = true;
+}
+#else
+static void program_cache_init(void) { program_cache_enabled = false; }
+static void program_cache_load(void) { }
+static void program_cache_append(const shader_program_key *shader) { }
+#endif
+
 static void append_shader_program(shader_program_key *shader)
 {
    int curr_index;
@@ -465,6 +813,11 @@ static void append_shader_program(shader_program_key *shader)
    shader_programs[index] = *shader;
 
    ++number_of_programs;
+
+   if ((unsigned)number_of_programs * 2 > program_table_size)
+      program_table_grow();
+   else
+      program_table_insert(index);
 }
 
 static void shader_bind_attributes(shader_program_key *shader)
@@ -520,6 +873,11 @@ static void finish_shader_program_setup(shader_program_key *shader)
 
    shader_bind_attributes(shader);
 
+#ifdef HAVE_PROGRAM_BINARY
+   if (program_cache_enabled)
+      glProgramParameteri(shader->program_object, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
    glLinkProgram(shader->program_object);
    check_link(shader->program_object);
    glUseProgram(shader->program_object);
@@ -534,6 +892,7 @@ void init_combiner(void)
 
    if (shader_programs)
       free(shader_programs);
+   program_table_free();
 
    number_of_programs = 0;
    shader_programs    = NULL;
@@ -543,6 +902,7 @@ void init_combiner(void)
 
    /* default shader */
    memset(&shader, 0, sizeof(shader));
+   shader.key = shader_pack_key(&shader);
 
    strcpy(fragment_shader, fragment_shader_header);
    strcat(fragment_shader, fragment_shader_default);
@@ -553,10 +913,14 @@ void init_combiner(void)
    glCompileShader(vertex_shader_object);
    check_compile(vertex_shader_object);
 
+   program_cache_init();
+
    finish_shader_program_setup(&shader);
    program_object_default = shader.program_object;
 
-   use_shader_program(&shader);
+   program_cache_load();
+
+   use_shader_program(&shader_programs[0]);
 
    glUniform1i(shader.texture0_location, 0);
    glUniform1i(shader.texture1_location, 1);
@@ -661,34 +1025,22 @@ static void update_uniforms(const shader_program_key *prog)
    set_lambda();
 }
 
+static char *shader_append(char *dst, const char *src)
+{
+   size_t len = strlen(src);
+   memcpy(dst, src, len + 1);
+   return dst + len;
+}
+
 void compile_shader(void)
 {
    shader_program_key shader;
-   int i;
+   shader_program_key *program;
+   char *end;
 
    need_to_compile = 0;
 
-   for( i = 0; i < number_of_programs; i++)
-   {
-      shader_program_key *program = &shader_programs[i];
-      if(program->color_combiner == color_combiner_key &&
-            program->alpha_combiner == alpha_combiner_key &&
-            program->texture0_combiner == texture0_combiner_key &&
-            program->texture1_combiner == texture1_combiner_key &&
-            program->texture0_combinera == texture0_combinera_key &&
-            program->texture1_combinera == texture1_combinera_key &&
-            program->fog_enabled == fog_enabled &&
-            program->chroma_enabled == chroma_enabled &&
-            program->dither_enabled == dither_enabled &&
-            program->three_point_filter0 == three_point_filter[0] &&
-            program->three_point_filter1 == three_point_filter[1])
-      {
-         use_shader_program(program);
-         update_uniforms(program);
-         return;
-      }
-   }
-
+   memset(&shader, 0, sizeof(shader));
    shader.color_combiner        = color_combiner_key;
    shader.alpha_combiner        = alpha_combiner_key;
    shader.texture0_combiner     = texture0_combiner_key;
@@ -700,46 +1052,42 @@ void compile_shader(void)
    shader.dither_enabled        = dither_enabled;
    shader.three_point_filter0   = three_point_filter[0];
    shader.three_point_filter1   = three_point_filter[1];
-   shader.program_object        = 0;
-   shader.texture0_location     = 0;
-   shader.texture1_location     = 0;
-   shader.vertexOffset_location = 0;
-   shader.textureSizes_location = 0;
-   shader.exactSizes_location   = 0;
-   shader.fogModeEndScale_location   = 0;
-   shader.fogColor_location     = 0;
-   shader.alphaRef_location     = 0;
-   shader.chroma_color_location = 0;
-   shader.lambda_location       = 0;
-   shader.constant_color_location = 0;
-   shader.ccolor0_location      = 0;
-   shader.ccolor1_location      = 0;
+   shader.key                   = shader_pack_key(&shader);
 
-   strcpy(fragment_shader, fragment_shader_header);
+   program = program_table_find(&shader);
+   if (program)
+   {
+      use_shader_program(program);
+      update_uniforms(program);
+      return;
+   }
+
+   end = shader_append(fragment_shader, fragment_shader_header);
 
    if (dither_enabled)
-      strcat(fragment_shader, fragment_shader_dither);
+      end = shader_append(end, fragment_shader_dither);
 
-   strcat(fragment_shader, three_point_filter[0] ? fragment_shader_readtex0color_3point : fragment_shader_readtex0color);
-   strcat(fragment_shader, three_point_filter[1] ? fragment_shader_readtex1color_3point : fragment_shader_readtex1color);
-   strcat(fragment_shader, fragment_shader_texture0);
-   strcat(fragment_shader, fragment_shader_texture1);
-   strcat(fragment_shader, fragment_shader_color_combiner);
-   strcat(fragment_shader, fragment_shader_alpha_combiner);
+   end = shader_append(end, three_point_filter[0] ? fragment_shader_readtex0color_3point : fragment_shader_readtex0color);
+   end = shader_append(end, three_point_filter[1] ? fragment_shader_readtex1color_3point : fragment_shader_readtex1color);
+   end = shader_append(end, fragment_shader_texture0);
+   end = shader_append(end, fragment_shader_texture1);
+   end = shader_append(end, fragment_shader_color_combiner);
+   end = shader_append(end, fragment_shader_alpha_combiner);
 
    if (fog_enabled)
-      strcat(fragment_shader, fragment_shader_fog);
+      end = shader_append(end, fragment_shader_fog);
 
    if (chroma_enabled)
    {
-      strcat(fragment_shader, fragment_shader_chroma);
+      end = shader_append(end, fragment_shader_chroma);
       strcat(fragment_shader_texture1, "test_chroma(ctexture1); \n");
       compile_chroma_shader();
    }
 
-   strcat(fragment_shader, fragment_shader_end);
+   shader_append(end, fragment_shader_end);
 
    finish_shader_program_setup(&shader);
+   program_cache_append(&shader);
 
    update_uniforms(&shader);
 }
@@ -754,10 +1102,12 @@ void free_combiners(void)
       {
          if (glIsProgram(s->program_object))
             glDeleteProgram(s->program_object);
+         s++;
       }
 
       free(shader_programs);
    }
+   program_table_free();
 
    if (fragment_shader)
       free(fragment_shader);
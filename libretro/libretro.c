@@ -3,6 +3,8 @@
 #include <string.h>
 
 #include <libretro.h>
+#include <file/file_path.h>
+#include <retro_miscellaneous.h>
 #ifndef NO_LIBCO
 #include <libco.h>
 #endif
@@ -15,11 +17,17 @@
 #include "plugin/plugin.h"
 #include "api/m64p_types.h"
 #include "r4300/r4300.h"
+#include "r4300/event_profile.h"
+#include "r4300/idle_loop.h"
 #include "memory/memory.h"
 #include "main/main.h"
 #include "main/cheat.h"
+#include "main/profile.h"
+#include "main/rom.h"
 #include "main/version.h"
 #include "main/savestates.h"
+#include "main/save_media.h"
+#include "main/snapshot.h"
 #include "dd/dd_disk.h"
 #include "pi/pi_controller.h"
 #include "si/pif.h"
@@ -29,6 +37,7 @@
 #include "../mupen64plus-rsp-cxd4/config.h"
 #include "plugin/audio_libretro/audio_plugin.h"
 #include "../Graphics/plugin.h"
+#include "../Graphics/RSP/vertex_memo.h"
 
 #ifdef HAVE_THR_AL
 #include "../mupen64plus-video-angrylion/vdac.h"
@@ -90,9 +99,13 @@ static const struct retro_subsystem_info subsystems[] = {
 
 save_memory_data saved_memory;
 
-#ifdef NO_LIBCO
-static bool stop_stepping;
-#else
+/* The interpreters are run a frame per retro_run, returning at the VI.
+ * The dynarecs can not be left mid-frame, they run main_run on their own
+ * stack and switch back to retro_run at the VI. */
+static bool stepping;
+/* set once the VI of this retro_run has been reached */
+static bool frame_done;
+#ifndef NO_LIBCO
 cothread_t main_thread;
 static cothread_t game_thread;
 #endif
@@ -108,14 +121,16 @@ int astick_sensitivity              = 100;
 int first_time                      = 1;
 bool flip_only                      = false;
 
-static uint8_t* cart_data           = NULL;
+/* the frontend's buffers, only used until the ROM and disk are opened */
+static const uint8_t* cart_data     = NULL;
 static uint32_t cart_size           = 0;
-static uint8_t* disk_data           = NULL;
+static const uint8_t* disk_data     = NULL;
 static uint32_t disk_size           = 0;
 
 static bool     emu_initialized     = false;
 static unsigned initial_boot        = true;
 static unsigned audio_buffer_size   = 2048;
+static enum audio_resampler_type audio_resampler = AUDIO_RESAMPLER_SINC;
 
 static unsigned retro_filtering     = 0;
 static unsigned retro_dithering     = 0;
@@ -341,6 +356,8 @@ static void setup_variables(void)
 #endif
       {"parallel-n64-audio-buffer-size",
          "Audio Buffer Size (restart); 2048|1024"},
+      {"parallel-n64-audio-resampler",
+         "Audio Resampler (restart); sinc|polyphase-medium|polyphase-high|polyphase-low"},
       {"parallel-n64-astick-deadzone",
         "Analog Deadzone (percent); 15|20|25|30|0|5|10"},
       {"parallel-n64-astick-sensitivity",
@@ -391,6 +408,8 @@ static void setup_variables(void)
 #endif
       { "parallel-n64-send_allist_to_hle_rsp",
          "Send audio lists to HLE RSP; disabled|enabled" },
+      { "parallel-n64-hle-vertex-cache",
+         "(Glide64/GLN64) Reuse vertices of static geometry; disabled|enabled" },
       { "parallel-n64-gfxplugin",
          "GFX Plugin; auto|glide64|gln64|rice|angrylion"
 #if defined(HAVE_PARALLEL)
@@ -438,6 +457,13 @@ static void setup_variables(void)
       },
       { "parallel-n64-framerate",
          "Framerate (restart); original|fullspeed" },
+      { "parallel-n64-idle-loop-skip",
+         "Idle Loop Skip; enabled|disabled" },
+      { "parallel-n64-event-profile",
+         "Event Profiling (restart); disabled|stats|trace" },
+
+      { "parallel-n64-save-delay",
+         "Save Data Write Delay (frames); 30|0|15|60|120" },
 
       { "parallel-n64-alt-map",
         "Independent C-button Controls; disabled|enabled" },
@@ -507,7 +533,6 @@ static bool emu_step_load_data()
          goto load_fail;
       }
 
-      free(cart_data);
       cart_data = NULL;
 
       if (log_cb)
@@ -546,7 +571,6 @@ static bool emu_step_load_data()
          goto load_fail;
       }
 
-      free(disk_data);
       disk_data = NULL;
 
       /* 64DD IPL LOAD - assumes "64DD_IPL.bin" is in system folder */
@@ -615,9 +639,7 @@ static bool emu_step_load_data()
    return loaded;
 
 load_fail:
-   free(cart_data);
    cart_data = NULL;
-   free(disk_data);
    disk_data = NULL;
    stop = 1;
 
@@ -692,9 +714,7 @@ void reinit_gfx_plugin(void)
     if(first_context_reset)
     {
         first_context_reset = false;
-#ifndef NO_LIBCO
-        co_switch(game_thread);
-#endif
+        emu_step_initialize();
     }
 
     switch (gfx_plugin)
@@ -745,40 +765,9 @@ void deinit_gfx_plugin(void)
     }
 }
 
-#ifdef NO_LIBCO
-static void EmuThreadInit(void)
-{
-    emu_step_initialize();
-
-    initializing = false;
-
-    main_pre_run();
-}
-
-static void EmuThreadStep(void)
-{
-    stop_stepping = false;
-    main_run();
-}
-#else
+#ifndef NO_LIBCO
 static void EmuThreadFunction(void)
 {
-    if (!emu_step_load_data())
-       goto load_fail;
-
-    /* ROM is loaded, switch back to main thread
-     * so retro_load_game can return (returning failure if needed).
-     * We'll continue here once the context is reset. */
-    co_switch(main_thread);
-
-    emu_step_initialize();
-
-    /*Context is reset too, everything is safe to use.
-     * Now back to main thread so we don't start pushing
-     * frames outside retro_run. */
-    co_switch(main_thread);
-
-    initializing = false;
     main_pre_run();
     main_run();
     if (log_cb)
@@ -786,7 +775,6 @@ static void EmuThreadFunction(void)
 
     co_switch(main_thread);
 
-load_fail:
     /*NEVER RETURN! That's how libco rolls */
     while(1)
     {
@@ -797,6 +785,58 @@ load_fail:
 }
 #endif
 
+static void emu_step_start(void)
+{
+   initializing = false;
+
+#ifndef NO_LIBCO
+   if (!r4300_can_step())
+   {
+      stepping    = false;
+      main_thread = co_active();
+      game_thread = co_create(65536 * sizeof(void*) * 16, EmuThreadFunction);
+      return;
+   }
+#endif
+
+   stepping = true;
+   main_pre_run();
+}
+
+static void emu_step_frame(void)
+{
+#ifndef NO_LIBCO
+   if (!stepping)
+   {
+      co_switch(game_thread);
+      return;
+   }
+#endif
+
+   flip_only = false;
+   main_run_frame();
+}
+
+/* Lets the emulation see stop and finish */
+static void emu_step_end(void)
+{
+#ifndef NO_LIBCO
+   if (!stepping)
+   {
+      if (game_thread)
+      {
+         co_switch(game_thread);
+         co_delete(game_thread);
+         game_thread = NULL;
+      }
+      return;
+   }
+#endif
+
+   main_run_end();
+   stepping = false;
+}
+
 const char* retro_get_system_directory(void)
 {
     const char* dir;
@@ -805,6 +845,15 @@ const char* retro_get_system_directory(void)
     return dir ? dir : ".";
 }
 
+const char* retro_get_save_directory(void)
+{
+    const char* dir = NULL;
+    if (!environ_cb(RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY, &dir) || !dir)
+       return retro_get_system_directory();
+
+    return dir;
+}
+
 
 void retro_set_video_refresh(retro_video_refresh_t cb) { video_cb = cb; }
 void retro_set_audio_sample(retro_audio_sample_t cb)   { }
@@ -1002,12 +1051,6 @@ void retro_init(void)
    /* hacky stuff for Glide64 */
    polygonOffsetUnits = -3.0f;
    polygonOffsetFactor =  -3.0f;
-
-#ifndef NO_LIBCO
-   main_thread = co_active();
-   game_thread = co_create(65536 * sizeof(void*) * 16, EmuThreadFunction);
-#endif
-
 }
 
 void retro_deinit(void)
@@ -1016,7 +1059,9 @@ void retro_deinit(void)
    mupen_main_exit();
 
 #ifndef NO_LIBCO
-   co_delete(game_thread);
+   if (game_thread)
+      co_delete(game_thread);
+   game_thread = NULL;
 #endif
 
    deinit_audio_libretro();
@@ -1220,6 +1265,14 @@ void update_variables(bool startup)
    else
       send_allist_to_hle_rsp = false;
 
+   var.key   = "parallel-n64-hle-vertex-cache";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      vertex_memo_enable(!strcmp(var.value, "enabled"));
+   else
+      vertex_memo_enable(false);
+
    var.key   = "parallel-n64-screensize";
    var.value = NULL;
 
@@ -1252,6 +1305,21 @@ void update_variables(bool startup)
       if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
          audio_buffer_size = atoi(var.value);
 
+      var.key = "parallel-n64-audio-resampler";
+      var.value = NULL;
+
+      if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      {
+         if (!strcmp(var.value, "polyphase-low"))
+            audio_resampler = AUDIO_RESAMPLER_POLYPHASE_LOW;
+         else if (!strcmp(var.value, "polyphase-medium"))
+            audio_resampler = AUDIO_RESAMPLER_POLYPHASE_MEDIUM;
+         else if (!strcmp(var.value, "polyphase-high"))
+            audio_resampler = AUDIO_RESAMPLER_POLYPHASE_HIGH;
+         else if (!strcmp(var.value, "sinc"))
+            audio_resampler = AUDIO_RESAMPLER_SINC;
+      }
+
       var.key = "parallel-n64-gfxplugin";
       var.value = NULL;
 
@@ -1532,6 +1600,39 @@ void update_variables(bool startup)
          frame_dupe = true;
    }
 
+   var.key = "parallel-n64-idle-loop-skip";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (!strcmp(var.value, "enabled"))
+         idle_loop_enabled = 1;
+      else if (!strcmp(var.value, "disabled"))
+         idle_loop_enabled = 0;
+   }
+
+   var.key = "parallel-n64-event-profile";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value && startup)
+   {
+      if (!strcmp(var.value, "trace"))
+      {
+         char trace_path[PATH_MAX_LENGTH];
+         fill_pathname_join(trace_path, retro_get_system_directory(),
+               "parallel-n64-events.json", sizeof(trace_path));
+         event_profile_enable(1, trace_path);
+      }
+      else
+         event_profile_enable(!strcmp(var.value, "stats"), NULL);
+   }
+
+   var.key = "parallel-n64-save-delay";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      save_media_set_delay(atoi(var.value));
+
    var.key = "parallel-n64-alt-map";
    var.value = NULL;
 
@@ -1639,7 +1740,7 @@ bool retro_load_game(const struct retro_game_info *game)
    update_variables(true);
    initial_boot = false;
 
-   init_audio_libretro(audio_buffer_size);
+   init_audio_libretro(audio_buffer_size, audio_resampler);
 
 #ifdef HAVE_THR_AL
    if (gfx_plugin != GFX_ANGRYLION)
@@ -1705,25 +1806,22 @@ bool retro_load_game(const struct retro_game_info *game)
 
    if (is_cartridge_rom(game->data))
    {
-      cart_data = malloc(game->size);
+      cart_data = (const uint8_t*)game->data;
       cart_size = game->size;
-      memcpy(cart_data, game->data, game->size);
+      /* Keys the cache of the MD5 savestates check */
+      rom_set_path(game->path);
    }
    else
    {
-      disk_data = malloc(game->size);
+      disk_data = (const uint8_t*)game->data;
       disk_size = game->size;
-      memcpy(disk_data, game->data, game->size);
+      rom_set_path(NULL);
    }
 
    stop      = false;
    /* Finish ROM load before doing anything funny,
     * so we can return failure if needed. */
-#ifdef NO_LIBCO
-    emu_step_load_data();
-#else
-   co_switch(game_thread);
-#endif
+   emu_step_load_data();
 
    if (stop)
       return false;
@@ -1740,9 +1838,8 @@ bool retro_load_game_special(unsigned game_type, const struct retro_game_info *i
       if (!info[1].data || info[1].size == 0)
          return false;
       
+      disk_data = (const uint8_t*)info[1].data;
       disk_size = info[1].size;
-      disk_data = malloc(disk_size);
-      memcpy(disk_data, info[1].data, disk_size);
 
       return retro_load_game(&info[0]);
    }
@@ -1753,13 +1850,11 @@ bool retro_load_game_special(unsigned game_type, const struct retro_game_info *i
 void retro_unload_game(void)
 {
     stop = 1;
-    first_time = 1;
+    save_media_flush();
 
-#ifdef NO_LIBCO
-    EmuThreadStep();
-#else
-    co_switch(game_thread);
-#endif
+    if (!first_time)
+       emu_step_end();
+    first_time = 1;
 
     CoreDoCommand(M64CMD_ROM_CLOSE, 0, NULL);
     emu_initialized = false;
@@ -1870,6 +1965,7 @@ void retro_run (void)
 
    FAKE_SDL_TICKS += 16;
    pushed_frame = false;
+   frame_done   = false;
 
    if (reinit_screen)
    {
@@ -1912,20 +2008,16 @@ void retro_run (void)
       if (first_time)
       {
          first_time = 0;
+         /* The frontend has loaded its save RAM by now */
+         save_media_load();
          emu_step_initialize();
          /* Additional check for vioverlay not set at start */
          update_variables(false);
          gfx_set_filtering();
-#ifdef NO_LIBCO
-         EmuThreadInit();
-#endif
+         emu_step_start();
       }
 
-#ifdef NO_LIBCO
-      EmuThreadStep();
-#else
-      co_switch(game_thread);
-#endif
+      emu_step_frame();
 
       switch (gfx_plugin)
       {
@@ -1940,7 +2032,10 @@ void retro_run (void)
          case GFX_ANGRYLION:
             break;
       }
-   } while (emu_step_render());
+   } while (emu_step_render() && !frame_done);
+
+   flush_audio_libretro();
+   save_media_frame();
 }
 
 void retro_reset (void)
@@ -1953,7 +2048,10 @@ void *retro_get_memory_data(unsigned type)
    switch (type)
    {
    case RETRO_MEMORY_SYSTEM_RAM: return g_rdram;
-   case RETRO_MEMORY_SAVE_RAM:   return &saved_memory;
+   case RETRO_MEMORY_SAVE_RAM:
+      /* The frontend is about to read it, publish pending writes */
+      save_media_flush();
+      return &saved_memory;
    }
 
    return NULL;
@@ -1979,9 +2077,26 @@ size_t retro_get_memory_size(unsigned type)
    return 0;
 }
 
+/* Run-ahead and rewind states never leave this process, they are taken
+ * as in-process snapshots which keep recompiled code across loads. */
+static bool fast_savestates(void)
+{
+   int flags = 0;
+
+   if (!environ_cb(RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE, &flags))
+      return false;
+
+   return (flags & 4) != 0;
+}
+
 size_t retro_serialize_size (void)
 {
-    return 16788288 + 1024; /* < 16MB and some change... ouch */
+    size_t size = savestates_size_m64p();
+
+    if (snapshot_size() > size)
+       size = snapshot_size();
+
+    return size;
 }
 
 bool retro_serialize(void *data, size_t size)
@@ -1989,6 +2104,9 @@ bool retro_serialize(void *data, size_t size)
     if (initializing)
        return false;
 
+    if (fast_savestates())
+       return snapshot_save(data, size);
+
     if (savestates_save_m64p(data, size))
         return true;
 
@@ -2000,6 +2118,9 @@ bool retro_unserialize(const void * data, size_t size)
     if (initializing)
        return false;
 
+    if (fast_savestates() && snapshot_load(data, size))
+       return true;
+
     if (savestates_load_m64p(data, size))
         return true;
 
@@ -2106,15 +2227,6 @@ void retro_cheat_set(unsigned index, bool enabled, const char* codeLine)
 
 void vbo_disable(void);
 
-int retro_stop_stepping(void)
-{
-#ifdef NO_LIBCO
-    return stop_stepping;
-#else
-    return false;
-#endif
-}
-
 int retro_return(bool just_flipping)
 {
    if (stop)
@@ -2124,22 +2236,34 @@ int retro_return(bool just_flipping)
    vbo_disable();
 #endif
 
-#ifdef NO_LIBCO
-   if (just_flipping)
+   if (stepping)
    {
-      /* HACK: in case the VI comes before the render? is that possible?
-       * remove this when we totally remove libco */
-      flip_only = 1;
-      emu_step_render();
-      flip_only = 0;
+      /* Leave the step at the next instruction. A buffer swap and the VI
+       * can come in the same step, the swap is presented first. */
+      if (just_flipping)
+         flip_only = true;
+      else
+         frame_done = true;
+      stop_stepping = 1;
+      return 0;
    }
-   else
-      flip_only = just_flipping;
 
-   stop_stepping = true;
-#else
+#ifndef NO_LIBCO
+   /* nothing to switch back to before the emulation has started */
+   if (!game_thread)
+      return 0;
+
    flip_only = just_flipping;
-   co_switch(main_thread);
+
+   /* The frontend's time until it switches back is not part of a VI
+    * update that is in progress */
+   if (timed_section_suspend(TIMED_SECTION_VI))
+   {
+      co_switch(main_thread);
+      timed_section_start(TIMED_SECTION_VI);
+   }
+   else
+      co_switch(main_thread);
 #endif
 
    return 0;
@@ -18,6 +18,8 @@ extern retro_perf_get_counter_t perf_get_counter_cb;
 extern retro_log_printf_t log_cb;
 extern retro_perf_register_t perf_register_cb;
 int retro_return(bool just_flipping);
+const char* retro_get_system_directory(void);
+const char* retro_get_save_directory(void);
 
 #define SDL_GetTicks() FAKE_SDL_TICKS
 
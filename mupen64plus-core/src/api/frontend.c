@@ -45,6 +45,7 @@
 #include "dd/dd_rom.h"
 #include "dd/dd_disk.h"
 #include "plugin/plugin.h"
+#include "r4300/event_profile.h"
 
 /* some local state variables */
 static int l_CoreInit   = 0;
@@ -271,6 +272,28 @@ EXPORT m64p_error CALL CoreCheatClearAll(void)
     return M64ERR_SUCCESS;
 }
 
+EXPORT m64p_error CALL CoreSetEventProfiling(int Enable, const char *TracePath)
+{
+    if (!l_CoreInit)
+        return M64ERR_NOT_INIT;
+
+    if (!event_profile_enable(Enable, TracePath))
+        return M64ERR_FILES;
+
+    return M64ERR_SUCCESS;
+}
+
+EXPORT m64p_error CALL CoreGetEventProfile(m64p_event_stats *Stats, int NumTypes)
+{
+    if (!l_CoreInit)
+        return M64ERR_NOT_INIT;
+    if (Stats == NULL || NumTypes < 0)
+        return M64ERR_INPUT_ASSERT;
+
+    event_profile_get(Stats, NumTypes);
+    return M64ERR_SUCCESS;
+}
+
 EXPORT m64p_error CALL CoreGetRomSettings(m64p_rom_settings *RomSettings, int RomSettingsLength, int Crc1, int Crc2)
 {
     return M64ERR_SUCCESS;
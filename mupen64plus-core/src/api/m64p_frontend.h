@@ -97,6 +97,29 @@ EXPORT m64p_error CALL CoreCheatEnabled(const char *CheatName, int Enabled);
 
 EXPORT m64p_error CALL CoreCheatClearAll(void);
 
+/* CoreSetEventProfiling()
+ *
+ * This function turns on or off the timing of the interrupt queue event
+ * handlers. Turning profiling on clears the statistics gathered so far. If
+ * TracePath is not NULL, every handled event is also appended to a Chrome
+ * trace (JSON) file at this path, which is closed when profiling is turned
+ * off or emulation stops.
+ */
+typedef m64p_error (*ptr_CoreSetEventProfiling)(int, const char *);
+#if defined(M64P_CORE_PROTOTYPES)
+EXPORT m64p_error CALL CoreSetEventProfiling(int Enable, const char *TracePath);
+#endif
+
+/* CoreGetEventProfile()
+ *
+ * This function copies the statistics of up to NumTypes event types into the
+ * Stats array, in the order documented with m64p_event_stats.
+ */
+typedef m64p_error (*ptr_CoreGetEventProfile)(m64p_event_stats *, int);
+#if defined(M64P_CORE_PROTOTYPES)
+EXPORT m64p_error CALL CoreGetEventProfile(m64p_event_stats *Stats, int NumTypes);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -104,6 +104,17 @@ typedef struct {
     uint32_t * VI_Y_SCALE_REG;
 
     void (*CheckInterrupts)(void);
+
+    /* RDRAM write generations (extension, NULL when not provided).
+     * RDRAM_PAGE_GEN[address >> RDRAM_GEN_SHIFT] is the epoch in which
+     * the page was last written, RDRAM_GEN_EPOCH the current epoch (advanced
+     * before each display list, 0 meaning untracked) and RDRAM_GEN_FLOOR the
+     * epoch of the last write the core could not locate. */
+    uint32_t * RDRAM_PAGE_GEN;
+    uint32_t * RDRAM_GEN_EPOCH;
+    uint32_t * RDRAM_GEN_FLOOR;
+    unsigned int RDRAM_GEN_SHIFT;
+    unsigned int RDRAM_GEN_PAGES;
 } GFX_INFO;
 
 extern GFX_INFO gfx_info;
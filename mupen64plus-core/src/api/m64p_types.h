@@ -405,5 +405,27 @@ struct m64p_audio_backend
    void (*push_audio_samples)(void*, const void*, size_t);
 };
 
+/* ----------------------------------------- */
+/* Structures for the event profiler         */
+/* ----------------------------------------- */
+
+/* One entry per interrupt queue event type, indexed by the bit position of
+ * the type (VI = 0, COMPARE = 1, ... CART = 11). */
+#define M64P_EVENT_TYPES             12
+#define M64P_EVENT_HISTOGRAM_BUCKETS 16
+
+typedef struct {
+   unsigned int       type;        /* interrupt queue event type (VI_INT, AI_INT, ...) */
+   const char        *name;
+   unsigned long long count;       /* number of events handled */
+   unsigned long long total_ns;    /* host time spent in the handlers */
+   unsigned long long max_ns;
+   /* bucket 0 counts handlers shorter than 256ns, bucket i those lasting
+    * [128 << i, 256 << i) ns. The last bucket is open ended. */
+   unsigned long long histogram[M64P_EVENT_HISTOGRAM_BUCKETS];
+   unsigned long long depth_sum;   /* queued events (this one included), summed over count */
+   unsigned int       max_depth;
+} m64p_event_stats;
+
 #endif /* define M64P_TYPES_H */
 
@@ -289,9 +289,42 @@ void dd_update_bm(void *opaque)
 	}
 }
 
+/* Copies size bytes between the disk image and the sector buffer, which
+ * holds them as native 32-bit words, a word at a time. Sectors are whole
+ * words, any tail is copied byte by byte. */
+static void dd_copy_sector(uint8_t* disk, uint8_t* buf, unsigned int size,
+      int write)
+{
+   unsigned int i;
+   uint32_t word;
+
+   for (i = 0; i + 4 <= size; i += 4)
+   {
+      if (write)
+      {
+         memcpy(&word, &buf[i], 4);
+         word = m64p_swap32(word);
+         memcpy(&disk[i], &word, 4);
+      }
+      else
+      {
+         memcpy(&word, &disk[i], 4);
+         word = m64p_swap32(word);
+         memcpy(&buf[i], &word, 4);
+      }
+   }
+
+   for (; i < size; i++)
+   {
+      if (write)
+         disk[i] = buf[i ^ 3];
+      else
+         buf[i ^ 3] = disk[i];
+   }
+}
+
 void dd_write_sector(void *opaque)
 {
-   unsigned i;
    int Cur_Sector, offset;
 	struct dd_controller *dd = (struct dd_controller *) opaque;
 
@@ -304,13 +337,12 @@ void dd_write_sector(void *opaque)
 	offset += CUR_BLOCK * SECTORS_PER_BLOCK * ddZoneSecSize[dd_zone];
 	offset += (Cur_Sector - 1) * ddZoneSecSize[dd_zone];
 
-	for (i = 0; i <= (int)(dd->regs[ASIC_HOST_SECBYTE] >> 16); i++)
-		g_dd_disk[offset + i] = dd->sec_buf[i ^ 3];
+	dd_copy_sector(&g_dd_disk[offset], dd->sec_buf,
+         (dd->regs[ASIC_HOST_SECBYTE] >> 16) + 1, 1);
 }
 
 void dd_read_sector(void *opaque)
 {
-   unsigned i;
    int offset, Cur_Sector;
 	struct dd_controller *dd = (struct dd_controller *) opaque;
 
@@ -323,11 +355,29 @@ void dd_read_sector(void *opaque)
 	offset += CUR_BLOCK * SECTORS_PER_BLOCK * ddZoneSecSize[dd_zone];
 	offset += Cur_Sector * ddZoneSecSize[dd_zone];
 
-	for (i = 0; i <= (int)(dd->regs[ASIC_HOST_SECBYTE] >> 16); i++)
-		dd->sec_buf[i ^ 3] = g_dd_disk[offset + i];
+	dd_copy_sector(&g_dd_disk[offset], dd->sec_buf,
+         (dd->regs[ASIC_HOST_SECBYTE] >> 16) + 1, 0);
 }
 
 /* CONVERSION */
+
+/* Writes one track of the converted image, straight from the SDK dump
+ * track or as zeroes for a defect track (NULL in). The blocks of the dump
+ * track come in reverse order when it starts on an odd block. */
+static void dd_convert_track(uint8_t* out, const unsigned char* in,
+      uint32_t blocksize, int odd)
+{
+    if (in == NULL)
+        memset(out, 0, 2 * blocksize);
+    else if (odd)
+    {
+        memcpy(out + blocksize, in, blocksize);
+        memcpy(out, in + blocksize, blocksize);
+    }
+    else
+        memcpy(out, in, 2 * blocksize);
+}
+
 void dd_convert_to_mame(const unsigned char* diskimage)
 {
     /* Original code by Happy_ */
@@ -368,8 +418,6 @@ void dd_convert_to_mame(const unsigned char* diskimage)
     int32_t atrack = 0;
     int32_t block = 0;
     uint8_t SystemData[0xE8];
-    uint8_t BlockData0[0x100 * SECTORS_PER_BLOCK];
-    uint8_t BlockData1[0x100 * SECTORS_PER_BLOCK];
     uint32_t InOffset, OutOffset = 0;
     uint32_t InStart[16];
     uint32_t OutStart[16];
@@ -409,32 +457,16 @@ void dd_convert_to_mame(const unsigned char* diskimage)
         {
             if (atrack < 0xC && track == SystemData[0x20 + zone * 0xC + atrack])
             {
-                memset((void *)(&BlockData0), 0, BLOCKSIZE(zone));
-                memset((void *)(&BlockData1), 0, BLOCKSIZE(zone));
+                dd_convert_track(g_dd_disk + OutOffset, NULL, BLOCKSIZE(zone), 0);
                 atrack += 1;
             }
             else
             {
-                if ((block % 2) == 1)
-                {
-                	memcpy(BlockData1, diskimage + cur_offset, BLOCKSIZE(zone));
-                    cur_offset += BLOCKSIZE(zone);
-                    memcpy(BlockData0, diskimage + cur_offset, BLOCKSIZE(zone));
-                    cur_offset += BLOCKSIZE(zone);
-                }
-                else
-                {
-                    memcpy(BlockData0, diskimage + cur_offset, BLOCKSIZE(zone));
-                    cur_offset += BLOCKSIZE(zone);
-                    memcpy(BlockData1, diskimage + cur_offset, BLOCKSIZE(zone));
-                    cur_offset += BLOCKSIZE(zone);
-                }
+                dd_convert_track(g_dd_disk + OutOffset, diskimage + cur_offset, BLOCKSIZE(zone), block % 2);
+                cur_offset += TRACKSIZE(zone);
                 block = 1 - block;
             }
-            memcpy(g_dd_disk + OutOffset, &BlockData0, BLOCKSIZE(zone));
-            OutOffset += BLOCKSIZE(zone);
-            memcpy(g_dd_disk + OutOffset, &BlockData1, BLOCKSIZE(zone));
-            OutOffset += BLOCKSIZE(zone);
+            OutOffset += TRACKSIZE(zone);
         }
     }
 
@@ -447,35 +479,18 @@ void dd_convert_to_mame(const unsigned char* diskimage)
         atrack = 0xB;
         for (track = 1; track < ZoneTracks[zone] + 1; track++)
         {
+            OutOffset = OutStart[zone] + (ZoneTracks[zone] - track) * TRACKSIZE(zone);
             if (atrack > -1 && (ZoneTracks[zone] - track) == SystemData[0x20 + (zone)* 0xC + atrack])
             {
-                memset((void *)(&BlockData0), 0, BLOCKSIZE(zone));
-                memset((void *)(&BlockData1), 0, BLOCKSIZE(zone));
+                dd_convert_track(g_dd_disk + OutOffset, NULL, BLOCKSIZE(zone), 0);
                 atrack -= 1;
             }
             else
             {
-                if ((block % 2) == 1)
-                {
-                    memcpy(BlockData1, diskimage + cur_offset, BLOCKSIZE(zone));
-                    cur_offset += BLOCKSIZE(zone);
-                    memcpy(BlockData0, diskimage + cur_offset, BLOCKSIZE(zone));
-                    cur_offset += BLOCKSIZE(zone);
-                }
-                else
-                {
-                    memcpy(BlockData0, diskimage + cur_offset, BLOCKSIZE(zone));
-                    cur_offset += BLOCKSIZE(zone);
-                    memcpy(BlockData1, diskimage + cur_offset, BLOCKSIZE(zone));
-                    cur_offset += BLOCKSIZE(zone);
-                }
+                dd_convert_track(g_dd_disk + OutOffset, diskimage + cur_offset, BLOCKSIZE(zone), block % 2);
+                cur_offset += TRACKSIZE(zone);
                 block = 1 - block;
             }
-            OutOffset = OutStart[zone] + (ZoneTracks[zone] - track) * TRACKSIZE(zone);
-            memcpy(g_dd_disk + OutOffset, &BlockData0, BLOCKSIZE(zone));
-            OutOffset += BLOCKSIZE(zone);
-            memcpy(g_dd_disk + OutOffset, &BlockData1, BLOCKSIZE(zone));
-            OutOffset += BLOCKSIZE(zone);
         }
     }
 }
@@ -39,6 +39,7 @@
 #include "../r4300/r4300_core.h"
 #include "../rdp/rdp_core.h"
 #include "../rsp/rsp_core.h"
+#include "../ri/rdram_gen.h"
 #include "../ri/ri_controller.h"
 #include "../si/si_controller.h"
 #include "../vi/vi_controller.h"
@@ -374,6 +375,7 @@ void write_memory_32(uint32 addr, uint32 value){
     {
     case M64P_MEM_RDRAM:
        g_dev.ri.rdram.dram[(addr & 0xFFFFFF) >> 2] = value;
+       rdram_gen_touch_word(addr);
       CHECK_MEM(addr)
       break;
     }
@@ -27,6 +27,7 @@
 #include "api/config.h"
 
 #include "memory/memory.h"
+#include "ri/rdram_gen.h"
 #include "cheat.h"
 #include "main.h"
 #include "device.h"
@@ -47,7 +48,6 @@ typedef struct cheat_code
     unsigned int address;
     int value;
     int old_value;
-    struct list_head list;
 } cheat_code_t;
 
 typedef struct cheat
@@ -55,204 +55,322 @@ typedef struct cheat
     char *name;
     int enabled;
     int was_enabled;
-    struct list_head cheat_codes;
+    cheat_code_t *codes;
+    int num_codes;
+    size_t vi_first;       /* ops of the cheat in vi_program */
+    size_t vi_count;
     struct list_head list;
 } cheat_t;
 
+/* Cheats are compiled into flat programs whenever they change, so applying
+ * them every VI is a single pass over resolved RDRAM pointers. Conditional
+ * codes become ops which skip the ops of the code they guard. */
+enum cheat_opcode
+{
+    CHEAT_OP_WRITE8,
+    CHEAT_OP_WRITE16,
+    CHEAT_OP_SKIP_UNLESS_EQ8,
+    CHEAT_OP_SKIP_UNLESS_EQ16,
+    CHEAT_OP_SKIP_UNLESS_NE8,
+    CHEAT_OP_SKIP_UNLESS_NE16,
+    CHEAT_OP_SKIP_UNLESS_GS,
+    CHEAT_OP_SKIP
+};
+
+struct cheat_op
+{
+    uint8_t opcode;
+    uint8_t skip;          /* ops skipped when a condition fails */
+    uint16_t value;
+    uint32_t address;      /* RDRAM offset */
+    uint8_t *ptr;          /* host byte of address */
+    int *old_value;        /* saved before the first write, or NULL */
+};
+
+struct cheat_program
+{
+    struct cheat_op *ops;
+    size_t count;
+    size_t capacity;
+};
+
 /* Local variables */
 static LIST_HEAD(active_cheats);
+static struct cheat_program boot_program;
+static struct cheat_program vi_program;
+/* ops of the built-in fixes, at the start of vi_program */
+static size_t rom_fixes_count;
+/* the programs no longer match the cheats or the ROM */
+static int cheats_changed = 1;
+/* a cheat got disabled and its old values are still to be written back */
+static int cheats_restore = 0;
 extern unsigned int frame_dupe;
 
 /* Private functions */
-static uint16_t read_address_16bit(unsigned int address)
+static int is_16bit_code(unsigned int address)
 {
-    return *(uint16_t*)(((uint8_t*)g_dev.ri.rdram.dram + ((address & 0xFFFFFF)^S16)));
+    return (address & 0x01000000) != 0;
 }
 
-static uint8_t read_address_8bit(unsigned int address)
+static uint8_t *rdram_byte(unsigned int address, int is_16bit)
 {
-    return *(unsigned char *)(((unsigned char*)g_dev.ri.rdram.dram + ((address & 0xFFFFFF)^S8)));
+    return (uint8_t*)g_dev.ri.rdram.dram
+        + ((address & 0xFFFFFF) ^ (is_16bit ? S16 : S8));
 }
 
-static void update_address_16bit(unsigned int address, unsigned short new_value)
+static void write_code(unsigned int address, int is_16bit, int value)
 {
-    *(uint16_t *)(((uint8_t*)g_dev.ri.rdram.dram + ((address & 0xFFFFFF)^S16))) = new_value;
-}
+    if ((address & 0xFFFFFF) >= RDRAM_MAX_SIZE)
+        return;
 
-static void update_address_8bit(unsigned int address, unsigned char new_value)
-{
-     *(uint8_t *)(((uint8_t*)g_dev.ri.rdram.dram + ((address & 0xFFFFFF)^S8))) = new_value;
+    if (is_16bit)
+        *(uint16_t*)rdram_byte(address, 1) = (uint16_t)value;
+    else
+        *rdram_byte(address, 0) = (uint8_t)value;
+    rdram_gen_touch_word(address);
 }
 
-static int address_equal_to_8bit(unsigned int address, unsigned char value)
+/* Returns 0 when the program could not grow, the op is then left out */
+static int emit_op(struct cheat_program *program,
+        enum cheat_opcode opcode, unsigned int address, int value,
+        int *old_value)
 {
-    unsigned char value_read;
-    value_read = *(unsigned char *)(((unsigned char*)g_dev.ri.rdram.dram + ((address & 0xFFFFFF)^S8)));
-    return value_read == value;
+    struct cheat_op *op;
+
+    if (program->count == program->capacity)
+    {
+        size_t capacity = program->capacity ? program->capacity * 2 : 64;
+        struct cheat_op *ops = realloc(program->ops, capacity * sizeof(*ops));
+
+        if (ops == NULL)
+            return 0;
+        program->ops = ops;
+        program->capacity = capacity;
+    }
+
+    op = &program->ops[program->count++];
+    op->opcode    = opcode;
+    op->skip      = 0;
+    op->value     = (uint16_t)value;
+    op->address   = address & 0xFFFFFF;
+    op->ptr       = rdram_byte(address, opcode == CHEAT_OP_WRITE16
+                             || opcode == CHEAT_OP_SKIP_UNLESS_EQ16
+                             || opcode == CHEAT_OP_SKIP_UNLESS_NE16);
+    op->old_value = old_value;
+    return 1;
 }
 
-static int address_equal_to_16bit(unsigned int address, unsigned short value)
+/* Writes of a code, as run when reached or when its condition held */
+static int emit_write(struct cheat_program *program,
+        unsigned int address, int value, int *old_value)
 {
-    unsigned short value_read;
-    value_read = *(unsigned short *)(((unsigned char*)g_dev.ri.rdram.dram + ((address & 0xFFFFFF)^S16)));
-    return value_read == value;
+    switch (address & 0xFF000000)
+    {
+        case 0x80000000:
+        case 0x88000000:
+        case 0xA0000000:
+        case 0xA8000000:
+        case 0xF0000000:
+        case 0x81000000:
+        case 0x89000000:
+        case 0xA1000000:
+        case 0xA9000000:
+        case 0xF1000000:
+            if ((address & 0xFFFFFF) < RDRAM_MAX_SIZE)
+                return emit_op(program, is_16bit_code(address) ? CHEAT_OP_WRITE16 : CHEAT_OP_WRITE8,
+                        address, value, old_value);
+            break;
+        case 0xEE000000:
+            // most likely, this doesnt do anything.
+            return emit_op(program, CHEAT_OP_WRITE16, 0xF1000318, 0x0040, NULL)
+                && emit_op(program, CHEAT_OP_WRITE16, 0xF100031A, 0x0000, NULL);
+    }
+
+    return 1;
 }
 
-// individual application - returns 0 if we are supposed to skip the next cheat
-// (only really used on conditional codes)
-static int execute_cheat(unsigned int address, unsigned short value, int *old_value)
+static int is_gs_button_code(unsigned int address)
 {
-   switch (address & 0xFF000000)
-   {
-      case 0x80000000:
-      case 0x88000000:
-      case 0xA0000000:
-      case 0xA8000000:
-      case 0xF0000000:
-         // if pointer to old value is valid and uninitialized, write current value to it
-         if(old_value && (*old_value == CHEAT_CODE_MAGIC_VALUE))
-            *old_value = (int) read_address_8bit(address);
-         update_address_8bit(address,(unsigned char) value);
-         return 1;
-      case 0x81000000:
-      case 0x89000000:
-      case 0xA1000000:
-      case 0xA9000000:
-      case 0xF1000000:
-         // if pointer to old value is valid and uninitialized, write current value to it
-         if(old_value && (*old_value == CHEAT_CODE_MAGIC_VALUE))
-            *old_value = (int) read_address_16bit(address);
-         update_address_16bit(address,value);
-         return 1;
-      case 0xD0000000:
-      case 0xD8000000:
-         return address_equal_to_8bit(address,(unsigned char) value);
-      case 0xD1000000:
-      case 0xD9000000:
-         return address_equal_to_16bit(address,value);
-      case 0xD2000000:
-      case 0xDB000000:
-         return !(address_equal_to_8bit(address,(unsigned char) value));
-      case 0xD3000000:
-      case 0xDA000000:
-         return !(address_equal_to_16bit(address,value));
-      case 0xEE000000:
-         // most likely, this doesnt do anything.
-         execute_cheat(0xF1000318, 0x0040, NULL);
-         execute_cheat(0xF100031A, 0x0000, NULL);
-         return 1;
-   }
+    switch (address & 0xFF000000)
+    {
+        case 0x88000000:
+        case 0x89000000:
+        case 0xA8000000:
+        case 0xA9000000:
+        case 0xD8000000:
+        case 0xD9000000:
+        case 0xDA000000:
+        case 0xDB000000:
+            return 1;
+    }
 
-   return 1;
+    return 0;
 }
 
-static cheat_t *find_or_create_cheat(const char *name)
+/* Condition of a D code */
+static int emit_condition(struct cheat_program *program,
+        unsigned int address, int value)
 {
-    cheat_t *cheat;
-    int found = 0;
+    enum cheat_opcode opcode;
 
-    list_for_each_entry_t(cheat, &active_cheats, cheat_t, list)
+    switch (address & 0xFF000000)
     {
-        if (strcmp(cheat->name, name) == 0)
-        {
-            found = 1;
+        case 0xD0000000:
+        case 0xD8000000:
+            opcode = CHEAT_OP_SKIP_UNLESS_EQ8;
             break;
-        }
+        case 0xD1000000:
+        case 0xD9000000:
+            opcode = CHEAT_OP_SKIP_UNLESS_EQ16;
+            break;
+        case 0xD2000000:
+        case 0xDB000000:
+            opcode = CHEAT_OP_SKIP_UNLESS_NE8;
+            break;
+        case 0xD3000000:
+        case 0xDA000000:
+            opcode = CHEAT_OP_SKIP_UNLESS_NE16;
+            break;
+        default:
+            /* other D codes always hold */
+            return 1;
     }
 
-    if (found)
-    {
-        /* delete any pre-existing cheat codes */
-        cheat_code_t *code, *safe;
+    /* past RDRAM, never holds */
+    if ((address & 0xFFFFFF) >= RDRAM_MAX_SIZE)
+        opcode = CHEAT_OP_SKIP;
 
-        list_for_each_entry_safe_t(code, safe, &cheat->cheat_codes, cheat_code_t, list)
-        {
-             list_del(&code->list);
-             free(code);
-        }
+    return emit_op(program, opcode, address, value, NULL);
+}
 
-        cheat->enabled = 0;
-        cheat->was_enabled = 0;
-    }
-    else
-    {
-        cheat = malloc(sizeof(*cheat));
-        cheat->name = strdup(name);
-        cheat->enabled = 0;
-        cheat->was_enabled = 0;
-        INIT_LIST_HEAD(&cheat->cheat_codes);
-        list_add_tail(&cheat->list, &active_cheats);
-    }
+/* Sets how many ops the conditions emitted from first on skip, so each
+ * one lands past the ops emitted after it. */
+static void patch_skips(struct cheat_program *program, size_t first)
+{
+    size_t i;
 
-    return cheat;
+    for (i = first; i < program->count; i++)
+        if (program->ops[i].opcode >= CHEAT_OP_SKIP_UNLESS_EQ8)
+            program->ops[i].skip = (uint8_t)(program->count - i - 1);
 }
 
-
-// public functions
-void cheat_init(void)
+static int compile_boot(struct cheat_program *program, cheat_t *cheat)
 {
+    int i;
+
+    for (i = 0; i < cheat->num_codes; i++)
+    {
+        cheat_code_t *code = &cheat->codes[i];
+
+        // code should only be written once at boot time
+        if ((code->address & 0xF0000000) == 0xF0000000
+                && !emit_write(program, code->address, code->value, &code->old_value))
+            return 0;
+    }
+
+    return 1;
 }
 
-void cheat_uninit(void)
+static int compile_vi(struct cheat_program *program, cheat_t *cheat)
 {
+    int i;
+
+    for (i = 0; i < cheat->num_codes; i++)
+    {
+        cheat_code_t *code = &cheat->codes[i];
+
+        // conditional cheat codes
+        if ((code->address & 0xF0000000) == 0xD0000000)
+        {
+            size_t first = program->count;
+
+            // nothing to guard, the condition has no effect
+            if (i == cheat->num_codes - 1)
+                break;
+
+            // if code needs GS button pressed and it's not, skip next code
+            if (is_gs_button_code(code->address)
+                    && !emit_op(program, CHEAT_OP_SKIP_UNLESS_GS, 0, 0, NULL))
+                return 0;
+            if (!emit_condition(program, code->address, code->value))
+                return 0;
+
+            // if condition true, execute next cheat code, whatever its kind.
+            // A condition there has no effect.
+            code = &cheat->codes[++i];
+            if ((code->address & 0xF0000000) != 0xD0000000
+                    && !emit_write(program, code->address, code->value, &code->old_value))
+                return 0;
+
+            patch_skips(program, first);
+        }
+        // GS button triggers cheat code
+        else if (is_gs_button_code(code->address))
+        {
+            size_t first = program->count;
+
+            if (!emit_op(program, CHEAT_OP_SKIP_UNLESS_GS, 0, 0, NULL)
+                    || !emit_write(program, code->address, code->value, NULL))
+                return 0;
+            patch_skips(program, first);
+        }
+        // normal cheat code, excluding boot-time cheat codes
+        else if ((code->address & 0xF0000000) != 0xF0000000
+                && !emit_write(program, code->address, code->value, &code->old_value))
+            return 0;
+    }
+
+    return 1;
 }
 
-void cheat_apply_cheats(int entry)
+/* Built-in fixes, which run whether or not cheats are enabled */
+static int compile_rom_fixes(struct cheat_program *program)
 {
-    cheat_t *cheat;
-    cheat_code_t *code;
-    int skip;
-    int execute_next;
-
+    int ok = 1;
 
 #if 0
-   if ((
+   if (
          strncmp((char *)ROM_HEADER.Name, (const char *)"BANJO KAZOOIE 2", 15) == 0
          || strncmp((char *)ROM_HEADER.Name, (const char *)"BANJO TOOIE", 11) == 0
-         ) && entry == ENTRY_VI)
+         )
    {
-      execute_cheat(0x8107913C, 0x0000, NULL);
-      execute_cheat(0x8107913E, 0x0000, NULL);
+      emit_write(program, 0x8107913C, 0x0000, NULL);
+      emit_write(program, 0x8107913E, 0x0000, NULL);
    }
 #endif
 
-    // If game is Pokemon Snap, apply controller fix
-    if (strncmp((char *)ROM_HEADER.Name, "POKEMON SNAP", 12) == 0 && entry == ENTRY_VI)
+    // If game is Pokemon Snap, apply controller fix. The D1 codes these
+    // fixes come with were evaluated on their own, so they never gated
+    // the write and are left out.
+    if (strncmp((char *)ROM_HEADER.Name, "POKEMON SNAP", 12) == 0)
     {
        if (sl(ROM_HEADER.CRC1) == 0xCA12B547 && sl(ROM_HEADER.CRC2) == 0x71FA4EE4) {
           // Pokemon Snap (U)
-          execute_cheat(0xD1382D1C, 0x0002, NULL);
-          execute_cheat(0x80382D0F, 0x0000, NULL);
+          ok = emit_write(program, 0x80382D0F, 0x0000, NULL);
        }
        else if (sl(ROM_HEADER.CRC1) == 0x7BB18D40 && sl(ROM_HEADER.CRC2) == 0x83138559) {
           // Pokemon Snap (A)
-          execute_cheat(0xD1382D1C, 0x0002, NULL);
-          execute_cheat(0x80382D0F, 0x0000, NULL);
+          ok = emit_write(program, 0x80382D0F, 0x0000, NULL);
        }
        else if (sl(ROM_HEADER.CRC1) == 0x39119872 && sl(ROM_HEADER.CRC2) == 0x07722E9F) {
           // Pokemon Snap Station (U)
-          execute_cheat(0xD1382D1C, 0x0002, NULL);
-          execute_cheat(0x80382D0F, 0x0000, NULL);
+          ok = emit_write(program, 0x80382D0F, 0x0000, NULL);
        }
        else if (sl(ROM_HEADER.CRC1) == 0xEC0F690D && sl(ROM_HEADER.CRC2) == 0x32A7438C) {
           // Pokemon Snap (J) (V1.0)
-          execute_cheat(0xD136D22C, 0x802A, NULL);
-          execute_cheat(0x8036D21F, 0x0000, NULL);
+          ok = emit_write(program, 0x8036D21F, 0x0000, NULL);
        }
        else if (sl(ROM_HEADER.CRC1) == 0xE0044E9E && sl(ROM_HEADER.CRC2) == 0xCD659D0D) {
           // Pokemon Snap (J) (V1.1)
-          execute_cheat(0xD136D22C, 0x802A, NULL);
-          execute_cheat(0x8036D21F, 0x0000, NULL);
+          ok = emit_write(program, 0x8036D21F, 0x0000, NULL);
        }
        else if (sl(ROM_HEADER.CRC1) == 0x5753720D && sl(ROM_HEADER.CRC2) == 0x2A8A884D) {
           // Pokemon Snap (G)
-          execute_cheat(0xD1381BDC, 0x802C, NULL);
-          execute_cheat(0x80381BCF, 0x0000, NULL);
+          ok = emit_write(program, 0x80381BCF, 0x0000, NULL);
        }
        else {
           // Pokemon Snap (E) + (F) + (I) + (S)
-          execute_cheat(0xD1381BFC, 0x802C, NULL);
-          execute_cheat(0x80381BEF, 0x0000, NULL);
+          ok = emit_write(program, 0x80381BEF, 0x0000, NULL);
        }
     }
     else if (!strcmp((char *)ROM_HEADER.Name, "DONKEY KONG 64"))
@@ -260,11 +378,11 @@ void cheat_apply_cheats(int entry)
        switch (ROM_HEADER.destination_code)
        {
           case 'J': /* Japan */
-             execute_cheat(0x806170A2, 0x0000, NULL);
+             ok = emit_write(program, 0x806170A2, 0x0000, NULL);
              break;
           case 'A': /* Japan / USA */
           case 'E': /* USA */
-             execute_cheat(0x80619632, 0x0000, NULL);
+             ok = emit_write(program, 0x80619632, 0x0000, NULL);
              break;
           case 'D': /* Germany */
           case 'F': /* France */
@@ -276,134 +394,219 @@ void cheat_apply_cheats(int entry)
           case 0x21:
           case 0x38:
           case 0x70:
-             execute_cheat(0x806128E2, 0x0000, NULL);
+             ok = emit_write(program, 0x806128E2, 0x0000, NULL);
              break;
           default:
              break;
 
        }
     }
-    
-    if (list_empty(&active_cheats))
-        return;
+
+    return ok;
+}
+
+static void compile_cheats(void)
+{
+    cheat_t *cheat;
+
+    boot_program.count = 0;
+    vi_program.count = 0;
+
+    if (!compile_rom_fixes(&vi_program))
+        DebugMessage(M64MSG_ERROR, "Out of memory compiling the built-in ROM fixes.");
+    rom_fixes_count = vi_program.count;
 
     list_for_each_entry_t(cheat, &active_cheats, cheat_t, list)
     {
+        size_t boot_first = boot_program.count;
+
+        cheat->vi_first = vi_program.count;
         if (cheat->enabled)
         {
             cheat->was_enabled = 1;
-            switch(entry)
+
+            // a partly compiled cheat could skip the wrong ops, drop it whole
+            if (!compile_boot(&boot_program, cheat) || !compile_vi(&vi_program, cheat))
             {
-                case ENTRY_BOOT:
-                    list_for_each_entry_t(code, &cheat->cheat_codes, cheat_code_t, list)
-                    {
-                        // code should only be written once at boot time
-                        if((code->address & 0xF0000000) == 0xF0000000)
-                            execute_cheat(code->address, code->value, &code->old_value);
-                    }
-                    break;
-                case ENTRY_VI:
-                    skip = 0;
-                    execute_next = 0;
-                    list_for_each_entry_t(code, &cheat->cheat_codes, cheat_code_t, list)
-                    {
-                        if (skip)
-                        {
-                            skip = 0;
-                            continue;
-                        }
-                        if (execute_next)
-                        {
-                            execute_next = 0;
-
-                            // if code needs GS button pressed, don't save old value
-                            if(((code->address & 0xFF000000) == 0xD8000000 ||
-                                (code->address & 0xFF000000) == 0xD9000000 ||
-                                (code->address & 0xFF000000) == 0xDA000000 ||
-                                (code->address & 0xFF000000) == 0xDB000000))
-                               execute_cheat(code->address, code->value, NULL);
-                            else
-                               execute_cheat(code->address, code->value, &code->old_value);
-
-                            continue;
-                        }
-                        // conditional cheat codes
-                        if((code->address & 0xF0000000) == 0xD0000000)
-                        {
-                            // if code needs GS button pressed and it's not, skip it
-                            if(((code->address & 0xFF000000) == 0xD8000000 ||
-                                (code->address & 0xFF000000) == 0xD9000000 ||
-                                (code->address & 0xFF000000) == 0xDA000000 ||
-                                (code->address & 0xFF000000) == 0xDB000000) &&
-                               !event_gameshark_active())
-                            {
-                                // skip next code
-                                skip = 1;
-                                continue;
-                            }
-
-                            if (execute_cheat(code->address, code->value, NULL))
-                            {
-                                // if condition true, execute next cheat code
-                                execute_next = 1;
-                            }
-                            else
-                            {
-                                // if condition false, skip next code
-                                skip = 1;
-                                continue;
-                            }
-                        }
-                        // GS button triggers cheat code
-                        else if((code->address & 0xFF000000) == 0x88000000 ||
-                                (code->address & 0xFF000000) == 0x89000000 ||
-                                (code->address & 0xFF000000) == 0xA8000000 ||
-                                (code->address & 0xFF000000) == 0xA9000000)
-                        {
-                            if(event_gameshark_active())
-                                execute_cheat(code->address, code->value, NULL);
-                        }
-                        // normal cheat code
-                        else
-                        {
-                            // exclude boot-time cheat codes
-                            if((code->address & 0xF0000000) != 0xF0000000)
-                                execute_cheat(code->address, code->value, &code->old_value);
-                        }
-                    }
-                    break;
-                default:
-                    break;
+                DebugMessage(M64MSG_ERROR, "Out of memory compiling cheat '%s', it is not applied.", cheat->name);
+                boot_program.count = boot_first;
+                vi_program.count = cheat->vi_first;
             }
         }
+        cheat->vi_count = vi_program.count - cheat->vi_first;
+    }
+
+    cheats_changed = 0;
+}
+
+static void run_ops(const struct cheat_op *op, size_t count)
+{
+    const struct cheat_op *end = op + count;
+
+    for (; op < end; op++)
+    {
+        switch (op->opcode)
+        {
+            case CHEAT_OP_WRITE8:
+                // if pointer to old value is valid and uninitialized, write current value to it
+                if (op->old_value && *op->old_value == CHEAT_CODE_MAGIC_VALUE)
+                    *op->old_value = *op->ptr;
+                *op->ptr = (uint8_t)op->value;
+                rdram_gen_touch_word(op->address);
+                break;
+            case CHEAT_OP_WRITE16:
+                if (op->old_value && *op->old_value == CHEAT_CODE_MAGIC_VALUE)
+                    *op->old_value = *(uint16_t*)op->ptr;
+                *(uint16_t*)op->ptr = op->value;
+                rdram_gen_touch_word(op->address);
+                break;
+            case CHEAT_OP_SKIP_UNLESS_EQ8:
+                if (*op->ptr != (uint8_t)op->value)
+                    op += op->skip;
+                break;
+            case CHEAT_OP_SKIP_UNLESS_EQ16:
+                if (*(uint16_t*)op->ptr != op->value)
+                    op += op->skip;
+                break;
+            case CHEAT_OP_SKIP_UNLESS_NE8:
+                if (*op->ptr == (uint8_t)op->value)
+                    op += op->skip;
+                break;
+            case CHEAT_OP_SKIP_UNLESS_NE16:
+                if (*(uint16_t*)op->ptr == op->value)
+                    op += op->skip;
+                break;
+            case CHEAT_OP_SKIP_UNLESS_GS:
+                if (!event_gameshark_active())
+                    op += op->skip;
+                break;
+            case CHEAT_OP_SKIP:
+                op += op->skip;
+                break;
+        }
+    }
+}
+
+static void restore_cheat(cheat_t *cheat)
+{
+    int i;
+
+    for (i = 0; i < cheat->num_codes; i++)
+    {
+        cheat_code_t *code = &cheat->codes[i];
+
+        // set memory back to old value and clear saved copy of old value
+        if (code->old_value != CHEAT_CODE_MAGIC_VALUE)
+        {
+            write_code(code->address, is_16bit_code(code->address), code->old_value);
+            code->old_value = CHEAT_CODE_MAGIC_VALUE;
+        }
+    }
+}
+
+/* The VI program cheat by cheat, for frames where disabled cheats still
+ * have old values to write back in between */
+static void run_vi_restoring(void)
+{
+    cheat_t *cheat;
+
+    run_ops(vi_program.ops, rom_fixes_count);
+
+    list_for_each_entry_t(cheat, &active_cheats, cheat_t, list)
+    {
+        if (cheat->enabled)
+            run_ops(vi_program.ops + cheat->vi_first, cheat->vi_count);
         // if cheat was enabled, but is now disabled, restore old memory values
         else if (cheat->was_enabled)
         {
             cheat->was_enabled = 0;
-            switch(entry)
-            {
-                case ENTRY_VI:
-                    list_for_each_entry_t(code, &cheat->cheat_codes, cheat_code_t, list) {
-                        // set memory back to old value and clear saved copy of old value
-                        if(code->old_value != CHEAT_CODE_MAGIC_VALUE)
-                        {
-                            execute_cheat(code->address, code->old_value, NULL);
-                            code->old_value = CHEAT_CODE_MAGIC_VALUE;
-                        }
-                    }
-                    break;
-                default:
-                    break;
-            }
+            restore_cheat(cheat);
         }
     }
+
+    cheats_restore = 0;
+}
+
+static cheat_t *find_or_create_cheat(const char *name)
+{
+    cheat_t *cheat;
+    int found = 0;
+
+    list_for_each_entry_t(cheat, &active_cheats, cheat_t, list)
+    {
+        if (strcmp(cheat->name, name) == 0)
+        {
+            found = 1;
+            break;
+        }
+    }
+
+    if (found)
+    {
+        /* delete any pre-existing cheat codes */
+        free(cheat->codes);
+        cheat->codes = NULL;
+        cheat->num_codes = 0;
+
+        cheat->enabled = 0;
+        cheat->was_enabled = 0;
+    }
+    else
+    {
+        cheat = malloc(sizeof(*cheat));
+        cheat->name = strdup(name);
+        cheat->enabled = 0;
+        cheat->was_enabled = 0;
+        cheat->codes = NULL;
+        cheat->num_codes = 0;
+        list_add_tail(&cheat->list, &active_cheats);
+    }
+
+    return cheat;
+}
+
+
+// public functions
+void cheat_init(void)
+{
+    /* the ROM fixes depend on the ROM */
+    cheats_changed = 1;
+}
+
+void cheat_uninit(void)
+{
+    free(boot_program.ops);
+    free(vi_program.ops);
+    memset(&boot_program, 0, sizeof(boot_program));
+    memset(&vi_program, 0, sizeof(vi_program));
+    cheats_changed = 1;
+}
+
+void cheat_apply_cheats(int entry)
+{
+    if (cheats_changed)
+        compile_cheats();
+
+    switch (entry)
+    {
+        case ENTRY_BOOT:
+            run_ops(boot_program.ops, boot_program.count);
+            break;
+        case ENTRY_VI:
+            if (cheats_restore)
+                run_vi_restoring();
+            else
+                run_ops(vi_program.ops, vi_program.count);
+            break;
+        default:
+            break;
+    }
 }
 
 
 void cheat_delete_all(void)
 {
     cheat_t *cheat, *safe_cheat;
-    cheat_code_t *code, *safe_code;
 
     if (list_empty(&active_cheats))
         return;
@@ -411,15 +614,13 @@ void cheat_delete_all(void)
     list_for_each_entry_safe_t(cheat, safe_cheat, &active_cheats, cheat_t, list)
     {
         free(cheat->name);
-
-        list_for_each_entry_safe_t(code, safe_code, &cheat->cheat_codes, cheat_code_t, list)
-        {
-            list_del(&code->list);
-            free(code);
-        }
+        free(cheat->codes);
         list_del(&cheat->list);
         free(cheat);
     }
+
+    cheats_changed = 1;
+    cheats_restore = 0;
 }
 
 int cheat_set_enabled(const char *name, int enabled)
@@ -433,6 +634,10 @@ int cheat_set_enabled(const char *name, int enabled)
     {
         if (strcmp(name, cheat->name) == 0)
         {
+            if (cheat->enabled != enabled)
+                cheats_changed = 1;
+            if (!enabled && cheat->was_enabled)
+                cheats_restore = 1;
             cheat->enabled = enabled;
             return 1;
         }
@@ -444,13 +649,30 @@ int cheat_set_enabled(const char *name, int enabled)
 int cheat_add_new(const char *name, m64p_cheat_code *code_list, int num_codes)
 {
     cheat_t *cheat;
-    int i, j;
+    int i, j, count = 0;
+
+    /* count the codes once 'patch' codes are expanded */
+    for (i = 0; i < num_codes; i++)
+    {
+        if ((code_list[i].address & 0xFFFF0000) == 0x50000000 && i < num_codes - 1)
+        {
+            count += (code_list[i].address & 0xFF00) >> 8;
+            i += 1;
+        }
+        else
+            count += 1;
+    }
 
     /* create a new cheat function or erase the codes in an existing cheat function */
     cheat = find_or_create_cheat(name);
     if (cheat == NULL)
         return 0;
 
+    cheats_changed = 1;
+    cheat->codes = malloc((count ? count : 1) * sizeof(*cheat->codes));
+    if (cheat->codes == NULL)
+        return 0;
+
     cheat->enabled = 1; /* default for new cheats is enabled */
 
     for (i = 0; i < num_codes; i++)
@@ -468,11 +690,10 @@ int cheat_add_new(const char *name, m64p_cheat_code *code_list, int num_codes)
 
            for (j = 0; j < code_count; j++)
            {
-              cheat_code_t *code = malloc(sizeof(*code));
+              cheat_code_t *code = &cheat->codes[cheat->num_codes++];
               code->address = cur_addr;
               code->value = cur_value;
               code->old_value = CHEAT_CODE_MAGIC_VALUE;
-              list_add_tail(&code->list, &cheat->cheat_codes);
               cur_addr += incr_addr;
               cur_value += incr_value;
            }
@@ -480,18 +701,13 @@ int cheat_add_new(const char *name, m64p_cheat_code *code_list, int num_codes)
         else
         {
            /* just a normal code */
-           cheat_code_t *code = malloc(sizeof(*code));
+           cheat_code_t *code = &cheat->codes[cheat->num_codes++];
 
            code->address   = code_list[i].address;
            code->value     = code_list[i].value;
            code->old_value = CHEAT_CODE_MAGIC_VALUE;
-
-           list_add_tail(&code->list, &cheat->cheat_codes);
         }
     }
 
     return 1;
 }
-
-
-
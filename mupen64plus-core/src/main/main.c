@@ -48,10 +48,12 @@
 #include "device.h"
 #include "eventloop.h"
 #include "rom.h"
+#include "save_media.h"
 #include "savestates.h"
 #include "util.h"
 
 #include "../ai/ai_controller.h"
+#include "../memory/dma.h"
 #include "../memory/memory.h"
 #include "../osal/preproc.h"
 #include "../pi/pi_controller.h"
@@ -306,10 +308,6 @@ void new_vi(void)
 #endif
 }
 
-static void dummy_save(void *user_data)
-{
-}
-
 /*********************************************************************************************************
 * emulation thread - runs the core
 */
@@ -355,10 +353,13 @@ m64p_error main_init(void)
          push_audio_samples_via_libretro,
 	 ROM_PARAMS.fixedaudiopos,
          g_rom, g_rom_size,
-         NULL, dummy_save, saved_memory.flashram,
-         NULL, dummy_save, saved_memory.sram,
+         save_media_user_data(SAVE_MEDIA_FLASHRAM), save_media_written,
+         save_media_data(SAVE_MEDIA_FLASHRAM),
+         save_media_user_data(SAVE_MEDIA_SRAM), save_media_written,
+         save_media_data(SAVE_MEDIA_SRAM),
          g_rdram, (disable_extra_mem == 0) ? 0x800000 : 0x400000,
-         NULL,dummy_save,saved_memory.eeprom,
+         save_media_user_data(SAVE_MEDIA_EEPROM), save_media_written,
+         save_media_data(SAVE_MEDIA_EEPROM),
          ROM_SETTINGS.savetype != EEPROM_16KB ? 0x200  : 0x800,   /* eeprom_size */
          ROM_SETTINGS.savetype != EEPROM_16KB ? 0x8000 : 0xc000,  /* eeprom_id   */
          NULL,                                                    /* af_rtc_userdata */
@@ -394,6 +395,7 @@ m64p_error main_init(void)
 
 m64p_error main_pre_run(void)
 {
+   dma_stats_reset();
    r4300_init();
 
    return M64ERR_SUCCESS;
@@ -402,10 +404,23 @@ m64p_error main_pre_run(void)
 m64p_error main_run(void)
 {
    r4300_execute();
+   dma_stats_print();
 
    return M64ERR_SUCCESS;
 }
 
+/* Frame stepping, in place of main_run when r4300_can_step() */
+void main_run_frame(void)
+{
+   r4300_step_frame();
+}
+
+void main_run_end(void)
+{
+   r4300_finish();
+   dma_stats_print();
+}
+
 void mupen_main_stop(void)
 {
    /* note: this operation is asynchronous.  It may be called from a thread other than the
@@ -55,6 +55,8 @@ void main_message(m64p_msg_level level, unsigned int osd_corner, const char *for
 m64p_error main_init(void);
 m64p_error main_pre_run(void);
 m64p_error main_run(void);
+void main_run_frame(void);
+void main_run_end(void);
 void mupen_main_exit(void);
 void mupen_main_stop(void);
 void main_toggle_pause(void);
@@ -29,6 +29,7 @@
 
 static long long int time_in_section[NUM_TIMED_SECTIONS];
 static long long int last_start[NUM_TIMED_SECTIONS];
+static int running[NUM_TIMED_SECTIONS];
 
 #if defined(WIN32) && !defined(__MINGW32__)
   // timing
@@ -65,12 +66,23 @@ static long long int last_start[NUM_TIMED_SECTIONS];
 void timed_section_start(enum timed_section section)
 {
    last_start[section] = get_time();
+   running[section] = 1;
 }
 
 void timed_section_end(enum timed_section section)
 {
    long long int end = get_time();
    time_in_section[section] += end - last_start[section];
+   running[section] = 0;
+}
+
+int timed_section_suspend(enum timed_section section)
+{
+   if (!running[section])
+      return 0;
+
+   timed_section_end(section);
+   return 1;
 }
 
 void timed_sections_refresh()
@@ -97,5 +109,60 @@ void timed_sections_refresh()
    }
 }
 
+#else
+#include "profile.h"
+
+#include "libretro_perf.h"
+
+static struct retro_perf_counter section_counters[NUM_TIMED_SECTIONS] =
+{
+   { "n64_all" },
+   { "n64_rsp_gfx" },
+   { "n64_rsp_audio" },
+   { "n64_compiler" },
+   { "n64_idle" },
+   { "n64_rsp_other" },
+   { "n64_rdp" },
+   { "n64_vi" },
+   { "n64_ai" },
+};
+
+static int running[NUM_TIMED_SECTIONS];
+
+void timed_section_start(enum timed_section section)
+{
+   struct retro_perf_counter *counter = &section_counters[section];
+
+   if (!counter->registered)
+   {
+      if (!perf_cb.perf_register)
+         return;
+      perf_cb.perf_register(counter);
+      if (!counter->registered)
+         return;
+   }
+
+   perf_cb.perf_start(counter);
+   running[section] = 1;
+}
+
+void timed_section_end(enum timed_section section)
+{
+   struct retro_perf_counter *counter = &section_counters[section];
+
+   if (counter->registered)
+      perf_cb.perf_stop(counter);
+   running[section] = 0;
+}
+
+int timed_section_suspend(enum timed_section section)
+{
+   if (!running[section])
+      return 0;
+
+   timed_section_end(section);
+   return 1;
+}
+
 #endif
 
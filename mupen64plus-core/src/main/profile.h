@@ -31,6 +31,10 @@ enum timed_section
     TIMED_SECTION_AUDIO,
     TIMED_SECTION_COMPILER,
     TIMED_SECTION_IDLE,
+    TIMED_SECTION_RSP,
+    TIMED_SECTION_RDP,
+    TIMED_SECTION_VI,
+    TIMED_SECTION_AI,
     NUM_TIMED_SECTIONS
 };
 
@@ -39,9 +43,15 @@ enum timed_section
   void timed_section_end(enum timed_section section);
   void timed_sections_refresh(void);
 #else
-  #define timed_section_start(a)
-  #define timed_section_end(a)
+  /* Sections are reported through the frontend's performance counters */
+  void timed_section_start(enum timed_section section);
+  void timed_section_end(enum timed_section section);
   #define timed_sections_refresh()
 #endif
 
+/* Ends the section if it is running and returns whether it was, so that
+ * time spent outside the emulation, like in the frontend on a switch back
+ * to it, is left out. timed_section_start picks it up again. */
+int timed_section_suspend(enum timed_section section);
+
 #endif
@@ -24,8 +24,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <sys/stat.h>
 
 #include <boolean.h>
+#include <retro_miscellaneous.h>
 
 #define M64P_CORE_PROTOTYPES 1
 #include "api/m64p_types.h"
@@ -109,53 +111,256 @@ static int is_valid_rom(const unsigned char *buffer)
       return 0;
 }
 
-/* If rom is a .v64 or .n64 image, byteswap or wordswap loadlength amount of
- * rom data to native .z64 before forwarding. Makes sure that data extraction
- * and MD5ing routines always deal with a .z64 image.
+#define LUT_ROWS(lut) (sizeof(lut)/sizeof(lut[0]))
+
+/* Binary search of a rom_luts.c table, rows of stride values starting with
+ * the CRC id and sorted by it. Returns the matching row or NULL. */
+static const uint64_t* rom_lut_find(const uint64_t* lut, size_t rows,
+      size_t stride, uint64_t id)
+{
+   size_t lo = 0, hi = rows;
+
+   while (lo < hi)
+   {
+      size_t mid = lo + (hi - lo) / 2;
+      const uint64_t* row = lut + mid * stride;
+
+      if (row[0] == id)
+         return row;
+      if (row[0] < id)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+
+   return NULL;
+}
+
+/* Copies a .z64, .v64 or .n64 image into localrom as .z64, converting it
+ * while copying. Makes sure that data extraction routines always deal with
+ * a .z64 image.
  */
-static void swap_rom(unsigned char* localrom, unsigned char* imagetype, int loadlength)
+static void load_rom_image(unsigned char* localrom, const unsigned char* romimage,
+      unsigned int size, unsigned char* imagetype)
 {
-   unsigned char temp;
-   int i;
+   unsigned int i = 0;
+   uint32_t w;
 
-   /* Btyeswap if .v64 image. */
-   if(localrom[0]==0x37)
+   if (romimage[0] == 0x37)
    {
+      /* Byteswap */
       *imagetype = V64IMAGE;
-      for (i = 0; i < loadlength; i+=2)
+      for (; i + 4 <= size; i += 4)
       {
-         temp=localrom[i];
-         localrom[i]=localrom[i+1];
-         localrom[i+1]=temp;
+         memcpy(&w, romimage + i, 4);
+         w = ((w & 0x00ff00ff) << 8) | ((w >> 8) & 0x00ff00ff);
+         memcpy(localrom + i, &w, 4);
       }
    }
-   /* Wordswap if .n64 image. */
-   else if(localrom[0]==0x40)
+   else if (romimage[0] == 0x40)
    {
+      /* Wordswap */
       *imagetype = N64IMAGE;
-      for (i = 0; i < loadlength; i+=4)
+      for (; i + 4 <= size; i += 4)
       {
-         temp=localrom[i];
-         localrom[i]=localrom[i+3];
-         localrom[i+3]=temp;
-         temp=localrom[i+1];
-         localrom[i+1]=localrom[i+2];
-         localrom[i+2]=temp;
+         memcpy(&w, romimage + i, 4);
+         w = m64p_swap32(w);
+         memcpy(localrom + i, &w, 4);
       }
    }
    else
       *imagetype = Z64IMAGE;
+
+   /* .z64 images and a trailing partial word are copied as is */
+   memcpy(localrom + i, romimage + i, size - i);
 }
 
-m64p_error open_rom(const unsigned char* romimage, unsigned int size)
+/* Words of g_rom hashed at a time once it is in native word order */
+#define ROM_MD5_CHUNK 1024
+
+/* MD5s of the ROM files already hashed, in the save directory, one
+ * "MD5 file_size mtime rom_size path" line per file, latest first */
+#define ROM_MD5_CACHE_NAME    "parallel-n64-md5.cache"
+#define ROM_MD5_CACHE_ENTRIES 64
+#define ROM_MD5_CACHE_LINE    (PATH_MAX_LENGTH + 96)
+
+extern const char* retro_get_save_directory(void);
+
+/* The file the loaded ROM came from, empty if it is not known */
+static char rom_path[PATH_MAX_LENGTH];
+static long long rom_file_size;
+static long long rom_file_mtime;
+
+void rom_set_path(const char *path)
+{
+   struct stat st;
+
+   rom_path[0] = '\0';
+   if (path == NULL || strlen(path) >= sizeof(rom_path)
+         || strchr(path, '\n') || stat(path, &st) != 0)
+      return;
+
+   strcpy(rom_path, path);
+   rom_file_size  = (long long)st.st_size;
+   rom_file_mtime = (long long)st.st_mtime;
+}
+
+/* Splits a cache line into its MD5 and path and sets fresh if it was
+ * stored for the ROM file as it was loaded. Returns NULL for a bad line. */
+static const char *rom_md5_cache_parse(char *line, char *md5, int *fresh)
+{
+   long long file_size, file_mtime;
+   int rom_size, n = 0;
+   char *path;
+
+   if (sscanf(line, "%32s %lld %lld %d %n", md5, &file_size, &file_mtime,
+            &rom_size, &n) != 4 || n == 0 || strlen(md5) != 32)
+      return NULL;
+
+   path = line + n;
+   path[strcspn(path, "\r\n")] = '\0';
+
+   *fresh = file_size == rom_file_size && file_mtime == rom_file_mtime
+      && rom_size == g_rom_size;
+
+   return path;
+}
+
+static void rom_md5_cache_file(char *cache_path, size_t size)
+{
+   snprintf(cache_path, size, "%s/%s", retro_get_save_directory(), ROM_MD5_CACHE_NAME);
+}
+
+static int rom_md5_cache_lookup(void)
+{
+   char cache_path[PATH_MAX_LENGTH];
+   char line[ROM_MD5_CACHE_LINE];
+   char md5[33];
+   const char *path;
+   int found = 0;
+   int fresh;
+   FILE *fp;
+
+   rom_md5_cache_file(cache_path, sizeof(cache_path));
+   fp = fopen(cache_path, "r");
+   if (!fp)
+      return 0;
+
+   while (!found && fgets(line, sizeof(line), fp))
+   {
+      path = rom_md5_cache_parse(line, md5, &fresh);
+      if (path && fresh && strcmp(path, rom_path) == 0)
+      {
+         memcpy(ROM_SETTINGS.MD5, md5, 33);
+         found = 1;
+      }
+   }
+
+   fclose(fp);
+   return found;
+}
+
+/* Puts this ROM's entry first and keeps the latest entries of other files */
+static void rom_md5_cache_store(void)
+{
+   char cache_path[PATH_MAX_LENGTH];
+   char (*lines)[ROM_MD5_CACHE_LINE];
+   char line[ROM_MD5_CACHE_LINE];
+   char md5[33];
+   const char *path;
+   int count = 0;
+   int fresh;
+   int i;
+   FILE *fp;
+
+   lines = malloc(ROM_MD5_CACHE_ENTRIES * sizeof(*lines));
+   if (!lines)
+      return;
+
+   rom_md5_cache_file(cache_path, sizeof(cache_path));
+   fp = fopen(cache_path, "r");
+   if (fp)
+   {
+      while (count < ROM_MD5_CACHE_ENTRIES - 1 && fgets(line, sizeof(line), fp))
+      {
+         memcpy(lines[count], line, sizeof(line));
+         path = rom_md5_cache_parse(line, md5, &fresh);
+         if (path && strcmp(path, rom_path) != 0)
+            count++;
+      }
+      fclose(fp);
+   }
+
+   fp = fopen(cache_path, "w");
+   if (fp)
+   {
+      fprintf(fp, "%s %lld %lld %d %s\n", ROM_SETTINGS.MD5, rom_file_size,
+            rom_file_mtime, g_rom_size, rom_path);
+      for (i = 0; i < count; i++)
+         fputs(lines[i], fp);
+      fclose(fp);
+   }
+
+   free(lines);
+}
+
+const char* rom_md5(void)
 {
-#include "rom_luts.c"
    md5_state_t state;
    md5_byte_t digest[16];
+   int i;
+
+   if (ROM_SETTINGS.MD5[0] != '\0' || g_rom == NULL)
+      return ROM_SETTINGS.MD5;
+
+   if (rom_path[0] != '\0' && rom_md5_cache_lookup())
+   {
+      DebugMessage(M64MSG_INFO, "MD5: %s (cached)", ROM_SETTINGS.MD5);
+      return ROM_SETTINGS.MD5;
+   }
+
+   md5_init(&state);
+   if (g_MemHasBeenBSwapped)
+   {
+      uint32_t chunk[ROM_MD5_CHUNK];
+      const uint32_t* words = (const uint32_t*)g_rom;
+      int count = g_rom_size / 4;
+      int j, n;
+
+      for (i = 0; i < count; i += n)
+      {
+         n = count - i;
+         if (n > ROM_MD5_CHUNK)
+            n = ROM_MD5_CHUNK;
+         for (j = 0; j < n; j++)
+            chunk[j] = m64p_swap32(words[i + j]);
+         md5_append(&state, (const md5_byte_t*)chunk, n * 4);
+      }
+      md5_append(&state, (const md5_byte_t*)g_rom + count * 4, g_rom_size - count * 4);
+   }
+   else
+      md5_append(&state, (const md5_byte_t*)g_rom, g_rom_size);
+   md5_finish(&state, digest);
+
+   for (i = 0; i < 16; ++i)
+      sprintf(ROM_SETTINGS.MD5 + i*2, "%02X", digest[i]);
+   ROM_SETTINGS.MD5[32] = '\0';
+   DebugMessage(M64MSG_INFO, "MD5: %s", ROM_SETTINGS.MD5);
+
+   if (rom_path[0] != '\0')
+      rom_md5_cache_store();
+
+   return ROM_SETTINGS.MD5;
+}
+
+m64p_error open_rom(const unsigned char* romimage, unsigned int size)
+{
+#include "rom_luts.c"
    char buffer[256];
    unsigned char imagetype;
    int i;
    uint64_t lut_id;
+   const uint64_t* row;
    int patch_applied = 0;
 
    /* check input requirements */
@@ -179,19 +384,14 @@ m64p_error open_rom(const unsigned char* romimage, unsigned int size)
    g_vi_refresh_rate = DEFAULT_COUNT_PER_SCANLINE;
    if (g_rom == NULL)
       return M64ERR_NO_MEMORY;
-   memcpy(g_rom, romimage, size);
-   swap_rom(g_rom, &imagetype, g_rom_size);
+
+   load_rom_image(g_rom, romimage, size, &imagetype);
 
    memcpy(&ROM_HEADER, g_rom, sizeof(m64p_rom_header));
 
-   /* Calculate MD5 hash  */
-   md5_init(&state);
-   md5_append(&state, (const md5_byte_t*)g_rom, g_rom_size);
-   md5_finish(&state, digest);
-   for ( i = 0; i < 16; ++i )
-      sprintf(buffer+i*2, "%02X", digest[i]);
-   buffer[32] = '\0';
-   strcpy(ROM_SETTINGS.MD5, buffer);
+   /* Only savestates need the MD5, rom_md5 looks it up or computes it on
+    * first use */
+   ROM_SETTINGS.MD5[0] = '\0';
    
    ROM_SETTINGS.sidmaduration = 0x900;
 
@@ -206,121 +406,85 @@ m64p_error open_rom(const unsigned char* romimage, unsigned int size)
 
    lut_id = (((uint64_t)sl(ROM_HEADER.CRC1)) << 32) | sl(ROM_HEADER.CRC2);
 
-   for (i = 0; i < sizeof(lut_ee16k)/sizeof(lut_ee16k[0]); ++i)
+   if (rom_lut_find(lut_ee16k, LUT_ROWS(lut_ee16k), 1, lut_id))
    {
-      if (lut_ee16k[i] == lut_id)
-      {
-         strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
-         ROM_SETTINGS.savetype = EEPROM_16KB;
-         DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
+      strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
+      ROM_SETTINGS.savetype = EEPROM_16KB;
+      DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
 
-         patch_applied = 1;
-         break;
-      }
+      patch_applied = 1;
    }
 
-   for (i = 0; i < sizeof(lut_audiosignal)/sizeof(lut_audiosignal[0]); ++i)
+   if (rom_lut_find(lut_audiosignal, LUT_ROWS(lut_audiosignal), 1, lut_id))
    {
-      if (lut_audiosignal[i] == lut_id)
-      {
-         strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
-         ROM_PARAMS.audiosignal = 1;
-         DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
+      strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
+      ROM_PARAMS.audiosignal = 1;
+      DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
 
-         patch_applied = 1;
-         break;
-      }
+      patch_applied = 1;
    }
 
-   for (i = 0; i < sizeof(lut_fixedaudiopos)/sizeof(lut_fixedaudiopos[0]); ++i)
+   if (rom_lut_find(lut_fixedaudiopos, LUT_ROWS(lut_fixedaudiopos), 1, lut_id))
    {
-      if (lut_fixedaudiopos[i] == lut_id)
-      {
-         strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
-         ROM_PARAMS.fixedaudiopos = 1;
-         DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
+      strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
+      ROM_PARAMS.fixedaudiopos = 1;
+      DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
 
-         patch_applied = 1;
-         break;
-      }
+      patch_applied = 1;
    }
 
-   for (i = 0; i < sizeof(lut_alternate_vi)/sizeof(lut_alternate_vi[0]); ++i)
+   if (rom_lut_find(lut_alternate_vi, LUT_ROWS(lut_alternate_vi), 1, lut_id))
    {
-      if (lut_alternate_vi[i] == lut_id)
-      {
-         strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
-         alternate_vi_timing = 1;
-         DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
+      strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
+      alternate_vi_timing = 1;
+      DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
 
-         patch_applied = 1;
-         break;
-      }
+      patch_applied = 1;
    }
 
-   for (i = 0; i < sizeof(lut_vi_clock_1500)/sizeof(lut_vi_clock_1500[0]); ++i)
+   if (rom_lut_find(lut_vi_clock_1500, LUT_ROWS(lut_vi_clock_1500), 1, lut_id))
    {
-      if (lut_vi_clock_1500[i] == lut_id)
-      {
-         strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
-         DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
-	 g_vi_refresh_rate = 1500;
+      strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
+      DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
+      g_vi_refresh_rate = 1500;
 
-         patch_applied = 1;
-         break;
-      }
+      patch_applied = 1;
    }
 
-   for (i = 0; i < sizeof(lut_vi_clock_1600)/sizeof(lut_vi_clock_1600[0]); ++i)
+   if (rom_lut_find(lut_vi_clock_1600, LUT_ROWS(lut_vi_clock_1600), 1, lut_id))
    {
-      if (lut_vi_clock_1600[i] == lut_id)
-      {
-         strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
-         DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
-	 g_vi_refresh_rate = 1600;
+      strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
+      DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
+      g_vi_refresh_rate = 1600;
 
-         patch_applied = 1;
-         break;
-      }
+      patch_applied = 1;
    }
 
-   for (i = 0; i < sizeof(lut_vi_clock_2200)/sizeof(lut_vi_clock_2200[0]); ++i)
+   if (rom_lut_find(lut_vi_clock_2200, LUT_ROWS(lut_vi_clock_2200), 1, lut_id))
    {
-      if (lut_vi_clock_2200[i] == lut_id)
-      {
-         strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
-         DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
-	 g_vi_refresh_rate = 2200;
+      strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
+      DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
+      g_vi_refresh_rate = 2200;
 
-         patch_applied = 1;
-         break;
-      }
+      patch_applied = 1;
    }
 
-   for (i = 0; i < sizeof(lut_ee4k)/sizeof(lut_ee4k[0]); ++i)
+   if (rom_lut_find(lut_ee4k, LUT_ROWS(lut_ee4k), 1, lut_id))
    {
-      if (lut_ee4k[i] == lut_id)
-      {
-         strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
-         ROM_SETTINGS.savetype = EEPROM_4KB;
-         DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
+      strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
+      ROM_SETTINGS.savetype = EEPROM_4KB;
+      DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
 
-         patch_applied = 1;
-         break;
-      }
+      patch_applied = 1;
    }
 
-   for (i = 0; i < sizeof(lut_flashram)/sizeof(lut_flashram[0]); ++i)
+   if (rom_lut_find(lut_flashram, LUT_ROWS(lut_flashram), 1, lut_id))
    {
-      if (lut_flashram[i] == lut_id)
-      {
-         strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
-         ROM_SETTINGS.savetype = FLASH_RAM;
-         DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
+      strcpy(ROM_SETTINGS.goodname, ROM_PARAMS.headername);
+      ROM_SETTINGS.savetype = FLASH_RAM;
+      DebugMessage(M64MSG_INFO, "%s INI patches applied.", ROM_PARAMS.headername);
 
-         patch_applied = 1;
-         break;
-      }
+      patch_applied = 1;
    }
 
    if (!patch_applied)
@@ -334,24 +498,22 @@ m64p_error open_rom(const unsigned char* romimage, unsigned int size)
       ROM_SETTINGS.rumble = 0;
    }
 
-   for (i = 0; i < sizeof(lut_cpop)/sizeof(lut_cpop[0]); ++i)
+   row = rom_lut_find(lut_cpop[0], LUT_ROWS(lut_cpop), 2, lut_id);
+#ifndef GLES
+   if (!row)
+      row = rom_lut_find(lut_cpop_gl[0], LUT_ROWS(lut_cpop_gl), 2, lut_id);
+#endif
+   if (row)
    {
-      if (lut_cpop[i][0] == lut_id)
-      {
-         count_per_op = lut_cpop[i][1];
-         DebugMessage(M64MSG_INFO, "CountPerOp set to %u.", count_per_op);
-         break;
-      }
+      count_per_op = row[1];
+      DebugMessage(M64MSG_INFO, "CountPerOp set to %u.", count_per_op);
    }
 
-   for (i = 0; i < sizeof(lut_sidmaduration)/sizeof(lut_sidmaduration[0]); ++i)
+   row = rom_lut_find(lut_sidmaduration[0], LUT_ROWS(lut_sidmaduration), 2, lut_id);
+   if (row)
    {
-      if (lut_sidmaduration[i][0] == lut_id)
-      {
-         ROM_SETTINGS.sidmaduration = lut_sidmaduration[i][1];
-         DebugMessage(M64MSG_INFO, "SI DMA Duration set to %u.", ROM_SETTINGS.sidmaduration);
-         break;
-      }
+      ROM_SETTINGS.sidmaduration = row[1];
+      DebugMessage(M64MSG_INFO, "SI DMA Duration set to %u.", ROM_SETTINGS.sidmaduration);
    }
 
    if (frame_dupe)
@@ -359,14 +521,11 @@ m64p_error open_rom(const unsigned char* romimage, unsigned int size)
 
    g_delay_si = 1; /* default */
 
-   for (i = 0; i < sizeof(lut_delaysi)/sizeof(lut_delaysi[0]); ++i)
+   row = rom_lut_find(lut_delaysi[0], LUT_ROWS(lut_delaysi), 2, lut_id);
+   if (row)
    {
-      if (lut_delaysi[i][0] == lut_id)
-      {
-         g_delay_si = lut_delaysi[i][1];
-         DebugMessage(M64MSG_INFO, "DelaySI set to %u.", g_delay_si);
-         break;
-      }
+      g_delay_si = row[1];
+      DebugMessage(M64MSG_INFO, "DelaySI set to %u.", g_delay_si);
    }
 
    /* print out a bunch of info about the ROM */
@@ -374,7 +533,6 @@ m64p_error open_rom(const unsigned char* romimage, unsigned int size)
    DebugMessage(M64MSG_INFO, "Headername: %s", ROM_PARAMS.headername);
    DebugMessage(M64MSG_INFO, "Name: %s", ROM_HEADER.Name);
    imagestring(imagetype, buffer);
-   DebugMessage(M64MSG_INFO, "MD5: %s", ROM_SETTINGS.MD5);
    DebugMessage(M64MSG_INFO, "CRC: %x %x", sl(ROM_HEADER.CRC1), sl(ROM_HEADER.CRC2));
    DebugMessage(M64MSG_INFO, "Imagetype: %s", buffer);
    DebugMessage(M64MSG_INFO, "Rom size: %d bytes (or %d Mb or %d Megabits)", g_rom_size, g_rom_size/1024/1024, g_rom_size/1024/1024*8);
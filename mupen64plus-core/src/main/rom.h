@@ -31,6 +31,14 @@
 m64p_error open_rom(const unsigned char* romimage, unsigned int size);
 m64p_error close_rom(void);
 
+/* MD5 of the .z64 image. On first call it is looked up in the save
+ * directory by the path given to rom_set_path, or computed and stored
+ * there. */
+const char* rom_md5(void);
+
+/* File the next ROM is loaded from, NULL if the frontend gave none */
+void rom_set_path(const char *path);
+
 extern unsigned char* g_rom;
 extern int g_rom_size;
 extern int g_vi_refresh_rate;
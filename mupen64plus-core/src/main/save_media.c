@@ -0,0 +1,129 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - save_media.c                                            *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "save_media.h"
+
+#include "../../libretro/libretro_memory.h"
+
+struct save_media
+{
+   uint8_t* published;
+   size_t size;
+   int dirty;
+   /* frame of the last write */
+   unsigned int written;
+};
+
+static struct
+{
+   uint8_t eeprom[sizeof(saved_memory.eeprom)];
+   uint8_t mempack[4][sizeof(saved_memory.mempack[0])];
+   uint8_t sram[sizeof(saved_memory.sram)];
+   uint8_t flashram[sizeof(saved_memory.flashram)];
+} live;
+
+static struct save_media media[SAVE_MEDIA_COUNT] =
+{
+   { saved_memory.eeprom,      sizeof(saved_memory.eeprom) },
+   { saved_memory.mempack[0],  sizeof(saved_memory.mempack[0]) },
+   { saved_memory.mempack[1],  sizeof(saved_memory.mempack[1]) },
+   { saved_memory.mempack[2],  sizeof(saved_memory.mempack[2]) },
+   { saved_memory.mempack[3],  sizeof(saved_memory.mempack[3]) },
+   { saved_memory.sram,        sizeof(saved_memory.sram) },
+   { saved_memory.flashram,    sizeof(saved_memory.flashram) },
+};
+
+static unsigned int frame;
+static unsigned int delay = 30;
+
+uint8_t* save_media_data(unsigned int id)
+{
+   switch (id)
+   {
+      case SAVE_MEDIA_EEPROM:   return live.eeprom;
+      case SAVE_MEDIA_SRAM:     return live.sram;
+      case SAVE_MEDIA_FLASHRAM: return live.flashram;
+      default:                  return live.mempack[id - SAVE_MEDIA_MEMPAK];
+   }
+}
+
+void* save_media_user_data(unsigned int id)
+{
+   return &media[id];
+}
+
+void save_media_written(void* user_data)
+{
+   struct save_media* m = (struct save_media*)user_data;
+
+   m->dirty   = 1;
+   m->written = frame;
+}
+
+void save_media_set_delay(unsigned int frames)
+{
+   delay = frames;
+}
+
+/* The whole device is copied: at most 128KB once per burst of writes, so
+ * tracking the written ranges would not pay for itself. */
+static void publish(unsigned int id)
+{
+   memcpy(media[id].published, save_media_data(id), media[id].size);
+   media[id].dirty = 0;
+}
+
+void save_media_load(void)
+{
+   unsigned int id;
+
+   for (id = 0; id < SAVE_MEDIA_COUNT; id++)
+   {
+      memcpy(save_media_data(id), media[id].published, media[id].size);
+      media[id].dirty = 0;
+   }
+}
+
+void save_media_frame(void)
+{
+   unsigned int id;
+
+   for (id = 0; id < SAVE_MEDIA_COUNT; id++)
+   {
+      if (media[id].dirty && frame - media[id].written >= delay)
+         publish(id);
+   }
+
+   frame++;
+}
+
+void save_media_flush(void)
+{
+   unsigned int id;
+
+   for (id = 0; id < SAVE_MEDIA_COUNT; id++)
+   {
+      if (media[id].dirty)
+         publish(id);
+   }
+}
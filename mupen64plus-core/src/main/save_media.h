@@ -0,0 +1,66 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - save_media.h                                            *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M64P_MAIN_SAVE_MEDIA_H
+#define M64P_MAIN_SAVE_MEDIA_H
+
+#include <stdint.h>
+
+/* Cartridge and controller pak save data, between the emulated devices
+ * and the frontend.
+ *
+ * The devices work on live copies of EEPROM, mempaks, SRAM and FlashRAM
+ * and only report that they wrote something. A copy is published to
+ * saved_memory, which the frontend persists as its save RAM, once the game
+ * has left it alone for a number of frames. A game writing its save over
+ * several frames is thus only ever seen by the frontend as a whole, before
+ * or after, and bursts of small writes end up in one copy. */
+
+enum save_media_id
+{
+   SAVE_MEDIA_EEPROM,
+   SAVE_MEDIA_MEMPAK,
+   SAVE_MEDIA_SRAM = SAVE_MEDIA_MEMPAK + 4,
+   SAVE_MEDIA_FLASHRAM,
+   SAVE_MEDIA_COUNT
+};
+
+/* Live data and save hook user data of a device, mempaks being
+ * SAVE_MEDIA_MEMPAK + controller */
+uint8_t* save_media_data(unsigned int id);
+void* save_media_user_data(unsigned int id);
+
+/* Save hook of the devices */
+void save_media_written(void* user_data);
+
+/* Frames a device must go unwritten before it is published, 0 publishing
+ * at every frame boundary */
+void save_media_set_delay(unsigned int frames);
+
+/* Takes saved_memory, as loaded by the frontend, as the live data */
+void save_media_load(void);
+
+/* Called once per frame, publishes the devices which have settled */
+void save_media_frame(void);
+
+/* Publishes every device with pending writes */
+void save_media_flush(void);
+
+#endif
@@ -32,6 +32,7 @@
 #include "api/config.h"
 
 #include "savestates.h"
+#include "snapshot.h"
 #include "device.h"
 #include "main.h"
 #include "rom.h"
@@ -44,6 +45,7 @@
 #include "../plugin/plugin.h"
 #include "../r4300/r4300_core.h"
 #include "../rdp/rdp_core.h"
+#include "../ri/rdram_gen.h"
 #include "../ri/ri_controller.h"
 #include "../rsp/rsp_core.h"
 #include "../si/si_controller.h"
@@ -51,7 +53,13 @@
 #include "osal/preproc.h"
 
 static const char* savestate_magic = "M64+SAVE";
-static const int savestate_latest_version = 0x00010000;  /* 1.0 */
+static const int savestate_latest_version = 0x00020000;  /* 2.0 */
+
+/* 2.0 drops the TLB lookup tables, which are rebuilt from the TLB entries
+ * on load, and stores RDRAM at its configured size instead of
+ * RDRAM_MAX_SIZE. 1.0 states still load. */
+
+#define SAVESTATE_QUEUE_SIZE 1024
 
 #define GETARRAY(buff, type, count) \
     (to_little_endian_buffer(buff, sizeof(type),count), \
@@ -69,11 +77,53 @@ static const int savestate_latest_version = 0x00010000;  /* 1.0 */
 #define PUTDATA(buff, type, value) \
     do { type x = value; PUTARRAY(&x, buff, type, 1); } while(0)
 
+/* Bytes of a 2.0 state besides RDRAM and the event queue, section by
+ * section as savestates_save_m64p writes them */
+static size_t savestates_fixed_size(void)
+{
+   size_t size = 0;
+
+   size += 8 + 4 + 32;                                  /* magic, version, ROM MD5 */
+   size += 10 * sizeof(uint32_t);                       /* RDRAM */
+   size += 7 * sizeof(uint32_t) + 6 * sizeof(uint8_t)
+         + sizeof(uint16_t);                            /* MI */
+   size += 13 * sizeof(uint32_t);                       /* PI */
+   size += 11 * sizeof(uint32_t) + 16 * sizeof(uint8_t); /* SP */
+   size += 4 * sizeof(uint32_t);                        /* SI */
+   size += 14 * sizeof(uint32_t) + sizeof(unsigned int); /* VI */
+   size += 8 * sizeof(uint32_t);                        /* RI */
+   size += 9 * sizeof(uint32_t) + 2 * sizeof(unsigned int); /* AI */
+   size += 9 * sizeof(uint32_t) + 12 * sizeof(uint8_t); /* DPC */
+   size += 4 * sizeof(uint32_t);                        /* DPS */
+   size += sizeof(uint32_t) + SP_MEM_SIZE + PIF_RAM_SIZE; /* RDRAM size, SP and PIF memory */
+   size += 2 * sizeof(int) + sizeof(unsigned long long)
+         + 2 * sizeof(unsigned int);                    /* Flashram */
+   size += sizeof(unsigned int) + 34 * sizeof(int64_t)
+         + 32 * sizeof(uint32_t);                       /* llbit, GPRs, LO/HI, CP0 */
+   size += 32 * sizeof(int64_t) + 2 * sizeof(uint32_t); /* CP1 */
+   size += 32 * (3 * sizeof(short) + 9 * sizeof(unsigned int)
+         + 10 * sizeof(char));                          /* TLB */
+   size += sizeof(uint32_t) + 3 * sizeof(unsigned int); /* PC, next interrupt, next VI, field */
+
+   return size;
+}
+
+/* The frontend may not see the size grow, and RDRAM is only set up on the
+ * first frame, so count it at the largest size a state can hold. */
+size_t savestates_size_m64p(void)
+{
+   return savestates_fixed_size() + RDRAM_MAX_SIZE + SAVESTATE_QUEUE_SIZE;
+}
+
 int savestates_load_m64p(const unsigned char *data, size_t size)
 {
-   char queue[1024];
+   char queue[SAVESTATE_QUEUE_SIZE];
    int version;
    int i;
+   int keep_code;
+   tlb old_tlb_e[32];
+   const uint32_t* ram;
+   uint32_t dram_size = RDRAM_MAX_SIZE;
    uint32_t FCR31;
    uint32_t* cp0_regs = r4300_cp0_regs();
    unsigned char *curr = (unsigned char*)data; // < HACK
@@ -89,10 +139,10 @@ int savestates_load_m64p(const unsigned char *data, size_t size)
    version = (version << 8) | *curr++;
    version = (version << 8) | *curr++;
 
-   if(version != 0x00010000)
+   if(version != 0x00010000 && version != 0x00020000)
       return 0;
 
-   if(memcmp((char *)curr, ROM_SETTINGS.MD5, 32))
+   if(memcmp((char *)curr, rom_md5(), 32))
       return 0;
 
    curr += 32;
@@ -215,7 +265,15 @@ int savestates_load_m64p(const unsigned char *data, size_t size)
    g_dev.dp.dps_regs[DPS_BUFTEST_ADDR_REG] = GETDATA(curr, uint32_t);
    g_dev.dp.dps_regs[DPS_BUFTEST_DATA_REG] = GETDATA(curr, uint32_t);
 
-   COPYARRAY(g_dev.ri.rdram.dram, curr, uint32_t, RDRAM_MAX_SIZE/4);
+   if (version >= 0x00020000)
+   {
+      dram_size = GETDATA(curr, uint32_t);
+      if (dram_size > RDRAM_MAX_SIZE || (dram_size & 3))
+         return 0;
+   }
+
+   /* copied once the TLB entries are known */
+   ram = GETARRAY(curr, uint32_t, dram_size/4);
    COPYARRAY(g_dev.sp.mem, curr, uint32_t, SP_MEM_SIZE/4);
    COPYARRAY(g_dev.si.pif.ram, curr, uint8_t, PIF_RAM_SIZE);
 
@@ -225,8 +283,11 @@ int savestates_load_m64p(const unsigned char *data, size_t size)
    g_dev.pi.flashram.erase_offset = GETDATA(curr, unsigned int);
    g_dev.pi.flashram.write_pointer = GETDATA(curr, unsigned int);
 
-   COPYARRAY(tlb_LUT_r, curr, unsigned int, 0x100000);
-   COPYARRAY(tlb_LUT_w, curr, unsigned int, 0x100000);
+   if (version < 0x00020000)
+   {
+      COPYARRAY(tlb_LUT_r, curr, unsigned int, 0x100000);
+      COPYARRAY(tlb_LUT_w, curr, unsigned int, 0x100000);
+   }
 
    *r4300_llbit() = GETDATA(curr, unsigned int);
    COPYARRAY(r4300_regs(), curr, int64_t, 32);
@@ -245,6 +306,7 @@ int savestates_load_m64p(const unsigned char *data, size_t size)
    *r4300_cp1_fcr31() = FCR31;
    update_x86_rounding_mode(FCR31);
 
+   memcpy(old_tlb_e, tlb_e, sizeof(old_tlb_e));
    for (i = 0; i < 32; i++)
    {
       tlb_e[i].mask       = GETDATA(curr, short);
@@ -275,7 +337,37 @@ int savestates_load_m64p(const unsigned char *data, size_t size)
       tlb_e[i].phys_odd   = GETDATA(curr, unsigned int);
    }
 
-   savestates_load_set_pc(GETDATA(curr, uint32_t));
+   if (version >= 0x00020000)
+   {
+      memset(tlb_LUT_r, 0, 0x100000 * sizeof(tlb_LUT_r[0]));
+      memset(tlb_LUT_w, 0, 0x100000 * sizeof(tlb_LUT_w[0]));
+      for (i = 0; i < 32; i++)
+         tlb_map(&tlb_e[i]);
+   }
+
+   /* With the same RDRAM size and TLB entries, code compiled from pages
+    * the state does not change is still valid */
+   keep_code = version >= 0x00020000
+      && dram_size == g_dev.ri.rdram.dram_size
+      && memcmp(old_tlb_e, tlb_e, sizeof(old_tlb_e)) == 0;
+
+   if (keep_code)
+   {
+      struct snapshot_code_stats stats;
+      unsigned int changed = snapshot_load_rdram(ram, 1, &stats);
+
+      DebugMessage(M64MSG_INFO,
+            "Savestate rewrote %u RDRAM pages, invalidated %u compiled blocks and kept %u",
+            changed, stats.blocks_invalidated, stats.blocks_kept);
+      savestates_load_set_pc_keep_code(GETDATA(curr, uint32_t));
+   }
+   else
+   {
+      memcpy(g_dev.ri.rdram.dram, ram, dram_size);
+      memset((uint8_t*)g_dev.ri.rdram.dram + dram_size, 0, RDRAM_MAX_SIZE - dram_size);
+      rdram_gen_touch_all();
+      savestates_load_set_pc(GETDATA(curr, uint32_t));
+   }
 
    *r4300_next_interrupt() = GETDATA(curr, unsigned int);
    g_dev.vi.next_vi  = GETDATA(curr, unsigned int);
@@ -298,11 +390,11 @@ int savestates_save_m64p(unsigned char *data, size_t size)
 {
    unsigned char outbuf[4];
    int i, queuelength;
-   char queue[1024];
+   char queue[SAVESTATE_QUEUE_SIZE];
    uint32_t* cp0_regs = r4300_cp0_regs();
    unsigned char *curr = (unsigned char*)data;
 
-   if (!curr)
+   if (!curr || size < savestates_size_m64p())
       return 0;
 
    queuelength = save_eventqueue_infos(queue);
@@ -316,7 +408,7 @@ int savestates_save_m64p(unsigned char *data, size_t size)
    outbuf[3] = (savestate_latest_version >>  0) & 0xff;
    PUTARRAY(outbuf, curr, unsigned char, 4);
 
-   PUTARRAY(ROM_SETTINGS.MD5, curr, char, 32);
+   PUTARRAY(rom_md5(), curr, char, 32);
 
    PUTDATA(curr, uint32_t, g_dev.ri.rdram.regs[RDRAM_CONFIG_REG]);
    PUTDATA(curr, uint32_t, g_dev.ri.rdram.regs[RDRAM_DEVICE_ID_REG]);
@@ -459,7 +551,8 @@ int savestates_save_m64p(unsigned char *data, size_t size)
    PUTDATA(curr, uint32_t, g_dev.dp.dps_regs[DPS_BUFTEST_ADDR_REG]);
    PUTDATA(curr, uint32_t, g_dev.dp.dps_regs[DPS_BUFTEST_DATA_REG]);
 
-   PUTARRAY(g_dev.ri.rdram.dram, curr, uint32_t, RDRAM_MAX_SIZE/4);
+   PUTDATA(curr, uint32_t, g_dev.ri.rdram.dram_size);
+   PUTARRAY(g_dev.ri.rdram.dram, curr, uint32_t, g_dev.ri.rdram.dram_size/4);
    PUTARRAY(g_dev.sp.mem, curr, uint32_t, SP_MEM_SIZE/4);
    PUTARRAY(g_dev.si.pif.ram, curr, uint8_t, PIF_RAM_SIZE);
 
@@ -469,9 +562,6 @@ int savestates_save_m64p(unsigned char *data, size_t size)
    PUTDATA(curr, unsigned int, g_dev.pi.flashram.erase_offset);
    PUTDATA(curr, unsigned int, g_dev.pi.flashram.write_pointer);
 
-   PUTARRAY(tlb_LUT_r, curr, unsigned int, 0x100000);
-   PUTARRAY(tlb_LUT_w, curr, unsigned int, 0x100000);
-
    PUTDATA(curr, unsigned int, *r4300_llbit());
    PUTARRAY(r4300_regs(), curr, int64_t, 32);
    PUTARRAY(cp0_regs, curr, uint32_t, 32);
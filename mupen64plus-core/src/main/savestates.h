@@ -32,6 +32,7 @@ typedef enum _savestates_job
     savestates_job_save
 } savestates_job;
 
+size_t savestates_size_m64p(void);
 int savestates_load_m64p(const unsigned char *data, size_t size);
 int savestates_save_m64p(unsigned char *data, size_t size);
 
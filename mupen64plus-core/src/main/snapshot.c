@@ -0,0 +1,330 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - snapshot.c                                              *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "snapshot.h"
+#include "device.h"
+#include "main.h"
+#include "rom.h"
+
+#include "../ai/ai_controller.h"
+#include "../memory/memory.h"
+#include "../pi/pi_controller.h"
+#include "../plugin/plugin.h"
+#include "../r4300/cp0.h"
+#include "../r4300/cp1.h"
+#include "../r4300/interrupt.h"
+#include "../r4300/r4300.h"
+#include "../r4300/r4300_core.h"
+#include "../r4300/tlb.h"
+#include "../rdp/rdp_core.h"
+#include "../ri/rdram_gen.h"
+#include "../ri/ri_controller.h"
+#include "../rsp/rsp_core.h"
+#include "../si/si_controller.h"
+#include "../vi/vi_controller.h"
+
+#define SNAPSHOT_PAGE_SIZE 0x1000
+
+static const char* snapshot_magic = "M64+SNAP";
+
+/* RDRAM follows, dram_size bytes */
+struct snapshot
+{
+   char magic[8];
+   uint32_t dram_size;
+   m64p_rom_header header;
+
+   uint32_t rdram_regs[RDRAM_REGS_COUNT];
+   uint32_t mi_regs[MI_REGS_COUNT];
+   uint32_t pi_regs[PI_REGS_COUNT];
+   uint32_t sp_regs[SP_REGS_COUNT];
+   uint32_t sp_regs2[SP_REGS2_COUNT];
+   uint32_t si_regs[SI_REGS_COUNT];
+   uint32_t vi_regs[VI_REGS_COUNT];
+   unsigned int vi_field;
+   unsigned int vi_delay;
+   unsigned int vi_next_vi;
+   uint32_t ri_regs[RI_REGS_COUNT];
+   uint32_t ai_regs[AI_REGS_COUNT];
+   struct ai_dma ai_fifo[AI_DMA_FIFO_SIZE];
+   uint32_t ai_last_read;
+   uint32_t dpc_regs[DPC_REGS_COUNT];
+   uint32_t dps_regs[DPS_REGS_COUNT];
+
+   uint32_t sp_mem[SP_MEM_SIZE/4];
+   uint8_t pif_ram[PIF_RAM_SIZE];
+
+   int use_flashram;
+   enum flashram_mode flashram_mode;
+   uint64_t flashram_status;
+   unsigned int flashram_erase_offset;
+   unsigned int flashram_write_pointer;
+
+   unsigned int llbit;
+   int64_t regs[32];
+   int64_t hi;
+   int64_t lo;
+   uint32_t cp0_regs[CP0_REGS_COUNT];
+   /* in the layout of the current FR mode */
+   int64_t cp1_regs[32];
+   uint32_t fcr0;
+   uint32_t fcr31;
+   tlb tlb_e[32];
+
+   uint32_t pc;
+   unsigned int next_interrupt;
+   char queue[1024];
+};
+
+/* RDRAM is only set up on the first frame and the size may not grow,
+ * so count it at the largest size, see savestates_size_m64p */
+size_t snapshot_size(void)
+{
+   return sizeof(struct snapshot) + RDRAM_MAX_SIZE;
+}
+
+int snapshot_save(void *data, size_t size)
+{
+   struct snapshot s;
+   uint32_t* cp0_regs = r4300_cp0_regs();
+
+   if (!data || size < snapshot_size())
+      return 0;
+
+   memcpy(s.magic, snapshot_magic, 8);
+   s.dram_size = g_dev.ri.rdram.dram_size;
+   s.header = ROM_HEADER;
+
+   memcpy(s.rdram_regs, g_dev.ri.rdram.regs, sizeof(s.rdram_regs));
+   memcpy(s.mi_regs, g_dev.r4300.mi.regs, sizeof(s.mi_regs));
+   memcpy(s.pi_regs, g_dev.pi.regs, sizeof(s.pi_regs));
+   memcpy(s.sp_regs, g_dev.sp.regs, sizeof(s.sp_regs));
+   memcpy(s.sp_regs2, g_dev.sp.regs2, sizeof(s.sp_regs2));
+   memcpy(s.si_regs, g_dev.si.regs, sizeof(s.si_regs));
+   memcpy(s.vi_regs, g_dev.vi.regs, sizeof(s.vi_regs));
+   s.vi_field   = g_dev.vi.field;
+   s.vi_delay   = g_dev.vi.delay;
+   s.vi_next_vi = g_dev.vi.next_vi;
+   memcpy(s.ri_regs, g_dev.ri.regs, sizeof(s.ri_regs));
+   memcpy(s.ai_regs, g_dev.ai.regs, sizeof(s.ai_regs));
+   memcpy(s.ai_fifo, g_dev.ai.fifo, sizeof(s.ai_fifo));
+   s.ai_last_read = g_dev.ai.last_read;
+   memcpy(s.dpc_regs, g_dev.dp.dpc_regs, sizeof(s.dpc_regs));
+   memcpy(s.dps_regs, g_dev.dp.dps_regs, sizeof(s.dps_regs));
+
+   memcpy(s.sp_mem, g_dev.sp.mem, sizeof(s.sp_mem));
+   memcpy(s.pif_ram, g_dev.si.pif.ram, sizeof(s.pif_ram));
+
+   s.use_flashram           = g_dev.pi.use_flashram;
+   s.flashram_mode          = g_dev.pi.flashram.mode;
+   s.flashram_status        = g_dev.pi.flashram.status;
+   s.flashram_erase_offset  = g_dev.pi.flashram.erase_offset;
+   s.flashram_write_pointer = g_dev.pi.flashram.write_pointer;
+
+   s.llbit = *r4300_llbit();
+   memcpy(s.regs, r4300_regs(), sizeof(s.regs));
+   s.hi = *r4300_mult_hi();
+   s.lo = *r4300_mult_lo();
+   memcpy(s.cp0_regs, cp0_regs, sizeof(s.cp0_regs));
+   memcpy(s.cp1_regs, r4300_cp1_regs(), sizeof(s.cp1_regs));
+   s.fcr0  = *r4300_cp1_fcr0();
+   s.fcr31 = *r4300_cp1_fcr31();
+   memcpy(s.tlb_e, tlb_e, sizeof(s.tlb_e));
+
+   s.pc = *r4300_pc();
+   s.next_interrupt = *r4300_next_interrupt();
+   save_eventqueue_infos(s.queue);
+
+   memcpy(data, &s, sizeof(s));
+   memcpy((uint8_t*)data + sizeof(s), g_dev.ri.rdram.dram, s.dram_size);
+
+   return 1;
+}
+
+static unsigned int snapshot_page_code_at(uint32_t vaddr, int count,
+      int invalidate)
+{
+   unsigned int blocks = count ? count_r4300_cached_code(vaddr, SNAPSHOT_PAGE_SIZE) : 0;
+
+   if (invalidate)
+      invalidate_r4300_cached_code(vaddr, SNAPSHOT_PAGE_SIZE);
+
+   return blocks;
+}
+
+/* Counts, if count is set, and invalidates, if invalidate is set, the code
+ * compiled from one RDRAM page, through kseg0, kseg1 and any TLB mapping
+ * of it. Returns the number of blocks. */
+static unsigned int snapshot_page_code(uint32_t address, int count,
+      int invalidate)
+{
+   unsigned int i;
+   unsigned int blocks = 0;
+
+   blocks += snapshot_page_code_at(0x80000000 + address, count, invalidate);
+   blocks += snapshot_page_code_at(0xa0000000 + address, count, invalidate);
+
+   for (i = 0; i < 32; i++)
+   {
+      const tlb* e = &tlb_e[i];
+
+      if (e->v_even && address >= e->phys_even
+            && address - e->phys_even <= e->end_even - e->start_even)
+         blocks += snapshot_page_code_at(e->start_even + (address - e->phys_even),
+               count, invalidate);
+
+      if (e->v_odd && address >= e->phys_odd
+            && address - e->phys_odd <= e->end_odd - e->start_odd)
+         blocks += snapshot_page_code_at(e->start_odd + (address - e->phys_odd),
+               count, invalidate);
+   }
+
+   return blocks;
+}
+
+unsigned int snapshot_load_rdram(const void *ram, int invalidate,
+      struct snapshot_code_stats *stats)
+{
+   const uint8_t* src = (const uint8_t*)ram;
+   uint8_t* dram = (uint8_t*)g_dev.ri.rdram.dram;
+   uint32_t address;
+   unsigned int changed = 0;
+
+   if (stats)
+      memset(stats, 0, sizeof(*stats));
+
+   for (address = 0; address < g_dev.ri.rdram.dram_size;
+         address += SNAPSHOT_PAGE_SIZE)
+   {
+      if (memcmp(dram + address, src + address, SNAPSHOT_PAGE_SIZE) == 0)
+      {
+         if (stats)
+            stats->blocks_kept += snapshot_page_code(address, 1, 0);
+         continue;
+      }
+
+      memcpy(dram + address, src + address, SNAPSHOT_PAGE_SIZE);
+      rdram_gen_touch(address, SNAPSHOT_PAGE_SIZE);
+      if (invalidate)
+      {
+         unsigned int blocks = snapshot_page_code(address, stats != NULL, 1);
+
+         if (stats)
+            stats->blocks_invalidated += blocks;
+      }
+      ++changed;
+   }
+
+   return changed;
+}
+
+int snapshot_load(const void *data, size_t size)
+{
+   struct snapshot s;
+   unsigned int i;
+   int tlb_changed;
+
+   if (!data || size < sizeof(s))
+      return 0;
+
+   memcpy(&s, data, sizeof(s));
+
+   if (memcmp(s.magic, snapshot_magic, 8) != 0
+         || memcmp(&s.header, &ROM_HEADER, sizeof(s.header)) != 0
+         || s.dram_size != g_dev.ri.rdram.dram_size
+         || size < sizeof(s) + s.dram_size)
+      return 0;
+
+   /* New TLB entries change which code is reachable where, so all of it
+    * gets invalidated then, as on a savestate load */
+   tlb_changed = memcmp(s.tlb_e, tlb_e, sizeof(s.tlb_e)) != 0;
+   if (tlb_changed)
+   {
+      for (i = 0; i < 32; i++)
+         tlb_unmap(&tlb_e[i]);
+      memcpy(tlb_e, s.tlb_e, sizeof(s.tlb_e));
+      for (i = 0; i < 32; i++)
+         tlb_map(&tlb_e[i]);
+   }
+
+   snapshot_load_rdram((const uint8_t*)data + sizeof(s), !tlb_changed, NULL);
+
+   memcpy(g_dev.ri.rdram.regs, s.rdram_regs, sizeof(s.rdram_regs));
+   memcpy(g_dev.r4300.mi.regs, s.mi_regs, sizeof(s.mi_regs));
+   memcpy(g_dev.pi.regs, s.pi_regs, sizeof(s.pi_regs));
+   memcpy(g_dev.sp.regs, s.sp_regs, sizeof(s.sp_regs));
+   memcpy(g_dev.sp.regs2, s.sp_regs2, sizeof(s.sp_regs2));
+   memcpy(g_dev.si.regs, s.si_regs, sizeof(s.si_regs));
+
+   if (g_dev.vi.regs[VI_STATUS_REG] != s.vi_regs[VI_STATUS_REG]
+         || g_dev.vi.regs[VI_WIDTH_REG] != s.vi_regs[VI_WIDTH_REG])
+   {
+      memcpy(g_dev.vi.regs, s.vi_regs, sizeof(s.vi_regs));
+      gfx.viStatusChanged();
+      gfx.viWidthChanged();
+   }
+   else
+      memcpy(g_dev.vi.regs, s.vi_regs, sizeof(s.vi_regs));
+   g_dev.vi.field   = s.vi_field;
+   g_dev.vi.delay   = s.vi_delay;
+   g_dev.vi.next_vi = s.vi_next_vi;
+
+   memcpy(g_dev.ri.regs, s.ri_regs, sizeof(s.ri_regs));
+   memcpy(g_dev.ai.regs, s.ai_regs, sizeof(s.ai_regs));
+   memcpy(g_dev.ai.fifo, s.ai_fifo, sizeof(s.ai_fifo));
+   g_dev.ai.last_read = s.ai_last_read;
+   memcpy(g_dev.dp.dpc_regs, s.dpc_regs, sizeof(s.dpc_regs));
+   memcpy(g_dev.dp.dps_regs, s.dps_regs, sizeof(s.dps_regs));
+
+   memcpy(g_dev.sp.mem, s.sp_mem, sizeof(s.sp_mem));
+   memcpy(g_dev.si.pif.ram, s.pif_ram, sizeof(s.pif_ram));
+
+   g_dev.pi.use_flashram             = s.use_flashram;
+   g_dev.pi.flashram.mode            = s.flashram_mode;
+   g_dev.pi.flashram.status          = s.flashram_status;
+   g_dev.pi.flashram.erase_offset    = s.flashram_erase_offset;
+   g_dev.pi.flashram.write_pointer   = s.flashram_write_pointer;
+
+   *r4300_llbit() = s.llbit;
+   memcpy(r4300_regs(), s.regs, sizeof(s.regs));
+   *r4300_mult_hi() = s.hi;
+   *r4300_mult_lo() = s.lo;
+   memcpy(r4300_cp0_regs(), s.cp0_regs, sizeof(s.cp0_regs));
+   set_fpr_pointers(s.cp0_regs[CP0_STATUS_REG]);
+   memcpy(r4300_cp1_regs(), s.cp1_regs, sizeof(s.cp1_regs));
+   *r4300_cp1_fcr0()  = s.fcr0;
+   *r4300_cp1_fcr31() = s.fcr31;
+   update_x86_rounding_mode(s.fcr31);
+
+   if (tlb_changed)
+      savestates_load_set_pc(s.pc);
+   else
+      savestates_load_set_pc_keep_code(s.pc);
+
+   *r4300_next_interrupt() = s.next_interrupt;
+   load_eventqueue_infos(s.queue);
+
+   *r4300_last_addr() = *r4300_pc();
+
+   return 1;
+}
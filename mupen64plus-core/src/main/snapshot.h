@@ -0,0 +1,56 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - snapshot.h                                              *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M64P_MAIN_SNAPSHOT_H
+#define M64P_MAIN_SNAPSHOT_H
+
+#include <stddef.h>
+
+/* In-process snapshots, for run-ahead and rewind.
+ *
+ * A snapshot is the same machine state as a savestate, stored as raw
+ * structs in host layout with no endian conversion or padding fields, so
+ * it is only valid for the binary that wrote it. Only the configured RDRAM
+ * size and the live event queue are copied.
+ *
+ * Loading compares RDRAM page by page and only copies and invalidates the
+ * recompiled code of pages which differ, so code compiled since the
+ * snapshot was taken stays valid. A different set of TLB entries falls
+ * back to invalidating everything, as a savestate load does. */
+
+size_t snapshot_size(void);
+int snapshot_save(void *data, size_t size);
+int snapshot_load(const void *data, size_t size);
+
+/* Blocks of recompiled code a load of RDRAM dropped and kept */
+struct snapshot_code_stats
+{
+   unsigned int blocks_invalidated;
+   unsigned int blocks_kept;
+};
+
+/* Copies dram_size bytes of RDRAM from ram, only writing the pages which
+ * differ and, if invalidate is set, invalidating the code compiled from
+ * them. Returns the number of pages written and fills stats, if not NULL,
+ * with the compiled blocks of the written and the unchanged pages. */
+unsigned int snapshot_load_rdram(const void *ram, int invalidate,
+      struct snapshot_code_stats *stats);
+
+#endif
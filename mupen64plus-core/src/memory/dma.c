@@ -0,0 +1,156 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - dma.c                                                   *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "dma.h"
+#include "memory.h"
+
+#include "../api/callbacks.h"
+#include "../api/m64p_types.h"
+
+#include <string.h>
+
+#if defined(ARCH_MIN_SSE2)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+struct dma_stats g_dma_stats;
+
+static const char* const dma_channel_names[DMA_CHANNEL_COUNT] =
+{
+   "PI read", "PI write", "SI read", "SI write"
+};
+
+/* dst[i] = bytes [shift/8, shift/8 + 4) of the big endian pair src[i]:src[i+1] */
+static void copy_words_shifted(uint32_t* dst, const uint32_t* src, size_t count, unsigned int shift)
+{
+   size_t i = 0;
+
+#if defined(ARCH_MIN_SSE2)
+   const __m128i left  = _mm_cvtsi32_si128(shift);
+   const __m128i right = _mm_cvtsi32_si128(32 - shift);
+
+   for (; i + 4 <= count; i += 4)
+   {
+      __m128i hi = _mm_loadu_si128((const __m128i*)(src + i));
+      __m128i lo = _mm_loadu_si128((const __m128i*)(src + i + 1));
+      _mm_storeu_si128((__m128i*)(dst + i),
+            _mm_or_si128(_mm_sll_epi32(hi, left), _mm_srl_epi32(lo, right)));
+   }
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+   const int32x4_t left  = vdupq_n_s32((int32_t)shift);
+   const int32x4_t right = vdupq_n_s32(-(int32_t)(32 - shift));
+
+   for (; i + 4 <= count; i += 4)
+   {
+      uint32x4_t hi = vld1q_u32(src + i);
+      uint32x4_t lo = vld1q_u32(src + i + 1);
+      vst1q_u32(dst + i, vorrq_u32(vshlq_u32(hi, left), vshlq_u32(lo, right)));
+   }
+#endif
+
+   for (; i < count; ++i)
+      dst[i] = (src[i] << shift) | (src[i + 1] >> (32 - shift));
+}
+
+void dma_copy(uint8_t* dst, uint32_t dst_address,
+      const uint8_t* src, uint32_t src_address, uint32_t length)
+{
+   uint32_t words;
+
+   /* align the destination on a word */
+   while (length != 0 && (dst_address & 3) != 0)
+   {
+      dst[dst_address++ ^ S8] = src[src_address++ ^ S8];
+      --length;
+   }
+
+   words = length >> 2;
+   if (words != 0)
+   {
+      if ((src_address & 3) == 0)
+         memcpy(dst + dst_address, src + src_address, words * 4);
+      else
+         copy_words_shifted((uint32_t*)(dst + dst_address),
+               (const uint32_t*)(src + (src_address & ~UINT32_C(3))),
+               words, (src_address & 3) * 8);
+
+      dst_address += words * 4;
+      src_address += words * 4;
+      length      -= words * 4;
+   }
+
+   while (length-- != 0)
+      dst[dst_address++ ^ S8] = src[src_address++ ^ S8];
+}
+
+void dma_copy_swap32(uint32_t* dst, const uint32_t* src, size_t count)
+{
+#ifdef MSB_FIRST
+   memcpy(dst, src, count * 4);
+#else
+   size_t i = 0;
+
+#if defined(ARCH_MIN_SSE2)
+   for (; i + 4 <= count; i += 4)
+   {
+      __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+      v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+      v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+      v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+      _mm_storeu_si128((__m128i*)(dst + i), v);
+   }
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+   for (; i + 4 <= count; i += 4)
+      vst1q_u8((uint8_t*)(dst + i), vrev32q_u8(vld1q_u8((const uint8_t*)(src + i))));
+#endif
+
+   for (; i < count; ++i)
+      dst[i] = sl(src[i]);
+#endif
+}
+
+void dma_account(enum dma_channel channel, uint32_t length)
+{
+   g_dma_stats.transfers[channel]++;
+   g_dma_stats.bytes[channel] += length;
+}
+
+void dma_stats_reset(void)
+{
+   memset(&g_dma_stats, 0, sizeof(g_dma_stats));
+}
+
+void dma_stats_print(void)
+{
+   int i;
+
+   for (i = 0; i < DMA_CHANNEL_COUNT; ++i)
+   {
+      if (g_dma_stats.transfers[i] == 0)
+         continue;
+
+      DebugMessage(M64MSG_INFO, "DMA %s: %llu transfers, %llu bytes",
+            dma_channel_names[i],
+            (unsigned long long)g_dma_stats.transfers[i],
+            (unsigned long long)g_dma_stats.bytes[i]);
+   }
+}
@@ -0,0 +1,65 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - dma.h                                                   *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M64P_MEMORY_DMA_H
+#define M64P_MEMORY_DMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* DMA copy engine shared by the PI and SI controllers.
+ *
+ * RDRAM, cart ROM, SRAM, FlashRAM and the 64DD buffers are all stored as
+ * native 32-bit words, so byte n of a buffer lives at host offset n ^ S8.
+ * PIF RAM is the only buffer kept in N64 (big endian) byte order. */
+
+enum dma_channel
+{
+   DMA_PI_READ,   /* RDRAM -> cart domain */
+   DMA_PI_WRITE,  /* cart domain -> RDRAM */
+   DMA_SI_READ,   /* PIF RAM -> RDRAM */
+   DMA_SI_WRITE,  /* RDRAM -> PIF RAM */
+   DMA_CHANNEL_COUNT
+};
+
+struct dma_stats
+{
+   uint64_t transfers[DMA_CHANNEL_COUNT];
+   uint64_t bytes[DMA_CHANNEL_COUNT];
+};
+
+extern struct dma_stats g_dma_stats;
+
+/* Copies length bytes from src_address in src to dst_address in dst, both
+ * buffers being stored as native words. Whole words are moved at once, with
+ * a funnel shift when both addresses are not equally aligned. */
+void dma_copy(uint8_t* dst, uint32_t dst_address,
+      const uint8_t* src, uint32_t src_address, uint32_t length);
+
+/* Copies count words between a big endian buffer and a native word buffer
+ * (in either direction), byteswapping them on little endian hosts. */
+void dma_copy_swap32(uint32_t* dst, const uint32_t* src, size_t count);
+
+void dma_account(enum dma_channel channel, uint32_t length);
+
+void dma_stats_reset(void);
+void dma_stats_print(void);
+
+#endif
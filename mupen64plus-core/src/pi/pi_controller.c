@@ -26,11 +26,13 @@
 #include "../api/m64p_types.h"
 #include "../main/main.h"
 #include "../main/device.h"
+#include "../memory/dma.h"
 #include "../memory/memory.h"
 #include "../r4300/cp0.h"
 #include "../r4300/cp0_private.h"
 #include "../r4300/r4300_core.h"
 #include "../ri/rdram_detection_hack.h"
+#include "../ri/rdram_gen.h"
 #include "../ri/ri_controller.h"
 #include "../dd/dd_controller.h"
 
@@ -86,8 +88,8 @@ static void dma_pi_read(struct pi_controller *pi)
       dram_address = pi->regs[PI_DRAM_ADDR_REG];
       dram = (uint8_t*)pi->ri->rdram.dram;
 
-      for (i = 0; i < length; ++i)
-         rom[(rom_address + i) ^ S8] = dram[(dram_address + i) ^ S8];
+      dma_copy(rom, rom_address, dram, dram_address, length);
+      dma_account(DMA_PI_READ, length);
    }
    else if (pi->regs[PI_CART_ADDR_REG] >= 0x08000000
          && pi->regs[PI_CART_ADDR_REG] < 0x08010000)
@@ -180,11 +182,11 @@ static void dma_pi_write(struct pi_controller *pi)
          dram_address = pi->regs[PI_DRAM_ADDR_REG];
          dram = (uint8_t*)pi->ri->rdram.dram;
 
-         for (i = 0; i < length; ++i)
-            dram[(dram_address + i) ^ S8] = rom[(rom_address + i) ^ S8];
-
+         dma_copy(dram, dram_address, rom, rom_address, length);
          invalidate_r4300_cached_code(0x80000000 + dram_address, length);
          invalidate_r4300_cached_code(0xa0000000 + dram_address, length);
+         rdram_gen_touch(dram_address, length);
+         dma_account(DMA_PI_WRITE, length);
       }
       else
       {
@@ -274,11 +276,11 @@ static void dma_pi_write(struct pi_controller *pi)
       rom = pi->cart_rom.rom;
    }
 
-   for (i = 0; i < length; ++i)
-      dram[(dram_address + i) ^ S8] = rom[(rom_address + i) ^ S8];
-
+   dma_copy(dram, dram_address, rom, rom_address, length);
    invalidate_r4300_cached_code(0x80000000 + dram_address, length);
    invalidate_r4300_cached_code(0xa0000000 + dram_address, length);
+   rdram_gen_touch(dram_address, length);
+   dma_account(DMA_PI_WRITE, length);
 
    /* HACK: monitor PI DMA to trigger RDRAM size detection
     * hack just before initial cart ROM loading. */
@@ -20,15 +20,24 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include "api/m64p_types.h"
+#include "api/callbacks.h"
 #include <libretro.h>
 #include "ai/ai_controller.h"
 #include "main/main.h"
 #include "main/device.h"
+#include "main/profile.h"
 #include "main/rom.h"
 #include "plugin/plugin.h"
 #include "ri/ri_controller.h"
 #include "vi/vi_controller.h"
 
+#include "audio_plugin.h"
+#include "audio_ring.h"
+#include "polyphase_resampler.h"
+#ifdef HAVE_AUDIO_THREAD
+#include "audio_thread.h"
+#endif
+
 #include <stdio.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -37,8 +46,14 @@
 #include <stdarg.h>
 
 #include <audio/conversion/float_to_s16.h>
-#include <audio/conversion/s16_to_float.h>
 #include <audio/audio_resampler.h>
+#include <features/features_cpu.h>
+
+#if defined(ARCH_MIN_SSE2)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 extern retro_audio_sample_batch_t audio_batch_cb;
 
@@ -46,59 +61,278 @@ static unsigned MAX_AUDIO_FRAMES = 2048;
 
 #define VI_INTR_TIME 500000
 
-/* Read header for type definition */
-static int GameFreq = 33600;
+/* Capacity (in stereo frames) of both audio rings. Must be a power of two. */
+#define AUDIO_RING_FRAMES 0x8000
+
+/* Read header for type definition. Written by the emulation thread and
+ * read by the resampler, so it is only accessed with the ring's atomics. */
+static size_t GameFreq = 33600;
 static unsigned CountsPerSecond;
 static unsigned BytesPerSecond;
 static unsigned CountsPerByte;
 
+/* Rate of the frontend audio stream */
+#define OUTPUT_FREQ 44100
+
 static const retro_resampler_t *resampler;
 static void *resampler_audio_data;
+static struct polyphase_resampler *polyphase;
 static float *audio_in_buffer_float;
 static float *audio_out_buffer_float;
 static int16_t *audio_out_buffer_s16;
 
+/* AI DMA snapshots, from the emulation thread to the resampler. */
+static struct audio_ring audio_in_ring;
+/* Resampled frames, from the resampler to retro_run. */
+static struct audio_ring audio_out_ring;
+
+/* Owned by the emulation thread. */
+static struct audio_libretro_stats audio_stats;
+/* Owned by the resampler: frames lost to a full output ring. */
+static uint64_t resampler_dropped_frames;
+
 void (*audio_convert_s16_to_float_arm)(float *out,
       const int16_t *in, size_t samples, float gain);
 void (*audio_convert_float_to_s16_arm)(int16_t *out,
       const float *in, size_t samples);
 
+/* Converts AI frames as they are laid out in RDRAM (left sample in the upper
+ * half of each word) to interleaved float, so no byteswap pass is needed. */
+static void convert_ai_frames_to_float(float *out, const uint32_t *in, size_t frames)
+{
+   size_t i = 0;
+
+#if defined(ARCH_MIN_SSE2)
+   const __m128 factor = _mm_set1_ps(1.0f / UINT32_C(0x80000000));
+   const __m128i upper = _mm_set1_epi32((int)0xffff0000);
+
+   for (; i + 4 <= frames; i += 4)
+   {
+      __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+      __m128 l  = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(v, upper)), factor);
+      __m128 r  = _mm_mul_ps(_mm_cvtepi32_ps(_mm_slli_epi32(v, 16)), factor);
+      _mm_storeu_ps(out + 2 * i,     _mm_unpacklo_ps(l, r));
+      _mm_storeu_ps(out + 2 * i + 4, _mm_unpackhi_ps(l, r));
+   }
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+   const float32x4_t factor = vdupq_n_f32(1.0f / UINT32_C(0x80000000));
+   const int32x4_t upper    = vdupq_n_s32((int32_t)0xffff0000);
+
+   for (; i + 4 <= frames; i += 4)
+   {
+      int32x4_t v = vreinterpretq_s32_u32(vld1q_u32(in + i));
+      float32x4x2_t lr;
+      lr.val[0] = vmulq_f32(vcvtq_f32_s32(vandq_s32(v, upper)), factor);
+      lr.val[1] = vmulq_f32(vcvtq_f32_s32(vshlq_n_s32(v, 16)), factor);
+      vst2q_f32(out + 2 * i, lr);
+   }
+#endif
+
+   for (; i < frames; ++i)
+   {
+      out[2 * i]     = (int16_t)(in[i] >> 16) * (1.0f / 0x8000);
+      out[2 * i + 1] = (int16_t)(in[i])       * (1.0f / 0x8000);
+   }
+}
+
+/* Resamples everything queued in audio_in_ring into audio_out_ring.
+ * Runs on the audio thread when there is one, otherwise from
+ * flush_audio_libretro(). */
+static void process_audio_frames(void)
+{
+   const uint32_t *in;
+   size_t frames;
+
+   while ((frames = audio_ring_read_span(&audio_in_ring, &in)) != 0)
+   {
+      struct resampler_data data = {0};
+      const int16_t *out;
+      unsigned freq     = (unsigned)AUDIO_RING_LOAD(&GameFreq);
+      double ratio      = (double)OUTPUT_FREQ / freq;
+      size_t max_frames = (freq > OUTPUT_FREQ) ? MAX_AUDIO_FRAMES : (size_t)(MAX_AUDIO_FRAMES / ratio - 1);
+
+      if (frames > max_frames)
+         frames = max_frames;
+
+      if (polyphase)
+      {
+         data.output_frames = polyphase_process(polyphase, freq, OUTPUT_FREQ,
+               in, &frames, audio_out_buffer_s16, MAX_AUDIO_FRAMES);
+         audio_ring_consume(&audio_in_ring, frames);
+
+         /* nothing taken and nothing made: leave the rest queued */
+         if (frames == 0 && data.output_frames == 0)
+            break;
+      }
+      else
+      {
+         data.data_in      = audio_in_buffer_float;
+         data.data_out     = audio_out_buffer_float;
+         data.input_frames = frames;
+         data.ratio        = ratio;
+
+         convert_ai_frames_to_float(audio_in_buffer_float, in, frames);
+         audio_ring_consume(&audio_in_ring, frames);
+
+         resampler->process(resampler_audio_data, &data);
+         convert_float_to_s16(audio_out_buffer_s16, audio_out_buffer_float, data.output_frames * 2);
+      }
+
+      out = audio_out_buffer_s16;
+      while (data.output_frames)
+      {
+         uint32_t *span;
+         size_t count = audio_ring_write_span(&audio_out_ring, &span);
+
+         if (count == 0)
+         {
+            resampler_dropped_frames += data.output_frames;
+            break;
+         }
+         if (count > data.output_frames)
+            count = data.output_frames;
+
+         memcpy(span, out, count * sizeof(uint32_t));
+         audio_ring_commit(&audio_out_ring, count);
+         data.output_frames -= count;
+         out                += count * 2;
+      }
+   }
+}
+
 void deinit_audio_libretro(void)
 {
+   struct audio_libretro_stats stats;
+
    if (resampler && resampler_audio_data)
    {
+#ifdef HAVE_AUDIO_THREAD
+      audio_thread_close();
+#endif
+      audio_libretro_get_stats(&stats);
+      DebugMessage(M64MSG_INFO, "Audio: %llu frames in, %llu frames out, %llu dropped, %u underruns, %u max batch (frames), %llu us waiting on resampler",
+            (unsigned long long)stats.frames_in,
+            (unsigned long long)stats.frames_out,
+            (unsigned long long)stats.dropped_frames,
+            stats.underruns,
+            stats.max_batch_frames,
+            (unsigned long long)stats.wait_usec);
+
       resampler->free(resampler_audio_data);
       resampler = NULL;
       resampler_audio_data = NULL;
+      polyphase_free(polyphase);
+      polyphase = NULL;
       free(audio_in_buffer_float);
       free(audio_out_buffer_float);
       free(audio_out_buffer_s16);
+      audio_ring_free(&audio_in_ring);
+      audio_ring_free(&audio_out_ring);
    }
 }
 
-void init_audio_libretro(unsigned max_audio_frames)
+void init_audio_libretro(unsigned max_audio_frames, enum audio_resampler_type resampler_type)
 {
    retro_resampler_realloc(&resampler_audio_data, &resampler, "sinc", RESAMPLER_QUALITY_DONTCARE, 1.0);
 
    MAX_AUDIO_FRAMES = max_audio_frames;
 
+   switch (resampler_type)
+   {
+      case AUDIO_RESAMPLER_POLYPHASE_LOW:
+         polyphase = polyphase_new(POLYPHASE_LOW, MAX_AUDIO_FRAMES);
+         break;
+      case AUDIO_RESAMPLER_POLYPHASE_MEDIUM:
+         polyphase = polyphase_new(POLYPHASE_MEDIUM, MAX_AUDIO_FRAMES);
+         break;
+      case AUDIO_RESAMPLER_POLYPHASE_HIGH:
+         polyphase = polyphase_new(POLYPHASE_HIGH, MAX_AUDIO_FRAMES);
+         break;
+      default:
+         polyphase = NULL;
+         break;
+   }
+
    audio_in_buffer_float  = malloc(2 * MAX_AUDIO_FRAMES * sizeof(float));
    audio_out_buffer_float = malloc(2 * MAX_AUDIO_FRAMES * sizeof(float));
    audio_out_buffer_s16   = malloc(2 * MAX_AUDIO_FRAMES * sizeof(int16_t));
 
-   convert_s16_to_float_init_simd();
+   audio_ring_init(&audio_in_ring, AUDIO_RING_FRAMES);
+   audio_ring_init(&audio_out_ring, AUDIO_RING_FRAMES);
+   memset(&audio_stats, 0, sizeof(audio_stats));
+   resampler_dropped_frames = 0;
+
    convert_float_to_s16_init_simd();
+
+#ifdef HAVE_AUDIO_THREAD
+   audio_thread_init(process_audio_frames);
+#endif
+}
+
+void audio_libretro_get_stats(struct audio_libretro_stats *stats)
+{
+#ifdef HAVE_AUDIO_THREAD
+   /* the resampler's counter is only stable while it is idle */
+   audio_thread_wait_idle();
+#endif
+   *stats = audio_stats;
+   stats->dropped_frames += resampler_dropped_frames;
+}
+
+void flush_audio_libretro(void)
+{
+   const uint32_t *out;
+   size_t frames, total = 0;
+   retro_time_t start;
+
+   timed_section_start(TIMED_SECTION_AI);
+   start = cpu_features_get_time_usec();
+
+#ifdef HAVE_AUDIO_THREAD
+   audio_thread_wait_idle();
+#else
+   process_audio_frames();
+#endif
+
+   audio_stats.wait_usec += cpu_features_get_time_usec() - start;
+
+   while ((frames = audio_ring_read_span(&audio_out_ring, &out)) != 0)
+   {
+      size_t done = 0;
+
+      while (done < frames)
+      {
+         size_t ret = audio_batch_cb((const int16_t*)(out + done), frames - done);
+         if (ret == 0)
+            break;
+         done += ret;
+      }
+
+      /* frames the frontend did not take stay queued for the next flush */
+      audio_ring_consume(&audio_out_ring, done);
+      total += done;
+      if (done < frames)
+         break;
+   }
+
+   audio_stats.frames_out += total;
+   if (total == 0)
+      audio_stats.underruns++;
+   if (total > audio_stats.max_batch_frames)
+      audio_stats.max_batch_frames = (unsigned)total;
+
+   timed_section_end(TIMED_SECTION_AI);
 }
 
 static void aiDacrateChanged(void *user_data, unsigned int frequency, unsigned int bits)
 {
-   GameFreq        = frequency;
+   AUDIO_RING_STORE(&GameFreq, frequency);
    BytesPerSecond  = frequency * 4;
    CountsPerSecond = VI_INTR_TIME * 60 /* TODO/FIXME - dehardcode */;
    CountsPerByte   = CountsPerSecond / BytesPerSecond;
 
 #if 0
-   printf("CountsPerByte: %d, GameFreq: %d\n", CountsPerByte, GameFreq);
+   printf("CountsPerByte: %d, GameFreq: %d\n", CountsPerByte, frequency);
 #endif
 }
 
@@ -120,62 +354,37 @@ void set_audio_format_via_libretro(void* user_data,
    ai->regs[AI_DACRATE_REG] = saved_ai_dacrate;
 }
 
+/* Snapshots the AI DMA region into the audio ring. RDRAM is left untouched:
+ * the frames are converted directly from their in-memory layout later on. */
 static void aiLenChanged(void* user_data, const void* buffer, size_t size)
 {
-   size_t max_frames, remain_frames;
-   uint32_t i;
-   double ratio;
-   struct resampler_data data = {0};
-   int16_t *out      = NULL;
-   int16_t *raw_data = (int16_t*)buffer;
-   size_t frames     = size / 4;
-   uint8_t *p        = (uint8_t*)buffer;
-
-   for (i = 0; i < size; i += 4)
-   {
-      p[i ] ^= p[i + 2];
-      p[i + 2] ^= p[i ];
-      p[i ] ^= p[i + 2];
-      p[i + 1] ^= p[i + 3];
-      p[i + 3] ^= p[i + 1];
-      p[i + 1] ^= p[i + 3];
-   }
+   const uint32_t *in = (const uint32_t*)buffer;
+   size_t frames      = size / 4;
 
-audio_batch:
-   out               = NULL;
-   ratio             = 44100.0 / GameFreq;
-   max_frames        = (GameFreq > 44100) ? MAX_AUDIO_FRAMES : (size_t)(MAX_AUDIO_FRAMES / ratio - 1);
-   remain_frames     = 0;
+   audio_stats.frames_in += frames;
 
-   if (frames > max_frames)
+   while (frames)
    {
-      remain_frames = frames - max_frames;
-      frames = max_frames;
+      uint32_t *span;
+      size_t count = audio_ring_write_span(&audio_in_ring, &span);
+
+      if (count == 0)
+      {
+         audio_stats.dropped_frames += frames;
+         break;
+      }
+      if (count > frames)
+         count = frames;
+
+      memcpy(span, in, count * sizeof(uint32_t));
+      audio_ring_commit(&audio_in_ring, count);
+      in     += count;
+      frames -= count;
    }
 
-   data.data_in      = audio_in_buffer_float;
-   data.data_out     = audio_out_buffer_float;
-   data.input_frames = frames;
-   data.ratio        = ratio;
-
-   convert_s16_to_float(audio_in_buffer_float, raw_data, frames * 2, 1.0f);
-   resampler->process(resampler_audio_data, &data);
-   convert_float_to_s16(audio_out_buffer_s16, audio_out_buffer_float, data.output_frames * 2);
-
-   out                    = audio_out_buffer_s16;
-
-   while (data.output_frames)
-   {
-      size_t ret          = audio_batch_cb(out, data.output_frames);
-      data.output_frames -= ret;
-      out                += ret * 2;
-   }
-   if (remain_frames)
-   {
-      raw_data = raw_data + frames * 2;
-      frames   = remain_frames;
-      goto audio_batch;
-   }
+#ifdef HAVE_AUDIO_THREAD
+   audio_thread_notify();
+#endif
 }
 
 /* Abuse core & audio plugin implementation details to obtain the desired effect. */
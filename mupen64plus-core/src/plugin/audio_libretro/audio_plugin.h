@@ -23,8 +23,34 @@
 #define M64P_PLUGIN_EMULATE_SPEAKER_VIA_LIBRETRO_H
 
 #include <stddef.h>
+#include <stdint.h>
 
-void init_audio_libretro(unsigned max_frames);
+struct audio_libretro_stats
+{
+   uint64_t frames_in;          /* frames pushed by the AI */
+   uint64_t frames_out;         /* resampled frames handed to the frontend */
+   uint64_t dropped_frames;     /* frames lost to a full ring */
+   unsigned underruns;          /* retro_run calls which produced no audio */
+   unsigned max_batch_frames;   /* largest batch handed to the frontend at once */
+   uint64_t wait_usec;          /* time retro_run spent waiting on the resampler */
+};
+
+enum audio_resampler_type
+{
+   AUDIO_RESAMPLER_POLYPHASE_LOW,
+   AUDIO_RESAMPLER_POLYPHASE_MEDIUM,
+   AUDIO_RESAMPLER_POLYPHASE_HIGH,
+   AUDIO_RESAMPLER_SINC
+};
+
+void init_audio_libretro(unsigned max_frames, enum audio_resampler_type resampler_type);
 void deinit_audio_libretro(void);
 
+/* Hands every frame resampled so far to the frontend. Must be called from
+ * retro_run once the emulated frame is over. */
+void flush_audio_libretro(void);
+
+/* Merges the counters kept by the emulation thread and the resampler. */
+void audio_libretro_get_stats(struct audio_libretro_stats *stats);
+
 #endif
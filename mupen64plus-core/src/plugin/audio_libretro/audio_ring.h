@@ -0,0 +1,120 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - audio_ring.h                                            *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M64P_PLUGIN_AUDIO_RING_H
+#define M64P_PLUGIN_AUDIO_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <retro_inline.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/* Lock-free single producer / single consumer ring of stereo frames.
+ *
+ * Each element holds one frame as a 32-bit word. Only the producer moves
+ * head and only the consumer moves tail, so publishing an index with
+ * release semantics is enough to hand the frames over. Both sides access
+ * the frames in place through contiguous spans. */
+struct audio_ring
+{
+   uint32_t* frames;
+   size_t mask;
+   size_t head;
+   size_t tail;
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AUDIO_RING_LOAD(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define AUDIO_RING_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#elif defined(_MSC_VER)
+static INLINE size_t audio_ring_load(const size_t* p)
+{
+   size_t v = *(volatile const size_t*)p;
+   _ReadWriteBarrier();
+   return v;
+}
+#define AUDIO_RING_LOAD(p)     audio_ring_load(p)
+#define AUDIO_RING_STORE(p, v) do { _ReadWriteBarrier(); *(volatile size_t*)(p) = (v); } while (0)
+#else
+#define AUDIO_RING_LOAD(p)     (*(volatile const size_t*)(p))
+#define AUDIO_RING_STORE(p, v) (*(volatile size_t*)(p) = (v))
+#endif
+
+/* size must be a power of two */
+static INLINE int audio_ring_init(struct audio_ring* ring, size_t size)
+{
+   ring->frames = (uint32_t*)malloc(size * sizeof(uint32_t));
+   ring->mask   = size - 1;
+   ring->head   = 0;
+   ring->tail   = 0;
+   return ring->frames != NULL;
+}
+
+static INLINE void audio_ring_free(struct audio_ring* ring)
+{
+   free(ring->frames);
+   ring->frames = NULL;
+}
+
+/* Producer side: contiguous free space starting at *span. */
+static INLINE size_t audio_ring_write_span(struct audio_ring* ring, uint32_t** span)
+{
+   size_t head = ring->head;
+   size_t tail = AUDIO_RING_LOAD(&ring->tail);
+   size_t free_frames = ring->mask + 1 - (head - tail);
+   size_t to_end = ring->mask + 1 - (head & ring->mask);
+
+   *span = ring->frames + (head & ring->mask);
+   return (free_frames < to_end) ? free_frames : to_end;
+}
+
+static INLINE void audio_ring_commit(struct audio_ring* ring, size_t count)
+{
+   AUDIO_RING_STORE(&ring->head, ring->head + count);
+}
+
+/* Consumer side: contiguous readable frames starting at *span. */
+static INLINE size_t audio_ring_read_span(struct audio_ring* ring, const uint32_t** span)
+{
+   size_t tail = ring->tail;
+   size_t head = AUDIO_RING_LOAD(&ring->head);
+   size_t used = head - tail;
+   size_t to_end = ring->mask + 1 - (tail & ring->mask);
+
+   *span = ring->frames + (tail & ring->mask);
+   return (used < to_end) ? used : to_end;
+}
+
+static INLINE void audio_ring_consume(struct audio_ring* ring, size_t count)
+{
+   AUDIO_RING_STORE(&ring->tail, ring->tail + count);
+}
+
+static INLINE size_t audio_ring_readable(struct audio_ring* ring)
+{
+   return AUDIO_RING_LOAD(&ring->head) - AUDIO_RING_LOAD(&ring->tail);
+}
+
+#endif
@@ -0,0 +1,120 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - audio_thread.cpp                                        *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "audio_thread.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class AudioThread
+{
+public:
+    AudioThread(void task(void)) :
+        m_task(task),
+        m_pending(false),
+        m_busy(false),
+        m_quit(false),
+        m_thread(&AudioThread::do_work, this)
+    {
+    }
+
+    ~AudioThread() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_signal.notify_all();
+        m_thread.join();
+    }
+
+    void notify() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending = true;
+        }
+        m_signal.notify_all();
+    }
+
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return !m_pending && !m_busy; });
+    }
+
+private:
+    void (*m_task)(void);
+    bool m_pending;
+    bool m_busy;
+    bool m_quit;
+    std::mutex m_mutex;
+    std::condition_variable m_signal;
+    std::condition_variable m_done;
+    std::thread m_thread;
+
+    void do_work() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (;;) {
+            m_signal.wait(lock, [this] { return m_pending || m_quit; });
+            if (m_quit)
+                break;
+
+            m_pending = false;
+            m_busy = true;
+            lock.unlock();
+
+            m_task();
+
+            lock.lock();
+            m_busy = false;
+            m_done.notify_all();
+        }
+
+        // release anyone still waiting on us
+        m_pending = false;
+        m_busy = false;
+        m_done.notify_all();
+    }
+};
+
+static std::unique_ptr<AudioThread> audio_thread;
+
+void audio_thread_init(void task(void))
+{
+    audio_thread.reset(new AudioThread(task));
+}
+
+void audio_thread_notify(void)
+{
+    if (audio_thread)
+        audio_thread->notify();
+}
+
+void audio_thread_wait_idle(void)
+{
+    if (audio_thread)
+        audio_thread->wait_idle();
+}
+
+void audio_thread_close(void)
+{
+    audio_thread.reset();
+}
@@ -0,0 +1,317 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - polyphase_resampler.c                                   *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "polyphase_resampler.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <retro_inline.h>
+
+#if defined(ARCH_MIN_SSE2)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* DAC rate changes are rare, a few banks are plenty */
+#define POLYPHASE_BANK_CACHE 4
+
+struct polyphase_bank
+{
+   unsigned in_rate;
+   unsigned out_rate;
+   /* positions are kept in 1/denominator input frames */
+   uint32_t denominator;
+   uint32_t step_int;
+   uint32_t step_frac;
+   unsigned phases;
+   int16_t* coefs;     /* phases * taps, Q15 */
+};
+
+struct polyphase_resampler
+{
+   unsigned taps;
+   size_t capacity;
+   size_t length;      /* frames in the history */
+   size_t pos;         /* history index of the first tap of the next output */
+   uint32_t frac;
+   int16_t* left;
+   int16_t* right;
+   struct polyphase_bank banks[POLYPHASE_BANK_CACHE];
+   struct polyphase_bank* bank;
+   unsigned next_bank;
+};
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+   while (b != 0)
+   {
+      uint32_t t = a % b;
+      a = b;
+      b = t;
+   }
+   return a;
+}
+
+static int build_bank(struct polyphase_bank* bank, unsigned taps,
+      unsigned in_rate, unsigned out_rate)
+{
+   const int half = taps / 2;
+   double cutoff = 0.9;
+   uint32_t up, down, g;
+   unsigned p;
+   int k;
+
+   g    = gcd(in_rate, out_rate);
+   up   = out_rate / g;
+   down = in_rate / g;
+
+   bank->in_rate     = in_rate;
+   bank->out_rate    = out_rate;
+   bank->denominator = up;
+   bank->step_int    = down / up;
+   bank->step_frac   = down % up;
+   bank->phases      = (up <= POLYPHASE_MAX_PHASES) ? up : POLYPHASE_MAX_PHASES;
+
+   free(bank->coefs);
+   bank->coefs = (int16_t*)malloc(bank->phases * taps * sizeof(int16_t));
+   if (bank->coefs == NULL)
+   {
+      bank->in_rate = 0;
+      return 0;
+   }
+
+   if (out_rate < in_rate)
+      cutoff *= (double)out_rate / in_rate;
+
+   for (p = 0; p < bank->phases; ++p)
+   {
+      double h[32];
+      double sum = 0.0;
+      double frac = (double)p / bank->phases;
+
+      for (k = 0; k < (int)taps; ++k)
+      {
+         double d = k - (half - 1) - frac;
+         double w = 0.42 + 0.5 * cos(M_PI * d / half) + 0.08 * cos(2.0 * M_PI * d / half);
+         double s = (d == 0.0) ? cutoff : sin(M_PI * cutoff * d) / (M_PI * d);
+
+         h[k] = s * w;
+         sum += h[k];
+      }
+
+      for (k = 0; k < (int)taps; ++k)
+      {
+         long v = lround(h[k] / sum * 0x8000);
+         if (v > 0x7fff)
+            v = 0x7fff;
+         else if (v < -0x8000)
+            v = -0x8000;
+         bank->coefs[p * taps + k] = (int16_t)v;
+      }
+   }
+
+   return 1;
+}
+
+static INLINE int16_t dot_q15(const int16_t* x, const int16_t* h, unsigned taps)
+{
+   int32_t acc;
+   unsigned k;
+
+#if defined(ARCH_MIN_SSE2)
+   __m128i sum = _mm_setzero_si128();
+
+   for (k = 0; k < taps; k += 8)
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(
+               _mm_loadu_si128((const __m128i*)(x + k)),
+               _mm_loadu_si128((const __m128i*)(h + k))));
+
+   sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+   sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+   acc = _mm_cvtsi128_si32(sum);
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+   int32x4_t sum = vdupq_n_s32(0);
+   int32x2_t sum2;
+
+   for (k = 0; k < taps; k += 8)
+   {
+      sum = vmlal_s16(sum, vld1_s16(x + k),     vld1_s16(h + k));
+      sum = vmlal_s16(sum, vld1_s16(x + k + 4), vld1_s16(h + k + 4));
+   }
+
+   sum2 = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+   acc  = vget_lane_s32(vpadd_s32(sum2, sum2), 0);
+#else
+   acc = 0;
+   for (k = 0; k < taps; ++k)
+      acc += (int32_t)x[k] * h[k];
+#endif
+
+   acc = (acc + 0x4000) >> 15;
+   if (acc > 0x7fff)
+      return 0x7fff;
+   if (acc < -0x8000)
+      return -0x8000;
+   return (int16_t)acc;
+}
+
+static struct polyphase_bank* select_bank(struct polyphase_resampler* rs,
+      unsigned in_rate, unsigned out_rate)
+{
+   struct polyphase_bank* bank;
+   unsigned i;
+
+   if (rs->bank != NULL && rs->bank->in_rate == in_rate && rs->bank->out_rate == out_rate)
+      return rs->bank;
+
+   /* positions are expressed in the previous bank's denominator */
+   rs->frac = 0;
+
+   for (i = 0; i < POLYPHASE_BANK_CACHE; ++i)
+   {
+      if (rs->banks[i].in_rate == in_rate && rs->banks[i].out_rate == out_rate)
+         return rs->bank = &rs->banks[i];
+   }
+
+   bank = &rs->banks[rs->next_bank];
+   rs->next_bank = (rs->next_bank + 1) % POLYPHASE_BANK_CACHE;
+
+   if (!build_bank(bank, rs->taps, in_rate, out_rate))
+      return rs->bank = NULL;
+
+   return rs->bank = bank;
+}
+
+struct polyphase_resampler* polyphase_new(enum polyphase_quality quality, size_t max_frames)
+{
+   struct polyphase_resampler* rs = (struct polyphase_resampler*)calloc(1, sizeof(*rs));
+   if (rs == NULL)
+      return NULL;
+
+   switch (quality)
+   {
+      case POLYPHASE_LOW:  rs->taps = 8;  break;
+      case POLYPHASE_HIGH: rs->taps = 32; break;
+      default:             rs->taps = 16; break;
+   }
+
+   /* leftovers of the previous call plus one full call */
+   rs->capacity = 2 * (max_frames + rs->taps);
+   rs->left     = (int16_t*)calloc(rs->capacity, sizeof(int16_t));
+   rs->right    = (int16_t*)calloc(rs->capacity, sizeof(int16_t));
+
+   if (rs->left == NULL || rs->right == NULL)
+   {
+      polyphase_free(rs);
+      return NULL;
+   }
+
+   /* center the first output on the first input frame */
+   rs->length = rs->taps / 2 - 1;
+
+   return rs;
+}
+
+void polyphase_free(struct polyphase_resampler* rs)
+{
+   unsigned i;
+
+   if (rs == NULL)
+      return;
+
+   for (i = 0; i < POLYPHASE_BANK_CACHE; ++i)
+      free(rs->banks[i].coefs);
+
+   free(rs->left);
+   free(rs->right);
+   free(rs);
+}
+
+size_t polyphase_process(struct polyphase_resampler* rs,
+      unsigned in_rate, unsigned out_rate,
+      const uint32_t* in, size_t* frames,
+      int16_t* out, size_t max_out)
+{
+   const struct polyphase_bank* bank;
+   const unsigned taps = rs->taps;
+   size_t produced = 0;
+   size_t consumed;
+   size_t count = *frames;
+   size_t i;
+
+   *frames = 0;
+
+   if (in_rate == 0 || out_rate == 0)
+      return 0;
+
+   bank = select_bank(rs, in_rate, out_rate);
+   if (bank == NULL)
+      return 0;
+
+   if (count > rs->capacity - rs->length)
+      count = rs->capacity - rs->length;
+
+   for (i = 0; i < count; ++i)
+   {
+      rs->left[rs->length + i]  = (int16_t)(in[i] >> 16);
+      rs->right[rs->length + i] = (int16_t)(in[i]);
+   }
+   rs->length += count;
+   *frames     = count;
+
+   while (rs->pos + taps <= rs->length && produced < max_out)
+   {
+      uint32_t phase = (bank->phases == bank->denominator)
+         ? rs->frac
+         : (uint32_t)(((uint64_t)rs->frac * bank->phases) / bank->denominator);
+      const int16_t* h = bank->coefs + phase * taps;
+
+      out[2 * produced]     = dot_q15(rs->left  + rs->pos, h, taps);
+      out[2 * produced + 1] = dot_q15(rs->right + rs->pos, h, taps);
+      ++produced;
+
+      rs->pos  += bank->step_int;
+      rs->frac += bank->step_frac;
+      if (rs->frac >= bank->denominator)
+      {
+         rs->frac -= bank->denominator;
+         ++rs->pos;
+      }
+   }
+
+   /* drop the frames no future output will touch */
+   consumed = (rs->pos < rs->length) ? rs->pos : rs->length;
+   if (consumed != 0)
+   {
+      memmove(rs->left,  rs->left  + consumed, (rs->length - consumed) * sizeof(int16_t));
+      memmove(rs->right, rs->right + consumed, (rs->length - consumed) * sizeof(int16_t));
+      rs->length -= consumed;
+      rs->pos    -= consumed;
+   }
+
+   return produced;
+}
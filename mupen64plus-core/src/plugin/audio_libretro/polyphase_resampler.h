@@ -0,0 +1,63 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - polyphase_resampler.h                                   *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M64P_PLUGIN_POLYPHASE_RESAMPLER_H
+#define M64P_PLUGIN_POLYPHASE_RESAMPLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Fixed-ratio polyphase resampler for the AI DAC.
+ *
+ * The DAC rate is vi_clock / (AI_DACRATE + 1), so only a handful of
+ * (input rate, output rate) pairs ever show up. For each pair the exact
+ * ratio is reduced to out/in = L/M and a bank of windowed sinc filters,
+ * one per phase, is computed once in Q15. When L is too large the phases
+ * are quantized to POLYPHASE_MAX_PHASES steps.
+ *
+ * Input frames are taken straight from their RDRAM layout (left sample in
+ * the upper half of each word) and filtering is done in int16 / int32. */
+
+enum polyphase_quality
+{
+   POLYPHASE_LOW,     /*  8 taps per phase */
+   POLYPHASE_MEDIUM,  /* 16 taps per phase */
+   POLYPHASE_HIGH     /* 32 taps per phase */
+};
+
+#define POLYPHASE_MAX_PHASES 256
+
+struct polyphase_resampler;
+
+/* max_frames is the largest number of input frames passed to a single
+ * polyphase_process call. */
+struct polyphase_resampler* polyphase_new(enum polyphase_quality quality, size_t max_frames);
+void polyphase_free(struct polyphase_resampler* rs);
+
+/* Resamples *frames AI frames from in_rate to out_rate and writes up to
+ * max_out interleaved stereo frames to out. Input is only taken while the
+ * filter history has room, *frames is set to the number of input frames
+ * taken (0 on error). Returns the number of frames written. */
+size_t polyphase_process(struct polyphase_resampler* rs,
+      unsigned in_rate, unsigned out_rate,
+      const uint32_t* in, size_t* frames,
+      int16_t* out, size_t max_out);
+
+#endif
@@ -27,6 +27,7 @@
 
 #include "r4300/r4300_core.h"
 #include "../rdp/rdp_core.h"
+#include "../ri/rdram_gen.h"
 #include "../rsp/rsp_core.h"
 
 #include "../vi/vi_controller.h"
@@ -152,6 +153,11 @@ static m64p_error plugin_start_gfx(void)
    gfx_info.VI_X_SCALE_REG = &(g_dev.vi.regs[VI_X_SCALE_REG]);
    gfx_info.VI_Y_SCALE_REG = &(g_dev.vi.regs[VI_Y_SCALE_REG]);
    gfx_info.CheckInterrupts = EmptyFunc;
+   gfx_info.RDRAM_PAGE_GEN = g_rdram_gen.pages;
+   gfx_info.RDRAM_GEN_EPOCH = &g_rdram_gen.epoch;
+   gfx_info.RDRAM_GEN_FLOOR = &g_rdram_gen.floor;
+   gfx_info.RDRAM_GEN_SHIFT = RDRAM_GEN_PAGE_SHIFT;
+   gfx_info.RDRAM_GEN_PAGES = RDRAM_GEN_PAGE_COUNT;
 
    /* call the audio plugin */
    if (!gfx.initiateGFX(gfx_info))
@@ -38,6 +38,7 @@
 #include "cp0_private.h"
 #include "cp1_private.h"
 #include "exception.h"
+#include "idle_loop.h"
 #include "interrupt.h"
 #include "macros.h"
 #include "main/main.h"
@@ -137,9 +138,16 @@ uint32_t jump_to_address;
    static void name##_IDLE(void) \
    { \
       const int take_jump = (condition); \
+      const uint32_t jump_target = (destination); \
       int skip; \
       if (cop1 && check_cop1_unusable()) return; \
-      if (take_jump) \
+      if (take_jump && jump_target != PCADDR) \
+      { \
+         cp0_update_count(); \
+         idle_loop_fast_forward(jump_target, PCADDR); \
+         name(); \
+      } \
+      else if (take_jump) \
       { \
          cp0_update_count(); \
          skip = next_interrupt - g_cp0_regs[CP0_COUNT_REG]; \
@@ -635,3 +643,18 @@ void invalidate_cached_code_hacktarux(uint32_t address, size_t size)
    }
 }
 
+/* Code is compiled a page at a time, each valid page is one block */
+unsigned int count_cached_code_hacktarux(uint32_t address, size_t size)
+{
+   unsigned int count = 0;
+   uint32_t i;
+
+   for (i = address >> 12; i <= (address + size - 1) >> 12; i++)
+   {
+      if (invalid_code[i] == 0 && blocks[i] != NULL)
+         count++;
+   }
+
+   return count;
+}
+
@@ -40,6 +40,7 @@ void free_blocks(void);
 void jump_to_func(void);
 
 void invalidate_cached_code_hacktarux(uint32_t address, size_t size);
+unsigned int count_cached_code_hacktarux(uint32_t address, size_t size);
 
 /* Jumps to the given address. This is for the cached interpreter / dynarec. */
 #define jump_to(a) { jump_to_address = a; jump_to_func(); }
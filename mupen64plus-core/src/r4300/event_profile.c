@@ -0,0 +1,237 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - event_profile.c                                         *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#include "event_profile.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "api/callbacks.h"
+
+#if defined(WIN32) && !defined(__MINGW32__)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+int event_profile_enabled = 0;
+
+static m64p_event_stats l_stats[M64P_EVENT_TYPES];
+
+static const char* const l_names[M64P_EVENT_TYPES] =
+{
+   "VI", "COMPARE", "CHECK", "SI", "PI", "SPECIAL",
+   "AI", "SP", "DP", "HW2", "NMI", "CART"
+};
+
+/* event being timed, -1 if none */
+static int l_current = -1;
+static size_t l_current_depth;
+static unsigned int l_current_count;
+static uint64_t l_start;
+
+static FILE* l_trace = NULL;
+static uint64_t l_trace_origin;
+static int l_trace_events;
+
+#if defined(WIN32) && !defined(__MINGW32__)
+static uint64_t get_time_ns(void)
+{
+   static LARGE_INTEGER freq = { 0 };
+   LARGE_INTEGER counter;
+
+   if (freq.QuadPart == 0)
+      QueryPerformanceFrequency(&freq);
+
+   QueryPerformanceCounter(&counter);
+   return (uint64_t)(counter.QuadPart / freq.QuadPart) * 1000000000
+      + (uint64_t)(counter.QuadPart % freq.QuadPart) * 1000000000 / freq.QuadPart;
+}
+#else
+static uint64_t get_time_ns(void)
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+#endif
+
+static int type_index(int type)
+{
+   int i;
+
+   for (i = 0; i < M64P_EVENT_TYPES; ++i)
+   {
+      if (type == (1 << i))
+         return i;
+   }
+
+   return -1;
+}
+
+static unsigned int histogram_bucket(uint64_t ns)
+{
+   unsigned int bucket = 0;
+
+   ns >>= 8;
+   while (ns != 0 && bucket < M64P_EVENT_HISTOGRAM_BUCKETS - 1)
+   {
+      ns >>= 1;
+      ++bucket;
+   }
+
+   return bucket;
+}
+
+static void close_trace(void)
+{
+   if (l_trace == NULL)
+      return;
+
+   fputs("\n]}\n", l_trace);
+   fclose(l_trace);
+   l_trace = NULL;
+}
+
+static void reset_stats(void)
+{
+   memset(l_stats, 0, sizeof(l_stats));
+   l_current = -1;
+}
+
+int event_profile_enable(int enable, const char* trace_path)
+{
+   close_trace();
+   reset_stats();
+
+   event_profile_enabled = enable;
+   if (!enable || trace_path == NULL)
+      return 1;
+
+   l_trace = fopen(trace_path, "w");
+   if (l_trace == NULL)
+   {
+      DebugMessage(M64MSG_ERROR, "Failed to create event trace file '%s'", trace_path);
+      return 0;
+   }
+
+   fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", l_trace);
+   l_trace_origin = get_time_ns();
+   l_trace_events = 0;
+
+   return 1;
+}
+
+void event_profile_begin(int type, size_t queue_depth, unsigned int count)
+{
+   l_current = type_index(type);
+   if (l_current < 0)
+      return;
+
+   l_current_depth = queue_depth;
+   l_current_count = count;
+   l_start = get_time_ns();
+}
+
+void event_profile_end(void)
+{
+   m64p_event_stats* stats;
+   uint64_t duration;
+
+   if (l_current < 0)
+      return;
+
+   duration = get_time_ns() - l_start;
+   stats = &l_stats[l_current];
+
+   stats->count++;
+   stats->total_ns += duration;
+   if (duration > stats->max_ns)
+      stats->max_ns = duration;
+   stats->histogram[histogram_bucket(duration)]++;
+   stats->depth_sum += l_current_depth;
+   if (l_current_depth > stats->max_depth)
+      stats->max_depth = (unsigned int)l_current_depth;
+
+   if (l_trace != NULL)
+   {
+      uint64_t ts = l_start - l_trace_origin;
+
+      fprintf(l_trace, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":0,"
+            "\"ts\":%llu.%03u,\"dur\":%llu.%03u,"
+            "\"args\":{\"depth\":%u,\"count\":%u}}",
+            (l_trace_events++ == 0) ? "" : ",\n",
+            l_names[l_current],
+            (unsigned long long)(ts / 1000), (unsigned int)(ts % 1000),
+            (unsigned long long)(duration / 1000), (unsigned int)(duration % 1000),
+            (unsigned int)l_current_depth, l_current_count);
+   }
+
+   l_current = -1;
+}
+
+void event_profile_get(m64p_event_stats* stats, int num_types)
+{
+   int i;
+
+   if (num_types > M64P_EVENT_TYPES)
+      num_types = M64P_EVENT_TYPES;
+
+   for (i = 0; i < num_types; ++i)
+   {
+      stats[i] = l_stats[i];
+      stats[i].type = 1 << i;
+      stats[i].name = l_names[i];
+   }
+}
+
+void event_profile_stop(void)
+{
+   uint64_t total_ns = 0;
+   int i;
+
+   close_trace();
+
+   if (!event_profile_enabled)
+      return;
+
+   for (i = 0; i < M64P_EVENT_TYPES; ++i)
+      total_ns += l_stats[i].total_ns;
+
+   for (i = 0; i < M64P_EVENT_TYPES; ++i)
+   {
+      const m64p_event_stats* stats = &l_stats[i];
+
+      if (stats->count == 0)
+         continue;
+
+      DebugMessage(M64MSG_INFO,
+            "Event %-7s: %llu events, %llu us total (%.1f%%), %llu ns avg, %llu ns max, %.2f avg depth",
+            l_names[i],
+            stats->count,
+            stats->total_ns / 1000,
+            (total_ns != 0) ? 100.0 * stats->total_ns / total_ns : 0.0,
+            stats->total_ns / stats->count,
+            stats->max_ns,
+            (double)stats->depth_sum / stats->count);
+   }
+}
@@ -0,0 +1,51 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - event_profile.h                                         *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef M64P_R4300_EVENT_PROFILE_H
+#define M64P_R4300_EVENT_PROFILE_H
+
+#include <stddef.h>
+
+#include "api/m64p_types.h"
+
+/* Host time profiling of the interrupt queue event handlers.
+ *
+ * gen_interrupt brackets every handler with event_profile_begin/end, which
+ * measure the handler duration and sample the depth of the event queue.
+ * Durations are accumulated per event type, with a log2 histogram, and can
+ * optionally be streamed to a Chrome trace file (chrome://tracing or
+ * Perfetto) to see which handlers dominate a frame. */
+
+extern int event_profile_enabled;
+
+/* Clears the statistics. Enabling with a non NULL trace_path also starts a
+ * new trace file. Returns 0 if the trace file could not be created. */
+int event_profile_enable(int enable, const char* trace_path);
+
+void event_profile_begin(int type, size_t queue_depth, unsigned int count);
+void event_profile_end(void);
+
+void event_profile_get(m64p_event_stats* stats, int num_types);
+
+/* Prints the statistics and closes the trace file. */
+void event_profile_stop(void);
+
+#endif /* M64P_R4300_EVENT_PROFILE_H */
@@ -45,6 +45,7 @@
 #include "r4300/ops.h"
 #include "r4300/recomp.h"
 #include "r4300/recomph.h"
+#include "ri/rdram_gen.h"
 #include "r4300/exception.h"
 
 #if !defined(offsetof)
@@ -1413,7 +1414,9 @@ void genbeq_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BEQ_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BEQ_IDLE, 1);
       return;
@@ -1467,7 +1470,9 @@ void genbne_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BNE_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BNE_IDLE, 1);
       return;
@@ -1521,7 +1526,9 @@ void genblez_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BLEZ_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BLEZ_IDLE, 1);
       return;
@@ -1575,7 +1582,9 @@ void genbgtz_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BGTZ_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BGTZ_IDLE, 1);
       return;
@@ -1893,7 +1902,9 @@ void genbeql_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BEQL_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BEQL_IDLE, 1);
       return;
@@ -1947,7 +1958,9 @@ void genbnel_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BNEL_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BNEL_IDLE, 1);
       return;
@@ -2001,7 +2014,9 @@ void genblezl_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BLEZL_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BLEZL_IDLE, 1);
       return;
@@ -2055,7 +2070,9 @@ void genbgtzl_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BGTZL_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BGTZL_IDLE, 1);
       return;
@@ -2726,6 +2743,8 @@ void gensb(void)
    mov_reg64_imm64(RSI, (uint64_t) invalid_code);
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_reg64_imm64(RDI, (uint64_t) g_rdram_cpu_dirty);
+   mov_preg64preg64_imm8(RBX, RDI, 1);
    cmp_preg64preg64_imm8(RBX, RSI, 0);
    jne_rj(65);
 
@@ -2778,6 +2797,7 @@ void gensb(void)
 
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_preg32pimm32_imm8(EBX, (unsigned int)g_rdram_cpu_dirty, 1);
    cmp_preg32pimm32_imm8(EBX, (unsigned int)invalid_code, 0);
    jne_rj(54);
    mov_reg32_reg32(ECX, EBX); // 2
@@ -2842,6 +2862,8 @@ void gensh(void)
    mov_reg64_imm64(RSI, (uint64_t) invalid_code);
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_reg64_imm64(RDI, (uint64_t) g_rdram_cpu_dirty);
+   mov_preg64preg64_imm8(RBX, RDI, 1);
    cmp_preg64preg64_imm8(RBX, RSI, 0);
    jne_rj(65);
 
@@ -2894,6 +2916,7 @@ void gensh(void)
 
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_preg32pimm32_imm8(EBX, (unsigned int)g_rdram_cpu_dirty, 1);
    cmp_preg32pimm32_imm8(EBX, (unsigned int)invalid_code, 0);
    jne_rj(54);
    mov_reg32_reg32(ECX, EBX); // 2
@@ -2962,6 +2985,8 @@ void gensw(void)
    mov_reg64_imm64(RSI, (uint64_t) invalid_code);
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_reg64_imm64(RDI, (uint64_t) g_rdram_cpu_dirty);
+   mov_preg64preg64_imm8(RBX, RDI, 1);
    cmp_preg64preg64_imm8(RBX, RSI, 0);
    jne_rj(65);
 
@@ -3013,6 +3038,7 @@ void gensw(void)
 
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_preg32pimm32_imm8(EBX, (unsigned int)g_rdram_cpu_dirty, 1);
    cmp_preg32pimm32_imm8(EBX, (unsigned int)invalid_code, 0);
    jne_rj(54);
    mov_reg32_reg32(ECX, EBX); // 2
@@ -3294,6 +3320,8 @@ void genswc1(void)
    mov_reg64_imm64(RSI, (uint64_t) invalid_code);
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_reg64_imm64(RDI, (uint64_t) g_rdram_cpu_dirty);
+   mov_preg64preg64_imm8(RBX, RDI, 1);
    cmp_preg64preg64_imm8(RBX, RSI, 0);
    jne_rj(65);
 
@@ -3344,6 +3372,7 @@ void genswc1(void)
 
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_preg32pimm32_imm8(EBX, (unsigned int)g_rdram_cpu_dirty, 1);
    cmp_preg32pimm32_imm8(EBX, (unsigned int)invalid_code, 0);
    jne_rj(54);
    mov_reg32_reg32(ECX, EBX); // 2
@@ -3411,6 +3440,8 @@ void gensdc1(void)
    mov_reg64_imm64(RSI, (uint64_t) invalid_code);
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_reg64_imm64(RDI, (uint64_t) g_rdram_cpu_dirty);
+   mov_preg64preg64_imm8(RBX, RDI, 1);
    cmp_preg64preg64_imm8(RBX, RSI, 0);
    jne_rj(65);
 
@@ -3464,6 +3495,7 @@ void gensdc1(void)
 
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_preg32pimm32_imm8(EBX, (unsigned int)g_rdram_cpu_dirty, 1);
    cmp_preg32pimm32_imm8(EBX, (unsigned int)invalid_code, 0);
    jne_rj(54);
    mov_reg32_reg32(ECX, EBX); // 2
@@ -3531,6 +3563,8 @@ void gensd(void)
    mov_reg64_imm64(RSI, (uint64_t) invalid_code);
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_reg64_imm64(RDI, (uint64_t) g_rdram_cpu_dirty);
+   mov_preg64preg64_imm8(RBX, RDI, 1);
    cmp_preg64preg64_imm8(RBX, RSI, 0);
    jne_rj(65);
 
@@ -3586,6 +3620,7 @@ void gensd(void)
 
    mov_reg32_reg32(EBX, EAX);
    shr_reg32_imm8(EBX, 12);
+   mov_preg32pimm32_imm8(EBX, (unsigned int)g_rdram_cpu_dirty, 1);
    cmp_preg32pimm32_imm8(EBX, (unsigned int)invalid_code, 0);
    jne_rj(54);
    mov_reg32_reg32(ECX, EBX); // 2
@@ -5676,7 +5711,9 @@ void genbltz_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BLTZ_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BLTZ_IDLE, 1);
       return;
@@ -5780,7 +5817,9 @@ void genbgez_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BGEZ_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BGEZ_IDLE, 1);
       return;
@@ -5834,7 +5873,9 @@ void genbltzl_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BLTZL_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BLTZL_IDLE, 1);
       return;
@@ -5888,7 +5929,9 @@ void genbgezl_idle(void)
    gencallinterp((native_type)cached_interpreter_table.BGEZL_IDLE, 1);
 #else
    if (((dst->addr & 0xFFF) == 0xFFC && 
-            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump)
+            (dst->addr < 0x80000000 || dst->addr >= 0xC0000000))||no_compiled_jump
+         /* polling loops are fast-forwarded by the interpreter */
+         || dst->f.i.immediate != -1)
    {
       gencallinterp((native_type)cached_interpreter_table.BGEZL_IDLE, 1);
       return;
@@ -0,0 +1,333 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - idle_loop.c                                             *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "api/callbacks.h"
+#include "api/m64p_types.h"
+#include "cp0_private.h"
+#include "idle_loop.h"
+#include "memory/memory.h"
+#include "r4300.h"
+
+/* Loads whose base register is not written inside the loop can only be
+ * resolved at run time. Loops with more of them are assumed to poll Count. */
+#define IDLE_LOOP_MAX_RUNTIME_LOADS 4
+
+#define IDLE_LOOP_CACHE_SIZE 256
+
+struct idle_loop_entry
+{
+   uint32_t branch_addr;
+   uint32_t target;
+   uint32_t branch_op;
+   uint32_t target_op;
+   unsigned char kind;
+   unsigned char runtime_loads;
+   unsigned char base[IDLE_LOOP_MAX_RUNTIME_LOADS];
+   int16_t offset[IDLE_LOOP_MAX_RUNTIME_LOADS];
+};
+
+int idle_loop_enabled = 1;
+struct idle_loop_stats g_idle_loop_stats;
+
+static struct idle_loop_entry cache[IDLE_LOOP_CACHE_SIZE];
+
+/* Decoded register usage of one instruction */
+struct loop_op
+{
+   uint32_t reads;
+   uint32_t writes;
+   int is_branch;
+   int is_load;
+   int reads_count;
+};
+
+/* VI_CURRENT and AI_LEN are computed from Count when read, so polling them
+ * behaves like polling Count. */
+static int is_count_derived_address(uint32_t address)
+{
+   if ((address & UINT32_C(0xc0000000)) != UINT32_C(0x80000000))
+      return 0;
+
+   address &= UINT32_C(0x1fffffff);
+   return (address >= UINT32_C(0x04400000) && address < UINT32_C(0x04600000));
+}
+
+static int decode_loop_op(uint32_t op, struct loop_op *d)
+{
+   unsigned int rs = (op >> 21) & 0x1F;
+   unsigned int rt = (op >> 16) & 0x1F;
+   unsigned int rd = (op >> 11) & 0x1F;
+
+   memset(d, 0, sizeof(*d));
+
+   switch ((op >> 26) & 0x3F)
+   {
+      case 0: /* SPECIAL */
+         switch (op & 0x3F)
+         {
+            case 0: case 2: case 3:              /* SLL, SRL, SRA */
+            case 56: case 58: case 59:           /* DSLL, DSRL, DSRA */
+            case 60: case 62: case 63:           /* DSLL32, DSRL32, DSRA32 */
+               d->reads = 1u << rt;
+               d->writes = 1u << rd;
+               return 1;
+            case 4: case 6: case 7:              /* SLLV, SRLV, SRAV */
+            case 32: case 33: case 34: case 35:  /* ADD, ADDU, SUB, SUBU */
+            case 36: case 37: case 38: case 39:  /* AND, OR, XOR, NOR */
+            case 42: case 43:                    /* SLT, SLTU */
+            case 44: case 45: case 46: case 47:  /* DADD, DADDU, DSUB, DSUBU */
+               d->reads = (1u << rs) | (1u << rt);
+               d->writes = 1u << rd;
+               return 1;
+            case 15:                             /* SYNC */
+               return 1;
+            default:
+               return 0;
+         }
+      case 1: /* REGIMM: BLTZ, BGEZ, BLTZL, BGEZL (no linking) */
+         if (rt > 3)
+            return 0;
+         d->reads = 1u << rs;
+         d->is_branch = 1;
+         return 1;
+      case 4: case 5:   /* BEQ, BNE */
+      case 20: case 21: /* BEQL, BNEL */
+         d->reads = (1u << rs) | (1u << rt);
+         d->is_branch = 1;
+         return 1;
+      case 6: case 7:   /* BLEZ, BGTZ */
+      case 22: case 23: /* BLEZL, BGTZL */
+         d->reads = 1u << rs;
+         d->is_branch = 1;
+         return 1;
+      case 8: case 9: case 10: case 11: /* ADDI, ADDIU, SLTI, SLTIU */
+      case 12: case 13: case 14:        /* ANDI, ORI, XORI */
+      case 24: case 25:                 /* DADDI, DADDIU */
+         d->reads = 1u << rs;
+         d->writes = 1u << rt;
+         return 1;
+      case 15: /* LUI */
+         d->writes = 1u << rt;
+         return 1;
+      case 16: /* COP0: only MFC0 is free of side effects */
+         if (rs != 0)
+            return 0;
+         d->writes = 1u << rt;
+         d->reads_count = (rd == CP0_COUNT_REG || rd == CP0_RANDOM_REG);
+         return 1;
+      case 32: case 33: case 35: /* LB, LH, LW */
+      case 36: case 37: case 39: /* LBU, LHU, LWU */
+      case 55:                   /* LD */
+         d->reads = 1u << rs;
+         d->writes = 1u << rt;
+         d->is_load = 1;
+         return 1;
+      default:
+         return 0;
+   }
+}
+
+static void classify(struct idle_loop_entry *e, const uint32_t *code)
+{
+   uint32_t loop_written = 0, written = 0;
+   uint32_t const_mask = 1;
+   uint32_t const_val[32];
+   size_t length = ((e->branch_addr - e->target) >> 2) + 2;
+   size_t i;
+   struct loop_op d;
+
+   e->kind = IDLE_LOOP_NONE;
+   e->runtime_loads = 0;
+   const_val[0] = 0;
+
+   /* first pass: reject side effects and collect written registers */
+   for (i = 0; i < length; i++)
+   {
+      if (!decode_loop_op(code[i], &d))
+         return;
+      if (d.is_branch != (i == length - 2))
+         return;
+      loop_written |= d.writes;
+   }
+   loop_written &= ~UINT32_C(1);
+
+   /* second pass: reject values carried between iterations and find out
+    * what the loads are polling */
+   e->kind = IDLE_LOOP_MEMORY;
+   for (i = 0; i < length; i++)
+   {
+      uint32_t op = code[i];
+      unsigned int rs = (op >> 21) & 0x1F;
+      unsigned int rt = (op >> 16) & 0x1F;
+
+      decode_loop_op(op, &d);
+
+      if (d.reads & loop_written & ~written)
+      {
+         e->kind = IDLE_LOOP_NONE;
+         return;
+      }
+
+      if (d.reads_count)
+         e->kind = IDLE_LOOP_COUNT;
+
+      if (d.is_load)
+      {
+         if (const_mask & (1u << rs))
+         {
+            if (is_count_derived_address(const_val[rs] + (int16_t)op))
+               e->kind = IDLE_LOOP_COUNT;
+         }
+         else if (!(loop_written & (1u << rs))
+               && e->runtime_loads < IDLE_LOOP_MAX_RUNTIME_LOADS)
+         {
+            e->base[e->runtime_loads] = rs;
+            e->offset[e->runtime_loads] = (int16_t)op;
+            e->runtime_loads++;
+         }
+         else
+            e->kind = IDLE_LOOP_COUNT;
+      }
+
+      /* track constants built with LUI/ADDIU/ORI for load addresses */
+      if (d.writes & ~UINT32_C(1))
+      {
+         int is_const = 0;
+
+         switch ((op >> 26) & 0x3F)
+         {
+            case 15: /* LUI */
+               const_val[rt] = (uint32_t)(op & 0xFFFF) << 16;
+               is_const = 1;
+               break;
+            case 9: /* ADDIU */
+               if (const_mask & (1u << rs))
+               {
+                  const_val[rt] = const_val[rs] + (int16_t)op;
+                  is_const = 1;
+               }
+               break;
+            case 13: /* ORI */
+               if (const_mask & (1u << rs))
+               {
+                  const_val[rt] = const_val[rs] | (op & 0xFFFF);
+                  is_const = 1;
+               }
+               break;
+            default:
+               break;
+         }
+
+         if (is_const)
+            const_mask |= d.writes;
+         else
+            const_mask &= ~d.writes;
+      }
+
+      written |= d.writes;
+   }
+}
+
+int idle_loop_detect(uint32_t target, uint32_t branch_addr)
+{
+   struct idle_loop_entry *e;
+   const uint32_t *code;
+   uint32_t page = branch_addr & ~UINT32_C(0xFFF);
+
+   if (!idle_loop_enabled)
+      return IDLE_LOOP_NONE;
+
+   /* The whole loop, delay slot included, has to live in the page of the
+    * branch being executed so that reading it can't fault. */
+   if (target >= branch_addr
+         || branch_addr - target > (IDLE_LOOP_MAX_LENGTH - 2) * 4
+         || (target & ~UINT32_C(0xFFF)) != page
+         || ((branch_addr + 4) & ~UINT32_C(0xFFF)) != page)
+      return IDLE_LOOP_NONE;
+
+   code = fast_mem_access(page);
+   if (code == NULL)
+      return IDLE_LOOP_NONE;
+
+   e = &cache[(branch_addr >> 2) & (IDLE_LOOP_CACHE_SIZE - 1)];
+   code += (target & 0xFFF) >> 2;
+
+   if (e->branch_addr != branch_addr || e->target != target
+         || e->target_op != code[0]
+         || e->branch_op != code[(branch_addr - target) >> 2])
+   {
+      e->branch_addr = branch_addr;
+      e->target = target;
+      e->target_op = code[0];
+      e->branch_op = code[(branch_addr - target) >> 2];
+      classify(e, code);
+      if (e->kind != IDLE_LOOP_NONE)
+         g_idle_loop_stats.loops_detected++;
+   }
+
+   return e->kind;
+}
+
+void idle_loop_fast_forward(uint32_t target, uint32_t branch_addr)
+{
+   const struct idle_loop_entry *e;
+   int kind = idle_loop_detect(target, branch_addr);
+   int skip;
+   unsigned int i;
+
+   if (kind == IDLE_LOOP_NONE)
+      return;
+
+   e = &cache[(branch_addr >> 2) & (IDLE_LOOP_CACHE_SIZE - 1)];
+   for (i = 0; i < e->runtime_loads && kind == IDLE_LOOP_MEMORY; i++)
+   {
+      if (is_count_derived_address((uint32_t)reg[e->base[i]] + e->offset[i]))
+         kind = IDLE_LOOP_COUNT;
+   }
+
+   skip = next_interrupt - g_cp0_regs[CP0_COUNT_REG];
+   if (kind == IDLE_LOOP_COUNT && skip > IDLE_LOOP_COUNT_QUANTUM)
+      skip = IDLE_LOOP_COUNT_QUANTUM;
+   if (skip <= 3)
+      return;
+
+   skip &= ~3;
+   g_cp0_regs[CP0_COUNT_REG] += skip;
+
+   g_idle_loop_stats.fast_forwards++;
+   g_idle_loop_stats.cycles_skipped += skip;
+}
+
+void idle_loop_init(void)
+{
+   memset(cache, 0, sizeof(cache));
+   memset(&g_idle_loop_stats, 0, sizeof(g_idle_loop_stats));
+}
+
+void idle_loop_stats_print(void)
+{
+   DebugMessage(M64MSG_INFO, "Idle loops: %u detected, %llu fast-forwards, %llu cycles skipped",
+         g_idle_loop_stats.loops_detected,
+         (unsigned long long)g_idle_loop_stats.fast_forwards,
+         (unsigned long long)g_idle_loop_stats.cycles_skipped);
+}
@@ -0,0 +1,73 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - idle_loop.h                                             *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M64P_R4300_IDLE_LOOP_H
+#define M64P_R4300_IDLE_LOOP_H
+
+#include <stdint.h>
+
+/* Generalized busy wait detection.
+ *
+ * A backward branch forms a polling loop when every instruction between the
+ * branch target and the delay slot is free of side effects (loads, ALU ops,
+ * MFC0) and no register value is carried from one iteration to the next.
+ * Such a loop computes the same result on every iteration until either
+ * memory or Count changes. Memory only changes when an interrupt queue event
+ * is handled, so Count can be advanced straight to the next event.
+ *
+ * Loops which read Count (or the VI/AI registers which are derived from it)
+ * could exit at any time, so they are only fast-forwarded by
+ * IDLE_LOOP_COUNT_QUANTUM cycles per iteration. */
+
+enum idle_loop_kind
+{
+   IDLE_LOOP_NONE = 0,
+   IDLE_LOOP_MEMORY,   /* polls memory or hardware registers */
+   IDLE_LOOP_COUNT     /* polls CP0 Count or a Count derived register */
+};
+
+/* Longest loop body (in instructions, delay slot included) considered. */
+#define IDLE_LOOP_MAX_LENGTH    16
+/* Upper bound of cycles skipped per iteration of a Count polling loop. */
+#define IDLE_LOOP_COUNT_QUANTUM 0x400
+
+struct idle_loop_stats
+{
+   unsigned int loops_detected;
+   uint64_t fast_forwards;
+   uint64_t cycles_skipped;
+};
+
+extern int idle_loop_enabled;
+extern struct idle_loop_stats g_idle_loop_stats;
+
+void idle_loop_init(void);
+
+/* Classifies the loop formed by the branch at branch_addr jumping back to
+ * target. Results are cached, so this is cheap enough to call per branch. */
+int idle_loop_detect(uint32_t target, uint32_t branch_addr);
+
+/* Advances Count for a taken loop branch. Must be called after
+ * cp0_update_count() and before the branch itself is executed. */
+void idle_loop_fast_forward(uint32_t target, uint32_t branch_addr);
+
+void idle_loop_stats_print(void);
+
+#endif /* M64P_R4300_IDLE_LOOP_H */
@@ -34,6 +34,7 @@
 #include "cached_interp.h"
 #include "cp0_private.h"
 #include "dd/dd_controller.h"
+#include "event_profile.h"
 #include "exception.h"
 #include "main/main.h"
 #include "main/device.h"
@@ -537,6 +538,9 @@ void gen_interrupt(void)
       return;
    } 
 
+   if (event_profile_enabled)
+      event_profile_begin(q.first->data.type, q.pool.index, q.first->data.count);
+
    switch(q.first->data.type)
    {
       case SPECIAL_INT:
@@ -546,6 +550,9 @@ void gen_interrupt(void)
       case VI_INT:
          remove_interrupt_event();
          vi_vertical_interrupt_event(&g_dev.vi);
+         /* stop timing before switching back to the frontend */
+         if (event_profile_enabled)
+            event_profile_end();
          retro_return(false);
          break;
 
@@ -611,5 +618,8 @@ void gen_interrupt(void)
          wrapped_exception_general();
          break;
    }
+
+   if (event_profile_enabled)
+      event_profile_end();
 }
 
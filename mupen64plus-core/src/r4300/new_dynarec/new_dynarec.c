@@ -52,6 +52,7 @@ extern "C" {
 #include "../cached_interp.h"
 #include "../cp0_private.h"
 #include "../cp1_private.h"
+#include "../idle_loop.h"
 #include "../main/main.h"
 #include "../main/rom.h"
 #include "../interrupt.h"
@@ -1300,6 +1301,27 @@ void invalidate_cached_code_new_dynarec(uint32_t address, size_t size)
         invalidate_block(i);
 }
 
+// Counts the blocks with an entry point in the given range, found in the
+// same jump_in list invalidate_block clears
+unsigned int count_cached_code_new_dynarec(uint32_t addr, size_t size)
+{
+    unsigned int count = 0;
+    u_int block;
+
+    for(block = addr >> 12; block <= (addr+size-1) >> 12; ++block)
+    {
+        struct ll_entry *head;
+        u_int page=block^0x80000;
+        if(page>262143&&tlb_LUT_r[block]) page=(tlb_LUT_r[block]^0x80000000)>>12;
+        if(page>2048) page=2048+(page&2047);
+
+        for(head=jump_in[page];head!=NULL;head=head->next)
+            if((head->vaddr>>12)==block) ++count;
+    }
+
+    return count;
+}
+
 #if NEW_DYNAREC == NEW_DYNAREC_ARM
 static void invalidate_addr(u_int addr)
 {
@@ -4741,6 +4763,14 @@ static void ds_assemble_entry(int i)
   emit_jmp(0);
 }
 
+// Backward branch closing a loop which only polls memory (see idle_loop.h)
+static int polling_loop(int i)
+{
+  if(ba[i]<start||ba[i]>=start+i*4) return 0;
+  if(is_ds[(ba[i]-start)>>2]) return 0;
+  return idle_loop_detect(ba[i],start+i*4)==IDLE_LOOP_MEMORY;
+}
+
 static void do_cc(int i,signed char i_regmap[],int *adj,int addr,int taken,int invert)
 {
   int count;
@@ -4772,12 +4802,14 @@ static void do_cc(int i,signed char i_regmap[],int *adj,int addr,int taken,int i
     emit_jmp(0);
   }
   else if(*adj==0||invert) {
+    if(taken==TAKEN&&polling_loop(i)) emit_andimm(HOST_CCREG,3,HOST_CCREG); // Skip to next interrupt
     emit_addimm_and_set_flags(CLOCK_DIVIDER*(count+2),HOST_CCREG);
     jaddr=(int)out;
     emit_jns(0);
   }
   else
   {
+    if(taken==TAKEN&&polling_loop(i)) emit_andimm(HOST_CCREG,3,HOST_CCREG); // Skip to next interrupt
     emit_cmpimm(HOST_CCREG,-(int)CLOCK_DIVIDER*(count+2));
     jaddr=(int)out;
     emit_jns(0);
@@ -5492,6 +5524,7 @@ static void cjump_assemble(int i,struct regstat *i_regs)
       }
       if(invert) {
         if(taken) set_jump_target(taken,(int)out);
+        if(polling_loop(i)) emit_andimm(cc,3,cc); // Skip to next interrupt
         #ifdef CORTEX_A8_BRANCH_PREDICTION_HACK
         if(match&&(!branch_internal||!is_ds[(ba[i]-start)>>2])) {
           if(adj) {
@@ -5847,6 +5880,7 @@ static void sjump_assemble(int i,struct regstat *i_regs)
       } // if(!only32)
 
       if(invert) {
+        if(polling_loop(i)) emit_andimm(cc,3,cc); // Skip to next interrupt
         #ifdef CORTEX_A8_BRANCH_PREDICTION_HACK
         if(match&&(!branch_internal||!is_ds[(ba[i]-start)>>2])) {
           if(adj) {
@@ -7669,16 +7703,16 @@ void new_dynarec_init(void)
 {
   DebugMessage(M64MSG_INFO, "Init new dynarec");
 
-#if defined(VITA)
-  sceBlock = getVMBlock();//sceKernelAllocMemBlockForVM("code", 1 << TARGET_SIZE_2);
-  if (sceBlock < 0)
-    printf("sceKernelAllocMemBlockForVM failed\n");
-  int ret = sceKernelGetMemBlockBase(sceBlock, (void **)&base_addr);
-  if (ret < 0)
-    printf("sceKernelGetMemBlockBase failed\n");
-
-  sceKernelOpenVMDomain();
-  printf("translation_cache = 0x%08X \n ", base_addr);
+#if defined(VITA)
+  sceBlock = getVMBlock();//sceKernelAllocMemBlockForVM("code", 1 << TARGET_SIZE_2);
+  if (sceBlock < 0)
+    printf("sceKernelAllocMemBlockForVM failed\n");
+  int ret = sceKernelGetMemBlockBase(sceBlock, (void **)&base_addr);
+  if (ret < 0)
+    printf("sceKernelGetMemBlockBase failed\n");
+
+  sceKernelOpenVMDomain();
+  printf("translation_cache = 0x%08X \n ", base_addr);
 #elif NEW_DYNAREC == NEW_DYNAREC_ARM
   if ((base_addr = mmap ((u_char *)BASE_ADDR, 1<<TARGET_SIZE_2,
             PROT_READ | PROT_WRITE | PROT_EXEC,
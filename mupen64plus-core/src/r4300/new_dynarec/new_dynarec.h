@@ -42,6 +42,7 @@ extern int pending_exception;
 void invalidate_all_pages(void);
 void invalidate_block(unsigned int block);
 void invalidate_cached_code_new_dynarec(uint32_t address, size_t size);
+unsigned int count_cached_code_new_dynarec(uint32_t address, size_t size);
 void new_dynarec_init(void);
 void new_dyna_start(void);
 void new_dynarec_cleanup(void);
@@ -38,6 +38,7 @@
 #include "../cached_interp.h"
 #include "../cp0_private.h"
 #include "../cp1_private.h"
+#include "../idle_loop.h"
 #include "../interrupt.h"
 #include "../ops.h"
 #include "../r4300.h"
@@ -1318,6 +1319,27 @@ void invalidate_cached_code_new_dynarec(uint32_t addr, size_t size)
         invalidate_block(i);
 }
 
+// Counts the blocks with an entry point in the given range, found in the
+// same jump_in list invalidate_block clears
+unsigned int count_cached_code_new_dynarec(uint32_t addr, size_t size)
+{
+    unsigned int count = 0;
+    u_int block;
+
+    for(block = addr >> 12; block <= (addr+size-1) >> 12; ++block)
+    {
+        struct ll_entry *head;
+        u_int page=block^0x80000;
+        if(page>262143&&tlb_LUT_r[block]) page=(tlb_LUT_r[block]^0x80000000)>>12;
+        if(page>2048) page=2048+(page&2047);
+
+        for(head=jump_in[page];head!=NULL;head=head->next)
+            if((head->vaddr>>12)==block) ++count;
+    }
+
+    return count;
+}
+
 #if NEW_DYNAREC >= NEW_DYNAREC_ARM
 static void invalidate_addr(u_int addr)
 {
@@ -4807,6 +4829,14 @@ static void ds_assemble_entry(int i)
   emit_jmp(0);
 }
 
+// Backward branch closing a loop which only polls memory (see idle_loop.h)
+static int polling_loop(int i)
+{
+  if(ba[i]<start||ba[i]>=start+i*4) return 0;
+  if(is_ds[(ba[i]-start)>>2]) return 0;
+  return idle_loop_detect(ba[i],start+i*4)==IDLE_LOOP_MEMORY;
+}
+
 static void do_cc(int i,signed char i_regmap[],int *adj,int addr,int taken,int invert)
 {
   int count;
@@ -4838,12 +4868,14 @@ static void do_cc(int i,signed char i_regmap[],int *adj,int addr,int taken,int i
     emit_jmp(0);
   }
   else if(*adj==0||invert) {
+    if(taken==TAKEN&&polling_loop(i)) emit_andimm(HOST_CCREG,3,HOST_CCREG); // Skip to next interrupt
     emit_addimm_and_set_flags(CLOCK_DIVIDER*(count+2),HOST_CCREG);
     jaddr=(intptr_t)out;
     emit_jns(0);
   }
   else
   {
+    if(taken==TAKEN&&polling_loop(i)) emit_andimm(HOST_CCREG,3,HOST_CCREG); // Skip to next interrupt
     emit_cmpimm(HOST_CCREG,-(int)CLOCK_DIVIDER*(count+2));
     jaddr=(intptr_t)out;
     emit_jns(0);
@@ -5560,6 +5592,7 @@ static void cjump_assemble(int i,struct regstat *i_regs)
       }
       if(invert) {
         if(taken) set_jump_target(taken,(intptr_t)out);
+        if(polling_loop(i)) emit_andimm(cc,3,cc); // Skip to next interrupt
         #ifdef CORTEX_A8_BRANCH_PREDICTION_HACK
         if(match&&(!branch_internal||!is_ds[(ba[i]-start)>>2])) {
           if(adj) {
@@ -5915,6 +5948,7 @@ static void sjump_assemble(int i,struct regstat *i_regs)
       } // if(!only32)
           
       if(invert) {
+        if(polling_loop(i)) emit_andimm(cc,3,cc); // Skip to next interrupt
         #ifdef CORTEX_A8_BRANCH_PREDICTION_HACK
         if(match&&(!branch_internal||!is_ds[(ba[i]-start)>>2])) {
           if(adj) {
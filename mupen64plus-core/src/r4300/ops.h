@@ -32,7 +32,9 @@ typedef struct _cpu_instruction_table
 	 * Busy wait optimization is used when a jump jumps to itself,
 	 * and the instruction on the delay slot is a NOP.
 	 * The program is waiting for the next interrupt, so we can just
-	 * increase Count until the point where the next interrupt happens. */
+	 * increase Count until the point where the next interrupt happens.
+	 * It is also used for short backward loops which only poll memory
+	 * or Count (see idle_loop.h). */
 
 	// Load and store instructions
 	void (*LB)(void);
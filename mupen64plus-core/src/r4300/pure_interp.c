@@ -38,6 +38,7 @@
 #include "cp0_private.h"
 #include "cp1_private.h"
 #include "exception.h"
+#include "idle_loop.h"
 #include "interrupt.h"
 #include "main/main.h"
 #include "memory/memory.h"
@@ -91,9 +92,16 @@ static void InterpretOpcode(void);
    static void name##_IDLE(uint32_t op) \
    { \
       const int take_jump = (condition); \
+      const uint32_t jump_target = (destination); \
       int skip; \
       if (cop1 && check_cop1_unusable()) return; \
-      if (take_jump) \
+      if (take_jump && jump_target != PCADDR) \
+      { \
+         cp0_update_count(); \
+         idle_loop_fast_forward(jump_target, PCADDR); \
+         name(op); \
+      } \
+      else if (take_jump) \
       { \
          cp0_update_count(); \
          skip = next_interrupt - g_cp0_regs[CP0_COUNT_REG]; \
@@ -131,6 +139,12 @@ static void InterpretOpcode(void);
 	 && ((addr) & UINT32_C(0x0FFFFFFF)) != UINT32_C(0x0FFFFFFC) \
 	 && *fast_mem_access((addr) + 4) == 0)
 
+/* Determines whether a relative jump goes back to the start of a short
+ * polling loop, which is fast-forwarded like an idle loop (see idle_loop.h). */
+#define IS_RELATIVE_POLL_LOOP(op, addr) \
+	(IMM16S_OF(op) < -1 \
+	 && idle_loop_detect((addr) + (IMM16S_OF(op) + 1) * 4, (addr)) != IDLE_LOOP_NONE)
+
 #define SE8(a) ((int64_t) ((int8_t) (a)))
 #define SE16(a) ((int64_t) ((int16_t) (a)))
 #define SE32(a) ((int64_t) ((int32_t) (a)))
@@ -349,20 +363,24 @@ void InterpretOpcode(void)
 	case 1: /* REGIMM prefix */
 		switch ((op >> 16) & 0x1F) {
 		case 0: /* REGIMM opcode 0: BLTZ */
-			if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BLTZ_IDLE(op);
-			else                                     BLTZ(op);
+			if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+			      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BLTZ_IDLE(op);
+			else                                          BLTZ(op);
 			break;
 		case 1: /* REGIMM opcode 1: BGEZ */
-			if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BGEZ_IDLE(op);
-			else                                     BGEZ(op);
+			if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+			      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BGEZ_IDLE(op);
+			else                                          BGEZ(op);
 			break;
 		case 2: /* REGIMM opcode 2: BLTZL */
-			if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BLTZL_IDLE(op);
-			else                                     BLTZL(op);
+			if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+			      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BLTZL_IDLE(op);
+			else                                          BLTZL(op);
 			break;
 		case 3: /* REGIMM opcode 3: BGEZL */
-			if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BGEZL_IDLE(op);
-			else                                     BGEZL(op);
+			if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+			      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BGEZL_IDLE(op);
+			else                                          BGEZL(op);
 			break;
 		case 8: /* REGIMM opcode 8: TGEI (Not implemented) */
 		case 9: /* REGIMM opcode 9: TGEIU (Not implemented) */
@@ -403,20 +421,24 @@ void InterpretOpcode(void)
 		else                                     JAL(op);
 		break;
 	case 4: /* Major opcode 4: BEQ */
-		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BEQ_IDLE(op);
-		else                                     BEQ(op);
+		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+		      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BEQ_IDLE(op);
+		else                                          BEQ(op);
 		break;
 	case 5: /* Major opcode 5: BNE */
-		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BNE_IDLE(op);
-		else                                     BNE(op);
+		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+		      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BNE_IDLE(op);
+		else                                          BNE(op);
 		break;
 	case 6: /* Major opcode 6: BLEZ */
-		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BLEZ_IDLE(op);
-		else                                     BLEZ(op);
+		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+		      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BLEZ_IDLE(op);
+		else                                          BLEZ(op);
 		break;
 	case 7: /* Major opcode 7: BGTZ */
-		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BGTZ_IDLE(op);
-		else                                     BGTZ(op);
+		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+		      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BGTZ_IDLE(op);
+		else                                          BGTZ(op);
 		break;
 	case 8: /* Major opcode 8: ADDI */
 		if (RT_OF(op) != 0) ADDI(op);
@@ -626,20 +648,24 @@ void InterpretOpcode(void)
 		} /* switch ((op >> 21) & 0x1F) for the Coprocessor 1 prefix */
 		break;
 	case 20: /* Major opcode 20: BEQL */
-		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BEQL_IDLE(op);
-		else                                     BEQL(op);
+		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+		      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BEQL_IDLE(op);
+		else                                          BEQL(op);
 		break;
 	case 21: /* Major opcode 21: BNEL */
-		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BNEL_IDLE(op);
-		else                                     BNEL(op);
+		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+		      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BNEL_IDLE(op);
+		else                                          BNEL(op);
 		break;
 	case 22: /* Major opcode 22: BLEZL */
-		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BLEZL_IDLE(op);
-		else                                     BLEZL(op);
+		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+		      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BLEZL_IDLE(op);
+		else                                          BLEZL(op);
 		break;
 	case 23: /* Major opcode 23: BGTZL */
-		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)) BGTZL_IDLE(op);
-		else                                     BGTZL(op);
+		if (IS_RELATIVE_IDLE_LOOP(op, PC->addr)
+		      || IS_RELATIVE_POLL_LOOP(op, PC->addr)) BGTZL_IDLE(op);
+		else                                          BGTZL(op);
 		break;
 	case 24: /* Major opcode 24: DADDI */
 		if (RT_OF(op) != 0) DADDI(op);
@@ -727,8 +753,6 @@ void InterpretOpcode(void)
 	} /* switch ((op >> 26) & 0x3F) */
 }
 
-int retro_stop_stepping(void);
-
 void pure_interpreter_init(void)
 {
    stop = 0;
@@ -738,7 +762,7 @@ void pure_interpreter_init(void)
 
 void pure_interpreter(void)
 {
-   while (!stop && !retro_stop_stepping())
+   while (!stop && !stop_stepping)
    {
 #ifdef DBG
      if (g_DebuggerActive) update_debugger(PC->addr);
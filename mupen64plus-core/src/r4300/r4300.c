@@ -29,6 +29,8 @@
 #include "cached_interp.h"
 #include "cp0_private.h"
 #include "cp1_private.h"
+#include "event_profile.h"
+#include "idle_loop.h"
 #include "interrupt.h"
 #include "main/main.h"
 #include "main/device.h"
@@ -50,6 +52,8 @@
 unsigned int r4300emu = 0;
 unsigned int count_per_op = COUNT_PER_OP_DEFAULT;
 unsigned int llbit;
+/* ends r4300_step_frame at the next instruction */
+int stop_stepping;
 #if NEW_DYNAREC < NEW_DYNAREC_ARM
 int stop;
 int64_t reg[32], hi, lo;
@@ -97,6 +101,7 @@ void r4300_init(void)
     current_instruction_table = cached_interpreter_table;
 
     stop = 0;
+    idle_loop_init();
 
     if (r4300emu == CORE_PURE_INTERPRETER)
     {
@@ -149,24 +154,53 @@ void r4300_execute(void)
         dyna_start(dynarec_setup_code);
         PC++;
 #endif
-        free_blocks();
     }
 #endif
     else /* if (r4300emu == CORE_INTERPRETER) */
     {
         r4300_step();
-        free_blocks();
     }
 
-    DebugMessage(M64MSG_INFO, "R4300 emulator finished.");
+    r4300_finish();
 }
 
-int retro_stop_stepping(void);
-
 void r4300_step(void)
 {
-   while (!stop && !retro_stop_stepping())
+   while (!stop && !stop_stepping)
    {
       PC->ops();
    }
 }
+
+/* The interpreters keep all of their state in globals and can leave their
+ * loop after any instruction, so they can be run a frame at a time from
+ * the caller's stack. The dynarecs only return once stopped. */
+int r4300_can_step(void)
+{
+#if defined(DYNAREC)
+   return r4300emu < CORE_DYNAREC;
+#else
+   return 1;
+#endif
+}
+
+/* Runs until stop_stepping is set, usually at the VI */
+void r4300_step_frame(void)
+{
+   stop_stepping = 0;
+
+   if (r4300emu == CORE_PURE_INTERPRETER)
+      pure_interpreter();
+   else
+      r4300_step();
+}
+
+void r4300_finish(void)
+{
+   if (r4300emu != CORE_PURE_INTERPRETER)
+      free_blocks();
+
+   idle_loop_stats_print();
+   event_profile_stop();
+   DebugMessage(M64MSG_INFO, "R4300 emulator finished.");
+}
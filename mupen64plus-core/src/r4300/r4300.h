@@ -30,6 +30,7 @@
 
 extern struct precomp_instr *PC;
 extern int stop;
+extern int stop_stepping;
 extern unsigned int llbit;
 extern int64_t reg[32], hi, lo;
 extern long long int local_rs;
@@ -45,6 +46,9 @@ extern cpu_instruction_table current_instruction_table;
 void r4300_init(void);
 void r4300_execute(void);
 void r4300_step(void);
+int r4300_can_step(void);
+void r4300_step_frame(void);
+void r4300_finish(void);
 
 // r4300 emulators
 #define CORE_PURE_INTERPRETER 0
@@ -123,6 +123,18 @@ void invalidate_r4300_cached_code(uint32_t address, size_t size)
       invalidate_cached_code_hacktarux(address, size);
 }
 
+unsigned int count_r4300_cached_code(uint32_t address, size_t size)
+{
+   if (r4300emu == CORE_PURE_INTERPRETER)
+      return 0;
+
+#ifdef NEW_DYNAREC
+   if (r4300emu == CORE_DYNAREC)
+      return count_cached_code_new_dynarec(address, size);
+#endif
+   return count_cached_code_hacktarux(address, size);
+}
+
 /* XXX: not really a good interface but it gets the job done... */
 void savestates_load_set_pc(uint32_t pc)
 {
@@ -140,3 +152,17 @@ void savestates_load_set_pc(uint32_t pc)
         invalidate_r4300_cached_code(0,0);
     }
 }
+
+/* For loads which already invalidated the code they overwrote. */
+void savestates_load_set_pc_keep_code(uint32_t pc)
+{
+#ifdef NEW_DYNAREC
+    if (r4300emu == CORE_DYNAREC)
+    {
+        pcaddr = pc;
+        pending_exception = 1;
+    }
+    else
+#endif
+        generic_jump_to(pc);
+}
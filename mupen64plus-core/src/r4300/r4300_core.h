@@ -84,11 +84,16 @@ unsigned int get_r4300_emumode(void);
  */
 void invalidate_r4300_cached_code(uint32_t address, size_t size);
 
+/* Returns the number of blocks of cached code compiled from
+ * [address, address+size[, size must not be 0. */
+unsigned int count_r4300_cached_code(uint32_t address, size_t size);
+
 
 /* Jump to the given address. This works for all r4300 emulator, but is slower.
  * Use this for common code which can be executed from any r4300 emulator. */
 void generic_jump_to(uint32_t address);
 
 void savestates_load_set_pc(uint32_t pc);
+void savestates_load_set_pc_keep_code(uint32_t pc);
 
 #endif
@@ -41,6 +41,7 @@
 #include "api/m64p_types.h"
 #include "cached_interp.h"
 #include "cp0_private.h"
+#include "idle_loop.h"
 #include "main/main.h"
 #include "main/device.h"
 #include "main/profile.h"
@@ -556,6 +557,11 @@ static void RBLTZ(void)
       dst->ops = current_instruction_table.BLTZ_OUT;
       recomp_func = genbltz_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BLTZ_IDLE;
+      recomp_func = genbltz_idle;
+   }
 }
 
 static void RBGEZ(void)
@@ -578,6 +584,11 @@ static void RBGEZ(void)
       dst->ops = current_instruction_table.BGEZ_OUT;
       recomp_func = genbgez_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BGEZ_IDLE;
+      recomp_func = genbgez_idle;
+   }
 }
 
 static void RBLTZL(void)
@@ -600,6 +611,11 @@ static void RBLTZL(void)
       dst->ops = current_instruction_table.BLTZL_OUT;
       recomp_func = genbltzl_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BLTZL_IDLE;
+      recomp_func = genbltzl_idle;
+   }
 }
 
 static void RBGEZL(void)
@@ -622,6 +638,11 @@ static void RBGEZL(void)
       dst->ops = current_instruction_table.BGEZL_OUT;
       recomp_func = genbgezl_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BGEZL_IDLE;
+      recomp_func = genbgezl_idle;
+   }
 }
 
 static void RTGEI(void)
@@ -1683,6 +1704,11 @@ static void RBEQ(void)
       dst->ops = current_instruction_table.BEQ_OUT;
       recomp_func = genbeq_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BEQ_IDLE;
+      recomp_func = genbeq_idle;
+   }
 }
 
 static void RBNE(void)
@@ -1705,6 +1731,11 @@ static void RBNE(void)
       dst->ops = current_instruction_table.BNE_OUT;
       recomp_func = genbne_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BNE_IDLE;
+      recomp_func = genbne_idle;
+   }
 }
 
 static void RBLEZ(void)
@@ -1727,6 +1758,11 @@ static void RBLEZ(void)
       dst->ops = current_instruction_table.BLEZ_OUT;
       recomp_func = genblez_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BLEZ_IDLE;
+      recomp_func = genblez_idle;
+   }
 }
 
 static void RBGTZ(void)
@@ -1749,6 +1785,11 @@ static void RBGTZ(void)
       dst->ops = current_instruction_table.BGTZ_OUT;
       recomp_func = genbgtz_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BGTZ_IDLE;
+      recomp_func = genbgtz_idle;
+   }
 }
 
 static void RADDI(void)
@@ -1845,6 +1886,11 @@ static void RBEQL(void)
       dst->ops = current_instruction_table.BEQL_OUT;
       recomp_func = genbeql_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BEQL_IDLE;
+      recomp_func = genbeql_idle;
+   }
 }
 
 static void RBNEL(void)
@@ -1867,6 +1913,11 @@ static void RBNEL(void)
       dst->ops = current_instruction_table.BNEL_OUT;
       recomp_func = genbnel_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BNEL_IDLE;
+      recomp_func = genbnel_idle;
+   }
 }
 
 static void RBLEZL(void)
@@ -1889,6 +1940,11 @@ static void RBLEZL(void)
       dst->ops = current_instruction_table.BLEZL_OUT;
       recomp_func = genblezl_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BLEZL_IDLE;
+      recomp_func = genblezl_idle;
+   }
 }
 
 static void RBGTZL(void)
@@ -1911,6 +1967,11 @@ static void RBGTZL(void)
       dst->ops = current_instruction_table.BGTZL_OUT;
       recomp_func = genbgtzl_out;
    }
+   else if (target < dst->addr && idle_loop_detect(target, dst->addr) != IDLE_LOOP_NONE)
+   {
+      dst->ops = current_instruction_table.BGTZL_IDLE;
+      recomp_func = genbgtzl_idle;
+   }
 }
 
 static void RDADDI(void)
@@ -2184,6 +2245,7 @@ void init_block(struct precomp_block *block)
          if (!block->block)
          {
             DebugMessage(M64MSG_ERROR, "Memory error: couldn't allocate executable memory for dynamic recompiler. Try to use an interpreter mode.");
+            timed_section_end(TIMED_SECTION_COMPILER);
             return;
          }
       }
@@ -2193,6 +2255,7 @@ void init_block(struct precomp_block *block)
          block->block = (struct precomp_instr *) malloc(memsize);
          if (!block->block) {
             DebugMessage(M64MSG_ERROR, "Memory error: couldn't allocate memory for cached interpreter.");
+            timed_section_end(TIMED_SECTION_COMPILER);
             return;
          }
       }
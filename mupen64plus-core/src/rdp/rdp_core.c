@@ -21,6 +21,7 @@
 
 #include "rdp_core.h"
 
+#include "../main/profile.h"
 #include "../memory/memory.h"
 #include "../plugin/plugin.h"
 #include "../r4300/r4300_core.h"
@@ -111,7 +112,9 @@ int write_dpc_regs(void* opaque, uint32_t address, uint32_t value, uint32_t mask
          dp->dpc_regs[DPC_CURRENT_REG] = dp->dpc_regs[DPC_START_REG];
          break;
       case DPC_END_REG:
+         timed_section_start(TIMED_SECTION_RDP);
          gfx.processRDPList();
+         timed_section_end(TIMED_SECTION_RDP);
          signal_rcp_interrupt(dp->r4300, MI_INTR_DP);
          break;
    }
@@ -20,6 +20,7 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 #include "rdram.h"
+#include "rdram_gen.h"
 #include "ri_controller.h"
 
 #include "../memory/memory.h"
@@ -38,6 +39,7 @@ void poweron_rdram(struct rdram* rdram)
 {
     memset(rdram->regs, 0, RDRAM_REGS_COUNT*sizeof(uint32_t));
     memset(rdram->dram, 0, rdram->dram_size);
+    rdram_gen_touch_all();
 }
 
 
@@ -78,6 +80,7 @@ int write_rdram_dram(void* opaque, uint32_t address, uint32_t value, uint32_t ma
     uint32_t addr            = RDRAM_DRAM_ADDR(address);
 
     ri->rdram.dram[addr] = MASKED_WRITE(&ri->rdram.dram[addr], value, mask);
+    rdram_gen_touch_word(address);
 
     return 0;
 }
@@ -0,0 +1,82 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - rdram_gen.c                                             *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#include "rdram_gen.h"
+
+#include "r4300/r4300.h"
+
+#include <string.h>
+
+struct rdram_gen g_rdram_gen;
+
+#ifdef HAVE_DYNAREC_HACKTARUX
+uint8_t g_rdram_cpu_dirty[0x100000];
+
+static void fold_cpu_dirty(const uint8_t* dirty)
+{
+   unsigned int page;
+
+   for (page = 0; page < RDRAM_GEN_PAGE_COUNT; ++page)
+   {
+      if (dirty[page])
+         g_rdram_gen.pages[page] = g_rdram_gen.epoch;
+   }
+}
+#endif
+
+void rdram_gen_touch(uint32_t address, uint32_t length)
+{
+   uint32_t first, last;
+
+   if (length == 0)
+      return;
+
+   first = (address & 0xffffff) >> RDRAM_GEN_PAGE_SHIFT;
+   last  = ((address & 0xffffff) + length - 1) >> RDRAM_GEN_PAGE_SHIFT;
+   if (last >= RDRAM_GEN_PAGE_COUNT)
+      last = RDRAM_GEN_PAGE_COUNT - 1;
+
+   for (; first <= last; ++first)
+      g_rdram_gen.pages[first] = g_rdram_gen.epoch;
+}
+
+void rdram_gen_touch_all(void)
+{
+   g_rdram_gen.floor = g_rdram_gen.epoch;
+}
+
+void rdram_gen_begin_dlist(void)
+{
+   if (r4300emu == CORE_DYNAREC)
+   {
+#if defined(HAVE_DYNAREC_HACKTARUX)
+      /* stores only go through KSEG0 and KSEG1 */
+      fold_cpu_dirty(&g_rdram_cpu_dirty[0x80000]);
+      fold_cpu_dirty(&g_rdram_cpu_dirty[0xa0000]);
+      memset(&g_rdram_cpu_dirty[0x80000], 0, RDRAM_GEN_PAGE_COUNT);
+      memset(&g_rdram_cpu_dirty[0xa0000], 0, RDRAM_GEN_PAGE_COUNT);
+#else
+      rdram_gen_touch_all();
+#endif
+   }
+
+   g_rdram_gen.epoch++;
+}
@@ -0,0 +1,76 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *   Mupen64plus - rdram_gen.h                                             *
+ *   Mupen64Plus homepage: http://code.google.com/p/mupen64plus/           *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef M64P_RI_RDRAM_GEN_H
+#define M64P_RI_RDRAM_GEN_H
+
+#include <stdint.h>
+
+#include <retro_inline.h>
+
+/* RDRAM write generations.
+ *
+ * RDRAM is split in 4KB pages, each one remembering the generation in which
+ * it was last written. The generation (epoch) is advanced before every
+ * display list, so the HLE renderers can stamp what they hash with the
+ * current epoch and skip hashing it again as long as none of its pages got
+ * a newer generation. Writers which cannot say what they wrote raise the
+ * floor instead, which ages every page at once.
+ *
+ * Tracked writers are the CPU store handlers, the hacktarux dynarec inline
+ * stores (through g_rdram_cpu_dirty), PI/SI/SP DMAs, cheats and savestates.
+ * Untracked writers are the new_dynarec inline stores and non graphics,
+ * non audio RSP tasks. Audio tasks are assumed to only write audio buffers. */
+
+#define RDRAM_GEN_PAGE_SHIFT 12
+#define RDRAM_GEN_PAGE_COUNT (0x800000 >> RDRAM_GEN_PAGE_SHIFT)
+
+struct rdram_gen
+{
+   uint32_t pages[RDRAM_GEN_PAGE_COUNT];
+   uint32_t epoch;
+   uint32_t floor;
+};
+
+extern struct rdram_gen g_rdram_gen;
+
+#ifdef HAVE_DYNAREC_HACKTARUX
+/* set by the dynarec inline stores, indexed by virtual address >> 12 */
+extern uint8_t g_rdram_cpu_dirty[0x100000];
+#endif
+
+static INLINE void rdram_gen_touch_word(uint32_t address)
+{
+   uint32_t page = (address & 0xffffff) >> RDRAM_GEN_PAGE_SHIFT;
+
+   if (page < RDRAM_GEN_PAGE_COUNT)
+      g_rdram_gen.pages[page] = g_rdram_gen.epoch;
+}
+
+void rdram_gen_touch(uint32_t address, uint32_t length);
+
+/* Ages every page, for writes which cannot be tracked. */
+void rdram_gen_touch_all(void);
+
+/* Called before each display list: folds the dynarec dirty pages and
+ * advances the epoch. */
+void rdram_gen_begin_dlist(void);
+
+#endif
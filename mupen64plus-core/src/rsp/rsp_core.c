@@ -28,6 +28,7 @@
 #include "plugin/plugin.h"
 #include "r4300/r4300_core.h"
 #include "../rdp/rdp_core.h"
+#include "../ri/rdram_gen.h"
 #include "../ri/ri_controller.h"
 
 #include <stdio.h>
@@ -63,6 +64,8 @@ static void dma_sp_read(struct rsp_core* sp, unsigned length, unsigned count, un
     unsigned char *spmem  = (unsigned char*)sp->mem + (sp->regs[SP_MEM_ADDR_REG] & 0x1000);
     unsigned char *dram   = (unsigned char*)sp->ri->rdram.dram;
 
+    rdram_gen_touch(dramaddr, count * (length + skip));
+
     for(j = 0; j < count; j++)
     {
         for(i = 0; i < length; i++)
@@ -286,6 +289,7 @@ void do_SP_Task(struct rsp_core* sp)
 	}
 
         unprotect_framebuffers(sp->dp);
+        rdram_gen_begin_dlist();
 
         sp->regs2[SP_PC_REG] &= 0xfff;
         timed_section_start(TIMED_SECTION_GFX);
@@ -319,8 +323,13 @@ void do_SP_Task(struct rsp_core* sp)
     {
        /* Unknown list */
         sp->regs2[SP_PC_REG] &= 0xfff;
+        timed_section_start(TIMED_SECTION_RSP);
         rsp.doRspCycles(0xffffffff);
+        timed_section_end(TIMED_SECTION_RSP);
         sp->regs2[SP_PC_REG] |= save_pc;
+
+        /* jpeg decoding and the like write anywhere in RDRAM */
+        rdram_gen_touch_all();
     }
 
     sp->rsp_task_locked = 0;
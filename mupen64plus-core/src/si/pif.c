@@ -26,6 +26,7 @@
 
 #include "../api/m64p_types.h"
 #include "../api/callbacks.h"
+#include "../main/save_media.h"
 #include "../memory/memory.h"
 #include "../plugin/plugin.h"
 #include "r4300/r4300_core.h"
@@ -62,10 +63,6 @@ static void process_cart_command(struct pif* pif, uint8_t* cmd)
    }
 }
 
-static void game_controller_dummy_save(void *user_data)
-{
-}
-
 void init_pif(struct pif *pif,
       void *eeprom_user_data,
       void (*eeprom_save)(void*),
@@ -87,9 +84,9 @@ void init_pif(struct pif *pif,
             (void*)&channels[i],
             egcvip_is_connected,
             egcvip_get_input,
-            NULL,
-            &game_controller_dummy_save,
-            &saved_memory.mempack[i][0],
+            save_media_user_data(SAVE_MEDIA_MEMPAK + i),
+            save_media_written,
+            save_media_data(SAVE_MEDIA_MEMPAK + i),
             &channels[i],
             rvip_rumble
             );
@@ -25,8 +25,10 @@
 #include "../api/callbacks.h"
 #include "../main/main.h"
 #include "../main/rom.h"
+#include "../memory/dma.h"
 #include "../memory/memory.h"
 #include "../r4300/r4300_core.h"
+#include "../ri/rdram_gen.h"
 #include "../ri/ri_controller.h"
 
 #include <string.h>
@@ -42,16 +44,15 @@ enum
 
 static void dma_si_write(struct si_controller* si)
 {
-   int i;
-
    if (si->regs[SI_PIF_ADDR_WR64B_REG] != 0x1FC007C0)
    {
       DebugMessage(M64MSG_ERROR, "dma_si_write(): unknown SI use");
       return;
    }
 
-   for (i = 0; i < PIF_RAM_SIZE; i += 4)
-      *((uint32_t*)(&si->pif.ram[i])) = sl(si->ri->rdram.dram[(si->regs[SI_DRAM_ADDR_REG]+i)/4]);
+   dma_copy_swap32((uint32_t*)si->pif.ram,
+         &si->ri->rdram.dram[si->regs[SI_DRAM_ADDR_REG]/4], PIF_RAM_SIZE/4);
+   dma_account(DMA_SI_WRITE, PIF_RAM_SIZE);
 
    update_pif_write(si);
    cp0_update_count();
@@ -70,8 +71,6 @@ static void dma_si_write(struct si_controller* si)
 
 static void dma_si_read(struct si_controller* si)
 {
-   int i;
-
    if (si->regs[SI_PIF_ADDR_RD64B_REG] != 0x1FC007C0)
    {
       DebugMessage(M64MSG_ERROR, "dma_si_read(): unknown SI use");
@@ -80,8 +79,10 @@ static void dma_si_read(struct si_controller* si)
 
    update_pif_read(si);
 
-   for (i = 0; i < PIF_RAM_SIZE; i += 4)
-      si->ri->rdram.dram[(si->regs[SI_DRAM_ADDR_REG]+i)/4] = sl(*(uint32_t*)(&si->pif.ram[i]));
+   dma_copy_swap32(&si->ri->rdram.dram[si->regs[SI_DRAM_ADDR_REG]/4],
+         (const uint32_t*)si->pif.ram, PIF_RAM_SIZE/4);
+   rdram_gen_touch(si->regs[SI_DRAM_ADDR_REG], PIF_RAM_SIZE);
+   dma_account(DMA_SI_READ, PIF_RAM_SIZE);
    cp0_update_count();
 
    if (g_delay_si)
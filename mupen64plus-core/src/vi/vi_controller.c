@@ -22,6 +22,7 @@
 #include "vi_controller.h"
 
 #include "main/main.h"
+#include "main/profile.h"
 #include "main/rom.h"
 #include "memory/memory.h"
 #include "plugin/plugin.h"
@@ -146,7 +147,10 @@ int write_vi_regs(void* opaque, uint32_t address,
 
 void vi_vertical_interrupt_event(struct vi_controller* vi)
 {
+   /* retro_return suspends the section while the frontend runs */
+   timed_section_start(TIMED_SECTION_VI);
    gfx.updateScreen();
+   timed_section_end(TIMED_SECTION_VI);
 
    /* allow main module to do things on VI event */
    new_vi();
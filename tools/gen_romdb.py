@@ -29,6 +29,10 @@ gEeprom16k  = list()
 gFlashRAM   = list()
 gEeprom4k   = list()
 gCountPerOp = list()
+gCountPerOpGL = list()
+
+# CountPerOp overrides that are left out of GLES builds, by simple name
+gCountPerOpNotGLES = ('killer instinct gold',)
 
 for section in gConf.sections():
     conf = dict(gConf.items(section))
@@ -64,11 +68,25 @@ for _, games in gGames.items():
             gFlashRAM.append(game)
 
         if 'countperop' in game:
-            gCountPerOp.append(game)
+            if game['simplename'].lower() in gCountPerOpNotGLES:
+                gCountPerOpGL.append(game)
+            else:
+                gCountPerOp.append(game)
+
+# tables are sorted by CRC, open_rom binary searches them
+def crc_key(game):
+    return int(game['crc'], 16)
+
+gEeprom16k.sort(key=crc_key)
+gEeprom4k.sort(key=crc_key)
+gFlashRAM.sort(key=crc_key)
+gCountPerOp.sort(key=crc_key)
+gCountPerOpGL.sort(key=crc_key)
 
 print("Wrote " + OUTPUT_FILE)
 romdb = open(OUTPUT_FILE, 'w')
 romdb.write("/* This file was generated by gen_romdb.py */\n")
+romdb.write("/* Every table is sorted by CRC, open_rom binary searches them */\n")
 romdb.write("/* Games that use 16Kbit EEPROM */\n")
 romdb.write("static const uint64_t lut_ee16k[] = {\n")
 
@@ -117,25 +135,19 @@ for game in gFlashRAM:
 
 romdb.write("};\n")
 
-i = 0
+def write_cpop(name, games):
+    romdb.write("static const uint64_t " + name + "[][2] = {\n")
+    for game in games:
+        romdb.write('   { 0x' + game['crc'] + 'ULL, ' + game['countperop'] + ' }, /* ' + game['goodname'] + " */\n")
+    romdb.write("};\n")
 
 romdb.write("/* Cycles per emulated instruction (aka CountPerOp) */\n")
-romdb.write("static const uint64_t lut_cpop[][2] = {\n")
-for game in gCountPerOp:
-    comma = ','
-
-    if i == len(gEeprom16k) - 1:
-        comma = ' '
+write_cpop("lut_cpop", gCountPerOp)
 
-    if i == len(gEeprom4k) - 1:
-        comma = ' '
-
-    if i == len(gFlashRAM) - 1:
-        comma = ' '
-
-    romdb.write('   { 0x' + game['crc'] + 'ULL, ' + game['countperop'] + ' }' + comma + ' /* ' + game['goodname'] + " */\n")
-
-romdb.write("};\n")
+romdb.write("\n#ifndef GLES\n")
+romdb.write("/* CountPerOp overrides left out of GLES builds */\n")
+write_cpop("lut_cpop_gl", gCountPerOpGL)
+romdb.write("#endif\n")
     
 romdb.close()
 
@@ -0,0 +1,795 @@
+/* n64bench
+ * Headless benchmark driver for the libretro core.
+ *
+ * Loads the core and a ROM, runs a fixed number of frames without any
+ * audio or video output and prints per-frame time statistics and
+ * histograms, split by the core's timed sections (RSP tasks, RDP lists,
+ * VI updates and audio resampling, see main/profile.c). Whatever is left
+ * of a frame is reported as "cpu".
+ *
+ * Input comes from an input log (-i) or, with -s, from a pseudo-random
+ * sequence generated from the given seed. Either way a run is fully
+ * determined by the ROM, the options and the input, and the RDRAM, video
+ * and audio hashes printed at the end can be compared between runs.
+ *
+ * Input log lines are "frame port buttons [lx ly [rx ry]]": buttons is a
+ * mask of (1 << RETRO_DEVICE_ID_JOYPAD_*) and the analog values are
+ * libretro axis values. A port keeps its state until a later line for it.
+ * Lines starting with # are ignored.
+ *
+ * Only the software renderer (angrylion) works here, the other plugins
+ * need a GL context.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+#include <dlfcn.h>
+
+#include <libretro.h>
+
+#define MAX_COUNTERS 32
+#define MAX_OPTIONS  128
+#define MAX_DEPTH    16
+#define MAX_PORTS    4
+#define NUM_BUCKETS  20
+
+struct option_value {
+	char *key;
+	char *value;
+};
+
+struct input_event {
+	unsigned frame;
+	unsigned port;
+	uint16_t buttons;
+	int16_t analog[4];
+};
+
+struct input_state {
+	uint16_t buttons;
+	int16_t analog[4];
+};
+
+static struct option_value options[MAX_OPTIONS];
+static unsigned num_options;
+
+static struct retro_perf_counter *counters[MAX_COUNTERS];
+static unsigned num_counters;
+static struct retro_perf_counter *stack[MAX_DEPTH];
+static unsigned depth;
+
+static struct input_event *events;
+static size_t num_events, next_event;
+static struct input_state ports[MAX_PORTS];
+static int random_input;
+static uint32_t rng;
+
+static const char *system_dir = ".";
+static int verbose;
+
+static uint64_t video_hash = 14695981039346656037ULL;
+static uint64_t audio_hash = 14695981039346656037ULL;
+static unsigned video_frames;
+static uint64_t audio_frames;
+
+/* Output of the frame being run, only hashed once it is timed */
+struct frame_output {
+	uint8_t *data;
+	size_t size, capacity;
+};
+
+static struct frame_output video_out, audio_out;
+
+static void die(const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	fputc('\n', stderr);
+	exit(EXIT_FAILURE);
+}
+
+static uint64_t fnv1a(uint64_t hash, const void *data, size_t size)
+{
+	const uint8_t *p = data;
+	size_t i;
+
+	for (i = 0; i < size; i++) {
+		hash ^= p[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+static void frame_output_append(struct frame_output *out, const void *data, size_t size)
+{
+	if (out->size + size > out->capacity) {
+		size_t capacity = out->capacity ? out->capacity : 4096;
+
+		while (capacity < out->size + size)
+			capacity *= 2;
+		out->data = realloc(out->data, capacity);
+		if (!out->data)
+			die("out of memory");
+		out->capacity = capacity;
+	}
+
+	memcpy(out->data + out->size, data, size);
+	out->size += size;
+}
+
+static uint64_t frame_output_hash(struct frame_output *out, uint64_t hash)
+{
+	hash = fnv1a(hash, out->data, out->size);
+	out->size = 0;
+	return hash;
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Options */
+
+static void set_option(const char *key, const char *value, int keep)
+{
+	unsigned i;
+
+	for (i = 0; i < num_options; i++) {
+		if (!strcmp(options[i].key, key)) {
+			if (!keep) {
+				free(options[i].value);
+				options[i].value = strdup(value);
+			}
+			return;
+		}
+	}
+
+	if (num_options == MAX_OPTIONS)
+		die("too many options");
+
+	options[num_options].key = strdup(key);
+	options[num_options].value = strdup(value);
+	num_options++;
+}
+
+/* Core defaults are the first value of "Description; a|b|c", options
+ * given on the command line win over them. */
+static void set_defaults(const struct retro_variable *vars)
+{
+	for (; vars->key; vars++) {
+		const char *p = strstr(vars->value, "; ");
+		char value[256];
+		size_t len;
+
+		if (!p)
+			continue;
+		p += 2;
+		len = strcspn(p, "|");
+		if (len >= sizeof(value))
+			len = sizeof(value) - 1;
+		memcpy(value, p, len);
+		value[len] = '\0';
+		set_option(vars->key, value, 1);
+	}
+}
+
+static const char *get_option(const char *key)
+{
+	unsigned i;
+
+	for (i = 0; i < num_options; i++)
+		if (!strcmp(options[i].key, key))
+			return options[i].value;
+
+	return NULL;
+}
+
+/* Performance counters
+ *
+ * Counters time exclusively: starting a section pauses the one it is
+ * nested in, so the RDP list an HLE task sends is not counted twice. */
+
+static retro_time_t RETRO_CALLCONV perf_get_time_usec(void)
+{
+	return (retro_time_t)(now_ns() / 1000);
+}
+
+static retro_perf_tick_t RETRO_CALLCONV perf_get_counter(void)
+{
+	return now_ns();
+}
+
+/* Only the GL plugins ask. */
+static uint64_t RETRO_CALLCONV perf_get_cpu_features(void)
+{
+	return 0;
+}
+
+static void RETRO_CALLCONV perf_register(struct retro_perf_counter *counter)
+{
+	if (num_counters == MAX_COUNTERS)
+		return;
+
+	counters[num_counters++] = counter;
+	counter->registered = true;
+}
+
+static void RETRO_CALLCONV perf_start(struct retro_perf_counter *counter)
+{
+	uint64_t now = now_ns();
+
+	if (depth == MAX_DEPTH)
+		die("performance counters nested too deep");
+
+	if (depth)
+		stack[depth - 1]->total += now - stack[depth - 1]->start;
+
+	stack[depth++] = counter;
+	counter->start = now;
+	counter->call_cnt++;
+}
+
+static void RETRO_CALLCONV perf_stop(struct retro_perf_counter *counter)
+{
+	uint64_t now = now_ns();
+
+	if (!depth || stack[depth - 1] != counter)
+		die("performance counter %s stopped out of order", counter->ident);
+
+	counter->total += now - counter->start;
+	if (--depth)
+		stack[depth - 1]->start = now;
+}
+
+static void RETRO_CALLCONV perf_log(void)
+{
+}
+
+/* Callbacks */
+
+static void RETRO_CALLCONV log_printf(enum retro_log_level level, const char *fmt, ...)
+{
+	va_list ap;
+
+	if (level < RETRO_LOG_WARN && !verbose)
+		return;
+
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+}
+
+static bool RETRO_CALLCONV environment(unsigned cmd, void *data)
+{
+	static struct retro_perf_callback perf = {
+		perf_get_time_usec,
+		perf_get_cpu_features,
+		perf_get_counter,
+		perf_register,
+		perf_start,
+		perf_stop,
+		perf_log,
+	};
+
+	switch (cmd) {
+	case RETRO_ENVIRONMENT_SET_VARIABLES:
+		set_defaults(data);
+		return true;
+	case RETRO_ENVIRONMENT_GET_VARIABLE: {
+		struct retro_variable *var = data;
+		var->value = get_option(var->key);
+		return var->value != NULL;
+	}
+	case RETRO_ENVIRONMENT_GET_VARIABLE_UPDATE:
+		*(bool*)data = false;
+		return true;
+	case RETRO_ENVIRONMENT_GET_SYSTEM_DIRECTORY:
+	case RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY:
+		*(const char**)data = system_dir;
+		return true;
+	case RETRO_ENVIRONMENT_SET_PIXEL_FORMAT:
+		return *(const enum retro_pixel_format*)data == RETRO_PIXEL_FORMAT_XRGB8888;
+	case RETRO_ENVIRONMENT_GET_LOG_INTERFACE:
+		((struct retro_log_callback*)data)->log = log_printf;
+		return true;
+	case RETRO_ENVIRONMENT_GET_PERF_INTERFACE:
+		*(struct retro_perf_callback*)data = perf;
+		return true;
+	case RETRO_ENVIRONMENT_SET_CONTROLLER_INFO:
+	case RETRO_ENVIRONMENT_SET_SUBSYSTEM_INFO:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static void RETRO_CALLCONV video_refresh(const void *data, unsigned width, unsigned height, size_t pitch)
+{
+	const uint8_t *row = data;
+	unsigned y;
+
+	video_frames++;
+
+	/* Dupes and hardware frames have nothing to hash. */
+	if (!data || data == RETRO_HW_FRAME_BUFFER_VALID)
+		return;
+
+	for (y = 0; y < height; y++, row += pitch)
+		frame_output_append(&video_out, row, width * 4);
+}
+
+static size_t RETRO_CALLCONV audio_sample_batch(const int16_t *data, size_t frames)
+{
+	frame_output_append(&audio_out, data, frames * 4);
+	audio_frames += frames;
+	return frames;
+}
+
+static void RETRO_CALLCONV audio_sample(int16_t left, int16_t right)
+{
+	int16_t frame[2] = { left, right };
+	audio_sample_batch(frame, 1);
+}
+
+static void RETRO_CALLCONV input_poll(void)
+{
+}
+
+static int16_t RETRO_CALLCONV input_state(unsigned port, unsigned device, unsigned index, unsigned id)
+{
+	if (port >= MAX_PORTS)
+		return 0;
+
+	switch (device) {
+	case RETRO_DEVICE_JOYPAD:
+		if (id == RETRO_DEVICE_ID_JOYPAD_MASK)
+			return ports[port].buttons;
+		return (ports[port].buttons >> id) & 1;
+	case RETRO_DEVICE_ANALOG:
+		if (index > RETRO_DEVICE_INDEX_ANALOG_RIGHT || id > RETRO_DEVICE_ID_ANALOG_Y)
+			return 0;
+		return ports[port].analog[index * 2 + id];
+	default:
+		return 0;
+	}
+}
+
+/* Input */
+
+static void load_input_log(const char *path)
+{
+	FILE *fp = fopen(path, "r");
+	char line[256];
+	size_t capacity = 0;
+	unsigned lineno = 0;
+
+	if (!fp) {
+		perror(path);
+		exit(EXIT_FAILURE);
+	}
+
+	while (fgets(line, sizeof(line), fp)) {
+		struct input_event ev;
+		unsigned buttons;
+		int analog[4] = { 0, 0, 0, 0 };
+		int n, i;
+
+		lineno++;
+		if (line[strspn(line, " \t\r\n")] == '\0' || line[0] == '#')
+			continue;
+
+		n = sscanf(line, "%u %u %x %d %d %d %d", &ev.frame, &ev.port, &buttons,
+				&analog[0], &analog[1], &analog[2], &analog[3]);
+		if (n < 3 || ev.port >= MAX_PORTS)
+			die("%s:%u: expected \"frame port buttons [lx ly [rx ry]]\"", path, lineno);
+		if (num_events && ev.frame < events[num_events - 1].frame)
+			die("%s:%u: frames must not go backwards", path, lineno);
+
+		ev.buttons = buttons;
+		for (i = 0; i < 4; i++)
+			ev.analog[i] = analog[i];
+
+		if (num_events == capacity) {
+			capacity = capacity ? capacity * 2 : 256;
+			events = realloc(events, capacity * sizeof(*events));
+			if (!events)
+				die("out of memory");
+		}
+		events[num_events++] = ev;
+	}
+
+	fclose(fp);
+}
+
+static uint32_t next_random(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 17;
+	rng ^= rng << 5;
+	return rng;
+}
+
+static void update_input(unsigned frame)
+{
+	/* Select swaps the button mapping and start pauses most games, keep
+	 * random input to the face buttons, triggers and sticks. */
+	static const uint16_t random_buttons =
+		(1 << RETRO_DEVICE_ID_JOYPAD_B) | (1 << RETRO_DEVICE_ID_JOYPAD_Y) |
+		(1 << RETRO_DEVICE_ID_JOYPAD_A) | (1 << RETRO_DEVICE_ID_JOYPAD_X) |
+		(1 << RETRO_DEVICE_ID_JOYPAD_L) | (1 << RETRO_DEVICE_ID_JOYPAD_R) |
+		(1 << RETRO_DEVICE_ID_JOYPAD_L2) | (1 << RETRO_DEVICE_ID_JOYPAD_R2);
+
+	for (; next_event < num_events && events[next_event].frame <= frame; next_event++) {
+		const struct input_event *ev = &events[next_event];
+		ports[ev->port].buttons = ev->buttons;
+		memcpy(ports[ev->port].analog, ev->analog, sizeof(ev->analog));
+	}
+
+	/* Random input is held for 8 frames so games see the presses. */
+	if (random_input && (frame & 7) == 0) {
+		ports[0].buttons = next_random() & random_buttons;
+		ports[0].analog[0] = (int16_t)next_random();
+		ports[0].analog[1] = (int16_t)next_random();
+	}
+}
+
+/* Statistics */
+
+static int compare_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
+static unsigned bucket_of(uint64_t ns)
+{
+	uint64_t us = ns / 1000;
+	unsigned b = 0;
+
+	while (us > 1 && b < NUM_BUCKETS - 1) {
+		us >>= 1;
+		b++;
+	}
+
+	return b;
+}
+
+static void print_stats(const char **names, const uint64_t *samples,
+		unsigned columns, unsigned frames)
+{
+	unsigned hist[MAX_COUNTERS + 2][NUM_BUCKETS];
+	uint64_t *sorted = malloc(frames * sizeof(*sorted));
+	unsigned c, f, b, first = NUM_BUCKETS, last = 0;
+
+	if (!sorted)
+		die("out of memory");
+
+	memset(hist, 0, sizeof(hist));
+
+	printf("\n%-16s %9s %9s %9s %9s %9s %9s %7s\n",
+			"section (us)", "min", "p50", "p90", "p99", "max", "mean", "share");
+
+	for (c = 0; c < columns; c++) {
+		uint64_t sum = 0, all = 0;
+
+		for (f = 0; f < frames; f++) {
+			sorted[f] = samples[f * columns + c];
+			sum += sorted[f];
+			all += samples[f * columns];
+			b = bucket_of(sorted[f]);
+			hist[c][b]++;
+			if (b < first)
+				first = b;
+			if (b > last)
+				last = b;
+		}
+
+		qsort(sorted, frames, sizeof(*sorted), compare_u64);
+
+		printf("%-16s %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %6.1f%%\n", names[c],
+				sorted[0] / 1000.0,
+				sorted[frames / 2] / 1000.0,
+				sorted[(uint64_t)frames * 90 / 100] / 1000.0,
+				sorted[(uint64_t)frames * 99 / 100] / 1000.0,
+				sorted[frames - 1] / 1000.0,
+				(double)sum / frames / 1000.0,
+				all ? 100.0 * sum / all : 0.0);
+	}
+
+	printf("\nframes per bucket\n%-16s", "us");
+	for (c = 0; c < columns; c++)
+		printf(" %*s", strlen(names[c]) > 7 ? (int)strlen(names[c]) : 7, names[c]);
+	printf("\n");
+
+	for (b = first; b <= last; b++) {
+		char range[32];
+
+		if (b == 0)
+			snprintf(range, sizeof(range), "< 2");
+		else if (b == NUM_BUCKETS - 1)
+			snprintf(range, sizeof(range), ">= %u", 1u << b);
+		else
+			snprintf(range, sizeof(range), "%u - %u", 1u << b, 2u << b);
+
+		printf("%-16s", range);
+		for (c = 0; c < columns; c++)
+			printf(" %*u", strlen(names[c]) > 7 ? (int)strlen(names[c]) : 7, hist[c][b]);
+		printf("\n");
+	}
+
+	free(sorted);
+}
+
+static void usage(const char *argv0)
+{
+	fprintf(stderr,
+		"usage: %s [options] <core> <rom>\n"
+		"  -n frames     frames to measure (default 600)\n"
+		"  -w frames     frames to run before measuring (default 0)\n"
+		"  -c cpucore    parallel-n64-cpucore (default: core default)\n"
+		"  -r rspplugin  parallel-n64-rspplugin (default cxd4)\n"
+		"  -i file       replay an input log\n"
+		"  -s seed       pseudo-random input from seed\n"
+		"  -o key=value  set a core option, may be repeated\n"
+		"  -t file       write per-frame times as CSV\n"
+		"  -d dir        system and save directory (default .)\n"
+		"  -v            show core log messages\n",
+		argv0);
+	exit(EXIT_FAILURE);
+}
+
+#define CORE_SYM(name) \
+	do { \
+		*(void**)&name = dlsym(core, #name); \
+		if (!name) \
+			die("%s: missing %s", core_path, #name); \
+	} while (0)
+
+int main(int argc, char *argv[])
+{
+	void (*retro_set_environment)(retro_environment_t);
+	void (*retro_set_video_refresh)(retro_video_refresh_t);
+	void (*retro_set_audio_sample)(retro_audio_sample_t);
+	void (*retro_set_audio_sample_batch)(retro_audio_sample_batch_t);
+	void (*retro_set_input_poll)(retro_input_poll_t);
+	void (*retro_set_input_state)(retro_input_state_t);
+	void (*retro_init)(void);
+	void (*retro_deinit)(void);
+	bool (*retro_load_game)(const struct retro_game_info*);
+	void (*retro_unload_game)(void);
+	void (*retro_run)(void);
+	void *(*retro_get_memory_data)(unsigned);
+	size_t (*retro_get_memory_size)(unsigned);
+
+	unsigned frames = 600, warmup = 0, total, frame, c, columns;
+	const char *input_path = NULL, *csv_path = NULL, *core_path, *rom_path;
+	const char *names[MAX_COUNTERS + 2];
+	struct retro_game_info game = { 0 };
+	uint64_t *samples, last[MAX_COUNTERS];
+	uint64_t rdram_hash = 14695981039346656037ULL;
+	void *core, *rom;
+	long rom_size;
+	FILE *fp;
+	int opt;
+
+	set_option("parallel-n64-gfxplugin", "angrylion", 0);
+	set_option("parallel-n64-rspplugin", "cxd4", 0);
+
+	while ((opt = getopt(argc, argv, "n:w:c:r:i:s:o:t:d:v")) != -1) {
+		switch (opt) {
+		case 'n':
+			frames = strtoul(optarg, NULL, 0);
+			break;
+		case 'w':
+			warmup = strtoul(optarg, NULL, 0);
+			break;
+		case 'c':
+			set_option("parallel-n64-cpucore", optarg, 0);
+			break;
+		case 'r':
+			set_option("parallel-n64-rspplugin", optarg, 0);
+			break;
+		case 'i':
+			input_path = optarg;
+			break;
+		case 's':
+			random_input = 1;
+			rng = strtoul(optarg, NULL, 0) | 1;
+			break;
+		case 'o': {
+			char key[256];
+			const char *eq = strchr(optarg, '=');
+
+			if (!eq || (size_t)(eq - optarg) >= sizeof(key))
+				usage(argv[0]);
+			memcpy(key, optarg, eq - optarg);
+			key[eq - optarg] = '\0';
+			set_option(key, eq + 1, 0);
+			break;
+		}
+		case 't':
+			csv_path = optarg;
+			break;
+		case 'd':
+			system_dir = optarg;
+			break;
+		case 'v':
+			verbose = 1;
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if (argc - optind != 2 || frames == 0)
+		usage(argv[0]);
+
+	core_path = argv[optind];
+	rom_path = argv[optind + 1];
+
+	if (input_path)
+		load_input_log(input_path);
+
+	core = dlopen(core_path, RTLD_NOW | RTLD_LOCAL);
+	if (!core)
+		die("%s", dlerror());
+
+	CORE_SYM(retro_set_environment);
+	CORE_SYM(retro_set_video_refresh);
+	CORE_SYM(retro_set_audio_sample);
+	CORE_SYM(retro_set_audio_sample_batch);
+	CORE_SYM(retro_set_input_poll);
+	CORE_SYM(retro_set_input_state);
+	CORE_SYM(retro_init);
+	CORE_SYM(retro_deinit);
+	CORE_SYM(retro_load_game);
+	CORE_SYM(retro_unload_game);
+	CORE_SYM(retro_run);
+	CORE_SYM(retro_get_memory_data);
+	CORE_SYM(retro_get_memory_size);
+
+	fp = fopen(rom_path, "rb");
+	if (!fp) {
+		perror(rom_path);
+		exit(EXIT_FAILURE);
+	}
+	fseek(fp, 0, SEEK_END);
+	rom_size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	rom = malloc(rom_size);
+	if (!rom || fread(rom, 1, rom_size, fp) != (size_t)rom_size)
+		die("%s: read failed", rom_path);
+	fclose(fp);
+
+	game.path = rom_path;
+	game.data = rom;
+	game.size = rom_size;
+
+	retro_set_environment(environment);
+	retro_set_video_refresh(video_refresh);
+	retro_set_audio_sample(audio_sample);
+	retro_set_audio_sample_batch(audio_sample_batch);
+	retro_set_input_poll(input_poll);
+	retro_set_input_state(input_state);
+	retro_init();
+
+	if (!retro_load_game(&game))
+		die("%s: failed to load", rom_path);
+
+	total = warmup + frames;
+	samples = calloc((size_t)frames * (MAX_COUNTERS + 2), sizeof(*samples));
+	if (!samples)
+		die("out of memory");
+
+	for (frame = 0; frame < total; frame++) {
+		uint64_t start, end, *row;
+		unsigned n, known = num_counters;
+
+		update_input(frame);
+
+		for (n = 0; n < known; n++)
+			last[n] = counters[n]->total;
+
+		/* A counter still open from the last frame resumes now, the time
+		 * spent out here is nobody's. */
+		start = now_ns();
+		if (depth)
+			stack[depth - 1]->start = start;
+
+		retro_run();
+
+		end = now_ns();
+		if (depth) {
+			stack[depth - 1]->total += end - stack[depth - 1]->start;
+			stack[depth - 1]->start = end;
+		}
+
+		/* The callbacks only copied the output, hashing it is not part of
+		 * the frame */
+		video_hash = frame_output_hash(&video_out, video_hash);
+		audio_hash = frame_output_hash(&audio_out, audio_hash);
+
+		if (frame < warmup)
+			continue;
+
+		row = &samples[(size_t)(frame - warmup) * (MAX_COUNTERS + 2)];
+		row[0] = end - start;
+		row[1] = row[0];
+		for (n = 0; n < num_counters; n++) {
+			/* Counters registered during this frame started from zero. */
+			uint64_t spent = counters[n]->total - (n < known ? last[n] : 0);
+			row[2 + n] = spent;
+			row[1] = row[1] > spent ? row[1] - spent : 0;
+		}
+	}
+
+	{
+		const uint32_t *ram = retro_get_memory_data(RETRO_MEMORY_SYSTEM_RAM);
+		size_t size = retro_get_memory_size(RETRO_MEMORY_SYSTEM_RAM);
+
+		if (ram)
+			rdram_hash = fnv1a(rdram_hash, ram, size);
+	}
+
+	/* Columns are packed, MAX_COUNTERS + 2 wide per frame. */
+	columns = 2 + num_counters;
+	names[0] = "total";
+	names[1] = "cpu";
+	for (c = 0; c < num_counters; c++)
+		names[2 + c] = counters[c]->ident;
+
+	if (csv_path) {
+		fp = fopen(csv_path, "w");
+		if (!fp) {
+			perror(csv_path);
+			exit(EXIT_FAILURE);
+		}
+		fprintf(fp, "frame");
+		for (c = 0; c < columns; c++)
+			fprintf(fp, ",%s", names[c]);
+		fprintf(fp, "\n");
+		for (frame = 0; frame < frames; frame++) {
+			fprintf(fp, "%u", warmup + frame);
+			for (c = 0; c < columns; c++)
+				fprintf(fp, ",%.1f", samples[(size_t)frame * (MAX_COUNTERS + 2) + c] / 1000.0);
+			fprintf(fp, "\n");
+		}
+		fclose(fp);
+	}
+
+	for (frame = 1; frame < frames; frame++)
+		memmove(&samples[(size_t)frame * columns],
+				&samples[(size_t)frame * (MAX_COUNTERS + 2)],
+				columns * sizeof(*samples));
+
+	printf("%s: %u frames after %u warmup, %u video frames, %llu audio frames\n",
+			rom_path, frames, warmup, video_frames, (unsigned long long)audio_frames);
+	print_stats(names, samples, columns, frames);
+
+	printf("\nrdram hash %016llx\nvideo hash %016llx\naudio hash %016llx\n",
+			(unsigned long long)rdram_hash,
+			(unsigned long long)video_hash,
+			(unsigned long long)audio_hash);
+
+	retro_unload_game();
+	retro_deinit();
+	dlclose(core);
+
+	free(samples);
+	free(rom);
+	free(events);
+	free(video_out.data);
+	free(audio_out.data);
+	return 0;
+}